@@ -0,0 +1,152 @@
+#include "agent_batch.hpp"
+#include "simd_lanes.hpp"
+
+// ============================================================================
+// AGENT BATCH IMPLEMENTATION
+// ============================================================================
+
+void AgentBatch::resize(size_t n) {
+    for (auto* v : {&energy, &thirst, &digestion, &move_timer, &timer, &pos_x, &pos_y, &target_x, &target_y}) {
+        v->resize(n);
+    }
+    for (auto* v : {&active, &on_water, &flag, &done}) {
+        v->resize(n);
+    }
+}
+
+namespace {
+
+template <typename L>
+size_t decay_needs_lanes(AgentBatch& b, size_t i, float energy_step, float thirst_step, float drink_step,
+                         bool digests, float delta_time) {
+    const size_t n = b.size();
+    const auto zero = L::splat(0.0f);
+    const auto one = L::splat(1.0f);
+    const auto dt = L::splat(delta_time);
+    const auto e_step = L::splat(energy_step);
+    const auto t_step = L::splat(thirst_step);
+    const auto d_step = L::splat(drink_step);
+    const bool thirsts = thirst_step > 0.0f;
+
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        auto active = L::load_mask(&b.active[i]);
+
+        auto energy = L::load(&b.energy[i]);
+        L::store(&b.energy[i], L::select(active, L::max(L::sub(energy, e_step), zero), energy));
+
+        if (thirsts) {
+            auto thirst = L::load(&b.thirst[i]);
+            auto decayed = L::max(L::sub(thirst, t_step), zero);
+            auto drinks = L::both(active, L::load_mask(&b.on_water[i]));
+            decayed = L::select(drinks, L::min(L::add(decayed, d_step), one), decayed);
+            L::store(&b.thirst[i], L::select(active, decayed, thirst));
+        }
+
+        if (digests) {
+            auto digestion = L::load(&b.digestion[i]);
+            L::store(&b.digestion[i], L::select(active, L::sub(digestion, dt), digestion));
+        }
+
+        auto move_timer = L::load(&b.move_timer[i]);
+        L::store(&b.move_timer[i], L::select(active, L::add(move_timer, dt), move_timer));
+    }
+    return i;
+}
+
+template <typename L>
+size_t interpolate_lanes(AgentBatch& b, size_t i, float anim_speed, float delta_time) {
+    const size_t n = b.size();
+    const auto speed = L::splat(anim_speed);
+    const auto dt = L::splat(delta_time);
+    const auto reach = L::splat(anim_speed * delta_time);
+    const auto min_dist = L::splat(0.1f);
+
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        auto x = L::load(&b.pos_x[i]), y = L::load(&b.pos_y[i]);
+        auto tx = L::load(&b.target_x[i]), ty = L::load(&b.target_y[i]);
+        auto dx = L::sub(tx, x), dy = L::sub(ty, y);
+        auto dist = L::sqrt(L::add(L::mul(dx, dx), L::mul(dy, dy)));
+        auto moving = L::gt(dist, min_dist);
+
+        // Step toward the target, then snap if within one step of it
+        auto nx = L::add(x, L::mul(L::mul(L::div(dx, dist), speed), dt));
+        auto ny = L::add(y, L::mul(L::mul(L::div(dy, dist), speed), dt));
+        auto rx = L::sub(tx, nx), ry = L::sub(ty, ny);
+        auto snap = L::lt(L::sqrt(L::add(L::mul(rx, rx), L::mul(ry, ry))), reach);
+        nx = L::select(snap, tx, nx);
+        ny = L::select(snap, ty, ny);
+
+        L::store(&b.pos_x[i], L::select(moving, nx, x));
+        L::store(&b.pos_y[i], L::select(moving, ny, y));
+    }
+    return i;
+}
+
+template <typename L>
+size_t graze_lanes(AgentBatch& b, size_t i, float graze_step, float energy_cap, float delta_time) {
+    const size_t n = b.size();
+    const auto dt = L::splat(delta_time);
+    const auto step = L::splat(graze_step);
+    const auto cap = L::splat(energy_cap);
+
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        auto grazing = L::load_mask(&b.flag[i]);
+        auto timer = L::load(&b.timer[i]);
+        L::store(&b.timer[i], L::select(grazing, L::sub(timer, dt), timer));
+        auto energy = L::load(&b.energy[i]);
+        L::store(&b.energy[i], L::select(grazing, L::min(L::add(energy, step), cap), energy));
+    }
+    return i;
+}
+
+template <typename L>
+size_t pregnancy_lanes(AgentBatch& b, size_t i, float delta_time) {
+    const size_t n = b.size();
+    const auto zero = L::splat(0.0f);
+    const auto dt = L::splat(delta_time);
+
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        auto pregnant = L::load_mask(&b.flag[i]);
+        auto timer = L::select(pregnant, L::sub(L::load(&b.timer[i]), dt), L::load(&b.timer[i]));
+        L::store(&b.timer[i], timer);
+        L::store_mask(&b.done[i], L::both(pregnant, L::le(timer, zero)));
+    }
+    return i;
+}
+
+} // namespace
+
+void batch_decay_needs(AgentBatch& batch, float energy_decay, float thirst_decay, float drink_rate,
+                       bool digests, float delta_time) {
+    float energy_step = delta_time * energy_decay;
+    float thirst_step = delta_time * thirst_decay;
+    float drink_step = delta_time * drink_rate;
+    size_t i = decay_needs_lanes<WideLanes>(batch, 0, energy_step, thirst_step, drink_step, digests, delta_time);
+    decay_needs_lanes<ScalarLanes>(batch, i, energy_step, thirst_step, drink_step, digests, delta_time);
+}
+
+void batch_interpolate(AgentBatch& batch, float anim_speed, float delta_time) {
+    size_t i = interpolate_lanes<WideLanes>(batch, 0, anim_speed, delta_time);
+    interpolate_lanes<ScalarLanes>(batch, i, anim_speed, delta_time);
+}
+
+void batch_graze(AgentBatch& batch, float graze_rate, float energy_cap, float delta_time) {
+    float graze_step = delta_time * graze_rate;
+    size_t i = graze_lanes<WideLanes>(batch, 0, graze_step, energy_cap, delta_time);
+    graze_lanes<ScalarLanes>(batch, i, graze_step, energy_cap, delta_time);
+}
+
+void batch_pregnancy(AgentBatch& batch, float delta_time) {
+    size_t i = pregnancy_lanes<WideLanes>(batch, 0, delta_time);
+    pregnancy_lanes<ScalarLanes>(batch, i, delta_time);
+}
+
+const char* batch_instruction_set() {
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(HEXAWORLD_SSE2)
+    return "SSE2";
+#else
+    return "scalar";
+#endif
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "simd_lanes.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// AGENT BATCH - Vectorized per-tick updates of the animals' scalar state
+// ============================================================================
+
+// One species' per-tick scalar state laid out as contiguous arrays. The
+// simulation gathers into it, runs the kernels and scatters back; the
+// buffers are reused between species and ticks.
+struct AgentBatch {
+    std::vector<float> energy;
+    std::vector<float> thirst;
+    std::vector<float> digestion;
+    std::vector<float> move_timer;
+    std::vector<float> timer;        // Pregnancy or grazing countdown
+    std::vector<float> pos_x, pos_y;
+    std::vector<float> target_x, target_y;
+    std::vector<LaneMask> active;    // Takes part in need decay, digestion and move timing
+    std::vector<LaneMask> on_water;  // Drinks this tick
+    std::vector<LaneMask> flag;      // Kernel input: pregnant or grazing
+    std::vector<LaneMask> done;      // Kernel output: gave birth
+
+    void resize(size_t n);
+    size_t size() const { return energy.size(); }
+};
+
+// Energy and thirst decay (clamped at zero), drinking on water, digestion
+// countdown and move timer, applied to active lanes only
+void batch_decay_needs(AgentBatch& batch, float energy_decay, float thirst_decay, float drink_rate,
+                       bool digests, float delta_time);
+
+// Ease positions toward their targets at a fixed speed, snapping when close
+void batch_interpolate(AgentBatch& batch, float anim_speed, float delta_time);
+
+// Flagged lanes gain energy up to the cap while their timer runs down
+void batch_graze(AgentBatch& batch, float graze_rate, float energy_cap, float delta_time);
+
+// Flagged lanes count down their pregnancy; done marks lanes giving birth
+void batch_pregnancy(AgentBatch& batch, float delta_time);
+
+// Instruction set the kernels were compiled for
+const char* batch_instruction_set();
@@ -0,0 +1,26 @@
+#include "alloc_counter.hpp"
+
+// ============================================================================
+// ALLOCATION COUNTER IMPLEMENTATION
+// ============================================================================
+
+namespace {
+bool counting = false;  // Set before main by the hook, if linked in
+thread_local uint64_t thread_allocations = 0;
+}
+
+bool allocation_counting() {
+    return counting;
+}
+
+uint64_t thread_allocation_count() {
+    return thread_allocations;
+}
+
+void enable_allocation_counting() {
+    counting = true;
+}
+
+void count_allocation() {
+    thread_allocations++;
+}
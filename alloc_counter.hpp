@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// ============================================================================
+// ALLOCATION COUNTER - Heap allocations per thread, for catching regressions
+// ============================================================================
+
+// The viewer built with HEXAWORLD_COUNT_ALLOCS links in alloc_hook.cpp, a
+// global operator new that counts every allocation made by the calling
+// thread. The hook is never part of the simulation core, so libhexaworld
+// and the tools keep the host's allocator; there the count stays at zero.
+bool allocation_counting();
+uint64_t thread_allocation_count();
+
+// Called by the hook
+void enable_allocation_counting();
+void count_allocation();
@@ -0,0 +1,31 @@
+#include "alloc_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+// ============================================================================
+// ALLOCATION HOOK - Global operator new, linked into the viewer only
+// ============================================================================
+
+namespace {
+const bool hooked = (enable_allocation_counting(), true);
+}
+
+// The array and nothrow forms forward here, so this sees every plain new
+void* operator new(std::size_t size) {
+    count_allocation();
+    if (size == 0) size = 1;
+    while (true) {
+        if (void* p = std::malloc(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
@@ -7,37 +7,38 @@
 #include <vector>
 #include <random>
 
+// Wide fields first, then the genome's 16-bit traits, then byte-sized state,
+// so the record packs without padding holes. Drawn positions are eased on
+// the render side (see sprite_easing.hpp).
 struct Hare : public HexObject {
-    std::vector<TerrainType> allowed_terrains = {SOIL, ROCK}; // Allow rocks, water only when thirsty
+    static constexpr sf::Color base_color{210, 180, 140}; // Khaki
+
     float energy = 1.0f;
     float thirst = 1.0f; // Hydration level (1.0 = fully hydrated, 0.0 = dehydrated)
-    sf::Color base_color = sf::Color(210, 180, 140); // Khaki
-    bool is_dead = false;
     float digestion_time = 0.0f;
     float move_timer = 0.0f;
-    int consecutive_water_moves = 0;
-    HareGenome genome;
     float pregnancy_timer = 0.0f;
-    bool is_pregnant = false;
-    bool ready_to_give_birth = false;
-    float speed = 1.0f;
-    sf::Vector2f current_pos;
-    sf::Vector2f target_pos;
-    bool is_burrowing = false;
     float eating_timer = 0.0f;
-    bool is_eating = false;
+    HareGenome genome;
+    DeathCause death_cause = CAUSE_NONE;
+    bool is_dead : 1;
+    bool is_pregnant : 1;
+    bool ready_to_give_birth : 1;
+    bool is_burrowing : 1;
+    bool is_eating : 1;
 
-    Hare(int q, int r) : HexObject(q, r), genome() { update_speed(); }
+    Hare(int q, int r)
+        : HexObject(q, r), genome(), is_dead(false), is_pregnant(false), ready_to_give_birth(false),
+          is_burrowing(false), is_eating(false) {}
 
-    void update_speed() { speed = 2.0f - genome.weight; }
-    void update_positions(HexGrid& grid);
+    float speed() const { return 2.0f - genome.weight; }
 
     // Get color based on genome
     sf::Color getColor() const;
 
-    // Update behavior: move and eat if possible
-    void update(HexGrid& grid, const std::vector<Fox>& foxes, float delta_time, std::mt19937& rng);
+    // Update behavior: move and eat if possible (needs and timers are advanced in batch first)
+    void update(HexGrid& grid, const std::vector<Fox>& foxes, std::mt19937& rng);
 
     // Eat plant at current position
     bool eat(HexGrid& grid);
-};
\ No newline at end of file
+};
@@ -1,66 +1,47 @@
 #include "salmon.hpp"
+#include "species.hpp"
+#include "../constants.hpp"
 #include <algorithm>
+#include <cmath>
 
 // ============================================================================
 // SALMON IMPLEMENTATION
 // ============================================================================
 
-void Salmon::update_positions(HexGrid& grid) {
-    auto [x, y] = grid.axial_to_pixel(q, r);
-    target_pos = sf::Vector2f(x, y);
-    if (current_pos == sf::Vector2f(0, 0)) current_pos = target_pos;
-}
+namespace {
 
-void Salmon::update(HexGrid& grid, float delta_time, std::mt19937& rng) {
-    if (is_dead) return;
+const float DECAY_PER_TICK = SpeciesTraits<Salmon>::energy_decay * SIM_DT;
 
+const uint64_t MOVE_TICKS = static_cast<uint64_t>(std::max(1L, std::lround(SpeciesTraits<Salmon>::move_interval / SIM_DT)));
 
+} // namespace
 
-    // Small energy decay
-    energy -= delta_time * 0.005f;
-    energy = std::max(0.0f, energy);
+uint64_t Salmon::move_ticks() {
+    return MOVE_TICKS;
+}
 
-    // Move if timer allows
-    move_timer += delta_time;
-    if (move_timer >= 1.0f && energy > 0.0f) {
-        // Find valid directions (water only)
-        std::vector<int> valid_dirs;
-        for (int dir = 0; dir < 6; ++dir) {
-            auto [nq, nr] = grid.get_neighbor_coords(q, r, dir);
-            if (grid.has_hexagon(nq, nr) && grid.get_terrain_type(nq, nr) == WATER) {
-                valid_dirs.push_back(dir);
-            }
-        }
+float Salmon::energy_at(uint64_t tick) const {
+    return energy - DECAY_PER_TICK * static_cast<float>(tick - energy_tick);
+}
 
-        if (!valid_dirs.empty()) {
-            // Avoid fire (always)
-            std::vector<int> no_fire_dirs;
-            for (int dir : valid_dirs) {
-                auto [nq, nr] = grid.get_neighbor_coords(q, r, dir);
-                if (grid.fire_timers.find({nq, nr}) == grid.fire_timers.end()) {
-                    no_fire_dirs.push_back(dir);
-                }
-            }
-            if (!no_fire_dirs.empty()) {
-                valid_dirs = no_fire_dirs;
-            }
+uint64_t Salmon::wake(HexGrid& grid, uint64_t tick, std::mt19937& rng) {
+    energy = energy_at(tick);
+    energy_tick = tick;
 
-            std::uniform_int_distribution<> dis(0, valid_dirs.size() - 1);
-            int dir = valid_dirs[dis(rng)];
-            auto [nq, nr] = grid.get_neighbor_coords(q, r, dir);
-            q = nq;
-            r = nr;
-            move_timer = 0.0f;
+    // Swim to a random neighbouring water hex
+    if (energy > SpeciesTraits<Salmon>::min_move_energy) {
+        DirectionSet valid_dirs = passable_directions(*this, grid);
+        if (!valid_dirs.empty()) {
+            avoid_fire(grid, q, r, valid_dirs);
+            std::uniform_int_distribution<> dis(0, valid_dirs.count - 1);
+            move(valid_dirs[dis(rng)]);
         }
     }
 
-    // Reproduction
-    if (energy > reproduction_threshold) {
-        ready_to_give_birth = true;
-    }
+    try_conceive(*this);
+    check_death(*this, grid);
 
-    // Die if no energy
-    if (energy <= 0.0f) {
-        is_dead = true;
-    }
-}
\ No newline at end of file
+    // Next swim, or the tick the energy runs out if that comes first
+    uint64_t starve = tick + static_cast<uint64_t>(std::max(1.0f, std::ceil(energy / DECAY_PER_TICK)));
+    return std::min(tick + MOVE_TICKS, starve);
+}
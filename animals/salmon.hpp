@@ -2,32 +2,33 @@
 
 #include "hex_grid_new.hpp"
 #include <SFML/Graphics.hpp>
+#include <cstdint>
 #include <vector>
 #include <random>
 
 struct Salmon : public HexObject {
-    std::vector<TerrainType> allowed_terrains = {WATER}; // Only water
-    float energy = 1.0f;
-    sf::Color base_color = sf::Color(255, 100, 100); // Light red
-    bool is_dead = false;
-    float digestion_time = 0.0f;
-    float move_timer = 0.0f;
-    // Simple genome for now
-    float reproduction_threshold = 2.0f;
-    float pregnancy_timer = 0.0f;
-    bool is_pregnant = false;
-    bool ready_to_give_birth = false;
-    float speed = 1.0f;
-    sf::Vector2f current_pos;
-    sf::Vector2f target_pos;
-
-    Salmon(int q, int r) : HexObject(q, r) {}
-
-    void update_positions(HexGrid& grid);
+    static constexpr sf::Color base_color{255, 100, 100}; // Light red
+    static constexpr float reproduction_threshold = 2.0f; // Simple genome for now
+
+    float energy = 1.0f;       // As of energy_tick; decays steadily until the next wake-up
+    uint64_t energy_tick = 0;
+    uint64_t wake_tick = 0;    // Next scheduled update
+    DeathCause death_cause = CAUSE_NONE;
+    bool is_dead : 1;
+    bool ready_to_give_birth : 1;
+
+    Salmon(int q, int r) : HexObject(q, r), is_dead(false), ready_to_give_birth(false) {}
 
     // Get color (fixed for salmons)
     sf::Color getColor() const { return base_color; }
 
-    // Update behavior: swim and reproduce
-    void update(HexGrid& grid, float delta_time, std::mt19937& rng);
-};
\ No newline at end of file
+    // Ticks between swims
+    static uint64_t move_ticks();
+
+    // Energy at a later tick, from the steady decay since energy_tick
+    float energy_at(uint64_t tick) const;
+
+    // Salmon are not polled every tick: they wake up to swim and reproduce,
+    // or when their energy runs out. Returns the tick of the next wake-up.
+    uint64_t wake(HexGrid& grid, uint64_t tick, std::mt19937& rng);
+};
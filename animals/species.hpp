@@ -0,0 +1,401 @@
+#pragma once
+
+#include "hare.hpp"
+#include "fox.hpp"
+#include "wolf.hpp"
+#include "salmon.hpp"
+#include "../event_log.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// ============================================================================
+// SPECIES TRAITS - Compile-time parameters for every species
+// ============================================================================
+
+// Terrain passability as a bitmask over TerrainType
+constexpr uint8_t terrain_bit(TerrainType type) { return static_cast<uint8_t>(1u << type); }
+constexpr uint8_t TERRAIN_LAND = terrain_bit(SOIL) | terrain_bit(ROCK);
+constexpr uint8_t TERRAIN_WATER = terrain_bit(WATER);
+
+constexpr float THIRSTY = 0.3f;  // Below this, animals that can swim will enter water
+constexpr float PARCHED = 0.2f;  // Below this, water beats every other preference
+
+template <typename Animal>
+struct SpeciesTraits;
+
+template <>
+struct SpeciesTraits<Hare> {
+    static constexpr EventSpecies species = SPECIES_HARE;
+    static constexpr float anim_speed = 50.0f;         // Pixels per second, slow motion
+    static constexpr float energy_decay = 0.004f;      // Per second
+    static constexpr float thirst_decay = 0.008f;      // Per second, 0 = never thirsty
+    static constexpr float drink_rate = 0.5f;          // Hydration per second on water
+    static constexpr float pregnancy_time = 20.0f;     // 0 = spawns as soon as it has the energy
+    static constexpr float energy_after_conception = 3.0f;
+    static constexpr float move_interval = 0.4f;       // Seconds between steps
+    static constexpr float min_move_energy = 0.0f;     // Only steps with more energy than this
+    static constexpr float move_cost = 0.05f;          // Divided by movement efficiency
+    static constexpr uint8_t passable = TERRAIN_LAND;
+    static constexpr uint8_t passable_thirsty = TERRAIN_LAND | TERRAIN_WATER;
+    static constexpr bool exclusive_hexes = true;      // One per hex, tracked in hare_positions
+    static constexpr int vision_range = 3;             // Hexes
+    static constexpr float sight_threshold = 0.1f;     // Minimum visibility to notice another animal
+    static constexpr bool flees = true;                // Always steps away from what it sees
+    static constexpr float carcass_nutrients = 0.3f;   // Added to the soil it dies on
+    static constexpr bool digests = true;              // Has a digestion countdown
+    static constexpr bool grazes = true;               // Eats plants over several seconds
+    // Grazing
+    static constexpr float graze_time = 2.0f;
+    static constexpr float graze_rate = 0.25f;         // Energy per second while eating
+    static constexpr float energy_cap = 2.0f;
+};
+
+template <>
+struct SpeciesTraits<Fox> {
+    static constexpr EventSpecies species = SPECIES_FOX;
+    static constexpr float anim_speed = 50.0f;
+    static constexpr float energy_decay = 0.008f;
+    static constexpr float thirst_decay = 0.008f;
+    static constexpr float drink_rate = 0.5f;
+    static constexpr float pregnancy_time = 20.0f;
+    static constexpr float energy_after_conception = 1.5f;
+    static constexpr float move_interval = 0.4f;
+    static constexpr float min_move_energy = 0.0f;
+    static constexpr float move_cost = 0.05f;
+    static constexpr uint8_t passable = TERRAIN_LAND;
+    static constexpr uint8_t passable_thirsty = TERRAIN_LAND;  // Foxes don't swim but drink at edges
+    static constexpr bool exclusive_hexes = false;
+    static constexpr int vision_range = 3;
+    static constexpr float sight_threshold = 0.1f;
+    static constexpr bool flees = false;               // Gives chase depending on hunting aggression
+    static constexpr float carcass_nutrients = 0.3f;
+    static constexpr bool digests = true;
+    static constexpr bool grazes = false;
+    // Hunting
+    static constexpr float digestion_time = 10.0f;
+    static constexpr float catch_cap = 7.0f;           // Energy cap after catching prey on its own hex
+    static constexpr float pounce_cap = 6.0f;          // Energy cap after catching prey next to it
+    static constexpr float catch_visibility = 0.3f;    // Minimum visibility (after pack bonus) to pounce
+    static constexpr float pack_bonus = 0.2f;          // Per neighbouring pack member, 0 = hunts alone
+    static constexpr HexField HexGrid::*pack_neighbors = &HexGrid::fox_neighbors;  // Pack members around each tile
+};
+
+template <>
+struct SpeciesTraits<Wolf> {
+    static constexpr EventSpecies species = SPECIES_WOLF;
+    static constexpr float anim_speed = 200.0f;
+    static constexpr float energy_decay = 0.01f;
+    static constexpr float thirst_decay = 0.009f;
+    static constexpr float drink_rate = 0.5f;
+    static constexpr float pregnancy_time = 25.0f;
+    static constexpr float energy_after_conception = 4.0f;
+    static constexpr float move_interval = 0.6f;
+    static constexpr float min_move_energy = 2.0f;
+    static constexpr float move_cost = 0.08f;
+    static constexpr uint8_t passable = TERRAIN_LAND;
+    static constexpr uint8_t passable_thirsty = TERRAIN_LAND | TERRAIN_WATER;
+    static constexpr bool exclusive_hexes = false;
+    static constexpr int vision_range = 4;
+    static constexpr float sight_threshold = 0.2f;
+    static constexpr bool flees = false;
+    static constexpr float carcass_nutrients = 0.4f;
+    static constexpr bool digests = true;
+    static constexpr bool grazes = false;
+    // Hunting
+    static constexpr float digestion_time = 15.0f;
+    static constexpr float catch_cap = 8.0f;
+    static constexpr float pounce_cap = 8.0f;
+    static constexpr float catch_visibility = 0.2f;
+    static constexpr float pack_bonus = 0.0f;
+};
+
+template <>
+struct SpeciesTraits<Salmon> {
+    static constexpr EventSpecies species = SPECIES_SALMON;
+    static constexpr float anim_speed = 0.0f;          // Drawn at the hex center
+    static constexpr float energy_decay = 0.005f;
+    static constexpr float thirst_decay = 0.0f;
+    static constexpr float pregnancy_time = 0.0f;
+    static constexpr float move_interval = 1.0f;
+    static constexpr float min_move_energy = 0.0f;
+    static constexpr float move_cost = 0.0f;
+    static constexpr uint8_t passable = TERRAIN_WATER;
+    static constexpr uint8_t passable_thirsty = TERRAIN_WATER;
+    static constexpr bool exclusive_hexes = false;
+    static constexpr float carcass_nutrients = 0.0f;
+    static constexpr bool digests = false;
+    static constexpr bool grazes = false;
+};
+
+// ============================================================================
+// SPECIES KERNELS - Shared update steps, instantiated per species
+// ============================================================================
+
+// Up to six neighbour directions, kept on the stack
+struct DirectionSet {
+    int dirs[6];
+    int count = 0;
+
+    void push(int dir) { dirs[count++] = dir; }
+    bool empty() const { return count == 0; }
+    int operator[](int i) const { return dirs[i]; }
+    const int* begin() const { return dirs; }
+    const int* end() const { return dirs + count; }
+};
+
+// Closest animal noticed this step
+struct Sighting {
+    int q = 0, r = 0;
+    int dist = 0;
+    bool seen = false;
+};
+
+// How visible an animal is on the given terrain
+inline float visibility(const Hare& hare, TerrainType terrain) {
+    return hare.is_burrowing ? 0.0f : HexGrid::calculate_visibility(hare.getColor(), terrain);
+}
+
+template <typename Animal>
+float visibility(const Animal& animal, TerrainType terrain) {
+    return HexGrid::calculate_visibility(animal.getColor(), terrain);
+}
+
+// Conceive once energy passes the genome's threshold; the pregnancy itself
+// counts down in batch (see batch_pregnancy)
+template <typename Animal>
+void try_conceive(Animal& a) {
+    using Traits = SpeciesTraits<Animal>;
+    if constexpr (Traits::pregnancy_time > 0.0f) {
+        if (a.energy > a.genome.reproduction_threshold && !a.is_pregnant) {
+            a.is_pregnant = true;
+            a.pregnancy_timer = Traits::pregnancy_time;
+            event_log.emit(EVENT_PREGNANT, LOG_DEBUG, Traits::species, a.q, a.r, {a.energy});
+            a.energy = Traits::energy_after_conception;
+        }
+    } else {
+        if (a.energy > a.reproduction_threshold) {
+            a.ready_to_give_birth = true;
+        }
+    }
+}
+
+// Neighbour directions the animal may step into
+template <typename Animal>
+DirectionSet passable_directions(const Animal& a, const HexGrid& grid) {
+    using Traits = SpeciesTraits<Animal>;
+    uint8_t mask = Traits::passable;
+    if constexpr (Traits::passable_thirsty != Traits::passable) {
+        if (a.thirst < THIRSTY) mask = Traits::passable_thirsty;
+    }
+
+    DirectionSet dirs;
+    for (int dir = 0; dir < 6; ++dir) {
+        auto [nq, nr] = hex_neighbor(a.q, a.r, dir);
+        if (!grid.has_hexagon(nq, nr)) continue;
+        if constexpr (Traits::exclusive_hexes) {
+            if (grid.hare_positions.find({nq, nr}) != grid.hare_positions.end()) continue;
+        }
+        if (mask & terrain_bit(grid.get_terrain_type(nq, nr))) {
+            dirs.push(dir);
+        }
+    }
+    return dirs;
+}
+
+// Drop burning neighbours unless every option is burning
+inline void avoid_fire(const HexGrid& grid, int q, int r, DirectionSet& dirs) {
+    DirectionSet safe;
+    for (int dir : dirs) {
+        auto [nq, nr] = hex_neighbor(q, r, dir);
+        if (grid.fire_timers.find({nq, nr}) == grid.fire_timers.end()) {
+            safe.push(dir);
+        }
+    }
+    if (!safe.empty()) {
+        dirs = safe;
+    }
+}
+
+template <typename Animal, typename Other>
+void scan_for(const Animal& a, const HexGrid& grid, const std::vector<Other>& others, Sighting& closest) {
+    using Traits = SpeciesTraits<Animal>;
+    for (const auto& other : others) {
+        if (other.is_dead) continue;
+        int dist = hex_distance(other.q - a.q, other.r - a.r);
+        if (dist <= Traits::vision_range && dist > 0 && dist < closest.dist) {
+            if (visibility(other, grid.get_terrain_type(other.q, other.r)) > Traits::sight_threshold) {
+                closest = {other.q, other.r, dist, true};
+            }
+        }
+    }
+}
+
+// Closest visible animal within vision range; earlier lists win ties
+template <typename Animal, typename... Others>
+Sighting closest_visible(const Animal& a, const HexGrid& grid, const std::vector<Others>&... others) {
+    Sighting closest;
+    closest.dist = SpeciesTraits<Animal>::vision_range + 1;
+    (scan_for(a, grid, others, closest), ...);
+    return closest;
+}
+
+// Directions that close in on (or, for prey, get away from) a sighting
+template <typename Animal>
+DirectionSet directions_relative(const Animal& a, const DirectionSet& dirs, const Sighting& sighting) {
+    DirectionSet out;
+    if (!sighting.seen) return out;
+    for (int dir : dirs) {
+        auto [nq, nr] = hex_neighbor(a.q, a.r, dir);
+        int new_dist = hex_distance(sighting.q - nq, sighting.r - nr);
+        if constexpr (SpeciesTraits<Animal>::flees) {
+            if (new_dist > sighting.dist) out.push(dir);
+        } else {
+            if (new_dist < sighting.dist) out.push(dir);
+        }
+    }
+    return out;
+}
+
+// Take one step, paying its energy cost
+template <typename Animal>
+void step(Animal& a, HexGrid& grid, int dir) {
+    using Traits = SpeciesTraits<Animal>;
+    int old_q = a.q, old_r = a.r;
+    a.move(dir);
+    if constexpr (Traits::exclusive_hexes) {
+        grid.hare_positions.erase({old_q, old_r});
+        grid.hare_positions.insert({a.q, a.r});
+    }
+    if constexpr (Traits::move_cost > 0.0f) {
+        a.energy -= Traits::move_cost / a.genome.movement_efficiency;
+    }
+    a.move_timer = 0.0f;
+}
+
+// Land movement: avoid fire, seek water when parched, otherwise flee from or
+// chase the closest visible animal in the given lists. The move timer is
+// advanced in batch (see batch_decay_needs).
+template <typename Animal, typename... Seen>
+void wander(Animal& a, HexGrid& grid, std::mt19937& rng, const std::vector<Seen>&... seen) {
+    using Traits = SpeciesTraits<Animal>;
+    if (a.move_timer < Traits::move_interval || a.energy <= Traits::min_move_energy) return;
+
+    DirectionSet valid = passable_directions(a, grid);
+    if (valid.empty()) return;
+    avoid_fire(grid, a.q, a.r, valid);
+
+    DirectionSet drawn = directions_relative(a, valid, closest_visible(a, grid, seen...));
+
+    DirectionSet water;
+    if (a.thirst < THIRSTY) {
+        for (int dir : valid) {
+            auto [nq, nr] = hex_neighbor(a.q, a.r, dir);
+            if (grid.get_terrain_type(nq, nr) == WATER) {
+                water.push(dir);
+            }
+        }
+    }
+
+    const DirectionSet* chosen = &valid;
+    if (!water.empty() && a.thirst < PARCHED) {
+        chosen = &water;
+    } else if (!drawn.empty()) {
+        if constexpr (Traits::flees) {
+            chosen = &drawn;
+        } else {
+            std::uniform_real_distribution<float> prob_dist(0.0f, 1.0f);
+            if (prob_dist(rng) < a.genome.hunting_aggression) chosen = &drawn;
+        }
+    }
+
+    if constexpr (Traits::flees) {
+        step(a, grid, (*chosen)[0]);
+    } else {
+        step(a, grid, (*chosen)[rng() % chosen->count]);
+    }
+}
+
+template <typename Animal, typename Prey>
+void devour(Animal& a, std::vector<Prey>& prey, typename std::vector<Prey>::iterator it, float cap, int q, int r) {
+    float gained = it->energy;
+    a.energy += gained;
+    a.energy = std::min(cap, a.energy);
+    a.last_prey_id = it->id;
+    prey.erase(it);
+    event_log.emit(EVENT_CAUGHT, LOG_INFO, SpeciesTraits<Animal>::species, q, r, {gained, a.energy},
+                   SpeciesTraits<Prey>::species);
+}
+
+// Prey sharing the hunter's hex is caught automatically
+template <typename Animal, typename Prey>
+bool catch_here(Animal& a, std::vector<Prey>& prey) {
+    for (auto it = prey.begin(); it != prey.end(); ++it) {
+        if (!it->is_dead && it->q == a.q && it->r == a.r) {
+            devour(a, prey, it, SpeciesTraits<Animal>::catch_cap, a.q, a.r);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Prey on a neighbouring hex is caught if visible enough and slower
+template <typename Animal, typename Prey>
+bool pounce(Animal& a, const HexGrid& grid, std::vector<Prey>& prey, int nq, int nr) {
+    using Traits = SpeciesTraits<Animal>;
+    for (auto it = prey.begin(); it != prey.end(); ++it) {
+        if (it->is_dead || it->q != nq || it->r != nr) continue;
+
+        float seen = visibility(*it, grid.get_terrain_type(nq, nr));
+        if constexpr (Traits::pack_bonus > 0.0f) {
+            float nearby = (grid.*Traits::pack_neighbors).get(a.q, a.r);
+            seen *= 1.0f + nearby * Traits::pack_bonus;
+        }
+        if (seen > Traits::catch_visibility && a.speed() > it->speed()) {
+            devour(a, prey, it, Traits::pounce_cap, nq, nr);
+            return true;
+        }
+        return false;  // Only one animal per hex is worth trying
+    }
+    return false;
+}
+
+// Catch one animal from the prey lists, in list order
+template <typename Animal, typename... Prey>
+bool hunt_prey(Animal& a, const HexGrid& grid, std::vector<Prey>&... prey) {
+    if ((catch_here(a, prey) || ...)) return true;
+    for (int dir = 0; dir < 6; ++dir) {
+        auto [nq, nr] = hex_neighbor(a.q, a.r, dir);
+        if ((pounce(a, grid, prey, nq, nr) || ...)) return true;
+    }
+    return false;
+}
+
+template <typename Animal>
+void die(Animal& a, HexGrid& grid, DeathCause cause, EventType event) {
+    using Traits = SpeciesTraits<Animal>;
+    a.is_dead = true;
+    a.death_cause = cause;
+    if constexpr (Traits::carcass_nutrients > 0.0f) {
+        auto it = grid.terrainTiles.find({a.q, a.r});
+        if (it != grid.terrainTiles.end() && it->second.type == SOIL) {
+            grid.nutrients.set(a.q, a.r, std::min(1.0f, grid.nutrients.get(a.q, a.r) + Traits::carcass_nutrients));
+        }
+    }
+    event_log.emit(event, LOG_INFO, Traits::species, a.q, a.r);
+}
+
+// Starvation, then dehydration
+template <typename Animal>
+void check_death(Animal& a, HexGrid& grid) {
+    if (a.energy <= 0.0f && !a.is_dead) {
+        die(a, grid, CAUSE_STARVED, EVENT_STARVED);
+    }
+    if constexpr (SpeciesTraits<Animal>::thirst_decay > 0.0f) {
+        if (a.thirst <= 0.0f && !a.is_dead) {
+            die(a, grid, CAUSE_DEHYDRATED, EVENT_DEHYDRATED);
+        }
+    }
+}
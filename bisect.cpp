@@ -0,0 +1,274 @@
+#include "simulation.hpp"
+#include "world_digest.hpp"
+#include "world_map.hpp"
+#include "event_log.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// HEXAWORLD BISECT - Finds where two runs stop being identical
+// ============================================================================
+
+// hexaworld_bisect --a CONFIG --b CONFIG [--ticks N] [--every K] [--size WIDTHxHEIGHT] [--lines L]
+// hexaworld_bisect --a CONFIG --trace FILE [--ticks N] [--size WIDTHxHEIGHT]
+// hexaworld_bisect --a CONFIG --write-trace FILE [--ticks N] [--size WIDTHxHEIGHT]
+//
+// A CONFIG is a comma-separated list of key=value settings, any of which
+// may be left out: seed=N, crossover=0|1, slices=N (time slices, as the
+// tick governor would set), map=FILE (a baked map instead of generating)
+// and fire=T (start a random fire before tick T; may repeat).
+//
+// With two configurations both worlds are stepped side by side and their
+// digests compared every K ticks. After a mismatch the last matching
+// checkpoint is replayed tick by tick to find the first tick whose state
+// differs, and the differing entities and fields are printed. A trace file
+// (HEXAWORLD_DIGEST_FILE, or --write-trace) from another build is compared
+// tick by tick instead, which shows whether a code change altered results.
+//
+// Exit status: 0 if the runs agree, 2 if they diverge, 1 on errors.
+
+namespace {
+
+void usage() {
+    std::cerr << "Usage: hexaworld_bisect --a CONFIG (--b CONFIG | --trace FILE | --write-trace FILE)\n"
+              << "                        [--ticks N] [--every K] [--size WIDTHxHEIGHT] [--lines L]\n"
+              << "CONFIG: comma-separated seed=N, crossover=0|1, slices=N, map=FILE, fire=TICK" << std::endl;
+}
+
+struct RunConfig {
+    std::string text;  // As given, for the report
+    unsigned int seed = RANDOM_SEED;
+    bool crossover = false;
+    unsigned int slices = 1;
+    std::string map_file;
+    std::vector<uint64_t> fires;  // Ticks to start a random fire before
+};
+
+RunConfig parse_config(const std::string& text) {
+    RunConfig config;
+    config.text = text.empty() ? "defaults" : text;
+    std::istringstream in(text);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (item.empty()) continue;
+        size_t eq = item.find('=');
+        std::string key = item.substr(0, eq);
+        std::string value = eq == std::string::npos ? "" : item.substr(eq + 1);
+        try {
+            if (key == "seed") {
+                config.seed = static_cast<unsigned int>(std::stoul(value));
+            } else if (key == "crossover") {
+                config.crossover = std::stoi(value) != 0;
+            } else if (key == "slices") {
+                config.slices = static_cast<unsigned int>(std::max(1, std::stoi(value)));
+            } else if (key == "map" && !value.empty()) {
+                config.map_file = value;
+            } else if (key == "fire") {
+                config.fires.push_back(std::stoull(value));
+            } else {
+                throw std::invalid_argument(key);
+            }
+        } catch (const std::logic_error&) {
+            throw std::runtime_error("Bad setting '" + item + "' in configuration " + text);
+        }
+    }
+    return config;
+}
+
+// One world with its own generator; the shared gen is swapped in around
+// each tick, so two runs can be stepped in one process
+class Run {
+public:
+    Run(const RunConfig& config, float world_width, float world_height) : config_(config) {
+        gen.seed(config.seed);
+        if (!config.map_file.empty()) {
+            WorldMap map(config.map_file);
+            sim.load_map(map);
+        } else {
+            sim.generate(world_width, world_height);
+        }
+        sim.crossover_births = config.crossover;
+        sim.time_slices = config.slices;
+        rng = gen;
+        terrain_ = digest_terrain(sim.grid);
+    }
+
+    void step() {
+        gen = rng;
+        for (uint64_t tick : config_.fires) {
+            if (tick == sim.tick_count) sim.start_fire();
+        }
+        sim.tick(SIM_DT);
+        rng = gen;
+    }
+
+    void advance_to(uint64_t tick) {
+        while (sim.tick_count < tick) step();
+    }
+
+    WorldDigest digest() const { return digest_world(sim, rng, terrain_); }
+
+    Simulation sim{HEX_SIZE};
+    std::mt19937 rng;
+
+private:
+    RunConfig config_;
+    uint64_t terrain_;
+};
+
+void print_sections(const WorldDigest& a, const WorldDigest& b) {
+    std::cout << "Differing sections:";
+    for (int s = 0; s < DIGEST_SECTION_COUNT; ++s) {
+        if (a.sections[s] != b.sections[s]) std::cout << " " << digest_section_name(static_cast<DigestSection>(s));
+    }
+    std::cout << std::endl;
+}
+
+std::string hex(uint64_t value) {
+    std::ostringstream out;
+    out << std::hex << std::setw(16) << std::setfill('0') << value;
+    return out.str();
+}
+
+int compare_runs(const RunConfig& config_a, const RunConfig& config_b, float width, float height,
+                 uint64_t ticks, uint64_t every, size_t lines) {
+    std::cout << "A: " << config_a.text << "\nB: " << config_b.text << std::endl;
+    auto a = std::make_unique<Run>(config_a, width, height);
+    auto b = std::make_unique<Run>(config_b, width, height);
+
+    // Coarse pass: compare at checkpoints only
+    uint64_t good = 0, bad = 0;
+    if (a->digest() != b->digest()) {
+        std::cout << "The worlds already differ once created" << std::endl;
+    } else {
+        while (a->sim.tick_count < ticks) {
+            uint64_t next = std::min(ticks, a->sim.tick_count + every);
+            a->advance_to(next);
+            b->advance_to(next);
+            if (a->digest() != b->digest()) {
+                bad = next;
+                break;
+            }
+            good = next;
+        }
+        if (bad == 0) {
+            std::cout << "Identical for " << ticks << " ticks, final digest " << hex(a->digest().total) << std::endl;
+            return 0;
+        }
+
+        // Fine pass: replay from the last match and compare every tick
+        std::cout << "Match at tick " << good << ", mismatch by tick " << bad << "; narrowing" << std::endl;
+        a = std::make_unique<Run>(config_a, width, height);
+        b = std::make_unique<Run>(config_b, width, height);
+        a->advance_to(good);
+        b->advance_to(good);
+        while (a->sim.tick_count < bad) {
+            a->step();
+            b->step();
+            if (a->digest() != b->digest()) break;
+        }
+        std::cout << "First divergence after tick " << a->sim.tick_count << " (identical after tick "
+                  << a->sim.tick_count - 1 << ")" << std::endl;
+    }
+
+    print_sections(a->digest(), b->digest());
+    size_t differences = diff_worlds(a->sim, a->rng, b->sim, b->rng, std::cout, lines);
+    std::cout << differences << " differences" << std::endl;
+    return 2;
+}
+
+int compare_trace(const RunConfig& config, const std::string& trace_file, float width, float height, uint64_t ticks) {
+    std::ifstream trace(trace_file);
+    if (!trace) throw std::runtime_error("Failed to open digest file: " + trace_file);
+    std::cout << "A: " << config.text << "\nB: " << trace_file << std::endl;
+    Run a(config, width, height);
+
+    std::string line;
+    uint64_t tick = 0, compared = 0;
+    WorldDigest expected;
+    while (a.sim.tick_count < ticks && std::getline(trace, line)) {
+        if (!parse_digest_line(line, tick, expected)) continue;
+        if (tick <= a.sim.tick_count) continue;  // Only ever moves forward
+        a.advance_to(tick);
+        WorldDigest digest = a.digest();
+        compared++;
+        if (digest != expected) {
+            std::cout << "First divergence after tick " << tick << " (" << compared << " ticks compared)" << std::endl;
+            print_sections(digest, expected);
+            return 2;
+        }
+    }
+    std::cout << "Identical for " << compared << " traced ticks, last " << tick << std::endl;
+    return 0;
+}
+
+int write_trace(const RunConfig& config, const std::string& trace_file, float width, float height, uint64_t ticks) {
+    Run a(config, width, height);
+    DigestTrace trace(trace_file);
+    a.sim.digest_trace = &trace;
+    a.advance_to(ticks);
+    std::cout << "Wrote " << ticks << " digests of " << config.text << " to " << trace_file
+              << ", final digest " << hex(a.digest().total) << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string config_a, config_b, trace_file, write_file;
+    bool has_b = false;
+    unsigned long long ticks = 3600, every = 100;  // One simulated minute
+    unsigned long lines = 40;
+    float width = 1280.0f, height = 1024.0f;  // The viewer's window at world scale 1
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--a" && has_value) {
+            config_a = argv[++i];
+        } else if (arg == "--b" && has_value) {
+            config_b = argv[++i];
+            has_b = true;
+        } else if (arg == "--trace" && has_value) {
+            trace_file = argv[++i];
+        } else if (arg == "--write-trace" && has_value) {
+            write_file = argv[++i];
+        } else if (arg == "--ticks" && has_value && std::sscanf(argv[++i], "%llu", &ticks) == 1) {
+            continue;
+        } else if (arg == "--every" && has_value && std::sscanf(argv[++i], "%llu", &every) == 1 && every > 0) {
+            continue;
+        } else if (arg == "--lines" && has_value && std::sscanf(argv[++i], "%lu", &lines) == 1) {
+            continue;
+        } else if (arg == "--size" && has_value && std::sscanf(argv[++i], "%fx%f", &width, &height) == 2 && width > 0 && height > 0) {
+            continue;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    if (has_b + !trace_file.empty() + !write_file.empty() != 1) {
+        usage();
+        return 1;
+    }
+
+    try {
+        event_log.set_level(LOG_OFF);
+        RunConfig a = parse_config(config_a);
+        if (!write_file.empty()) return write_trace(a, write_file, width, height, ticks);
+        if (!trace_file.empty()) return compare_trace(a, trace_file, width, height, ticks);
+        return compare_runs(a, parse_config(config_b), width, height, ticks, every, lines);
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,41 @@
+#include "camera.hpp"
+#include "constants.hpp"
+#include <algorithm>
+
+// ============================================================================
+// CAMERA IMPLEMENTATION
+// ============================================================================
+
+void Camera::pan(float screen_dx, float screen_dy) {
+    x += screen_dx / zoom;
+    y += screen_dy / zoom;
+}
+
+void Camera::zoom_at(float factor, float screen_x, float screen_y, int screen_width, int screen_height) {
+    // World point under the cursor before zooming
+    float world_x = x + (screen_x - screen_width / 2.0f) / zoom;
+    float world_y = y + (screen_y - screen_height / 2.0f) / zoom;
+
+    zoom = std::clamp(zoom * factor, min_zoom, max_zoom);
+
+    // Move so the same world point stays under the cursor
+    x = world_x - (screen_x - screen_width / 2.0f) / zoom;
+    y = world_y - (screen_y - screen_height / 2.0f) / zoom;
+}
+
+void Camera::clamp_to(const ViewRect& world) {
+    x = std::clamp(x, world.left, world.right);
+    y = std::clamp(y, world.top, world.bottom);
+}
+
+ViewRect Camera::visible_rect(int screen_width, int screen_height) const {
+    float half_w = screen_width / 2.0f / zoom;
+    float half_h = screen_height / 2.0f / zoom;
+    return {x - half_w, y - half_h, x + half_w, y + half_h};
+}
+
+DetailLevel Camera::detail_level() const {
+    if (zoom < LOD_MINIMAL_ZOOM) return DETAIL_MINIMAL;
+    if (zoom < LOD_REDUCED_ZOOM) return DETAIL_REDUCED;
+    return DETAIL_FULL;
+}
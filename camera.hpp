@@ -0,0 +1,47 @@
+#pragma once
+
+// ============================================================================
+// CAMERA - Pannable, zoomable view onto the world
+// ============================================================================
+
+// Axis-aligned rectangle in world pixel coordinates (hex (0,0) at the origin)
+struct ViewRect {
+    float left = 0.0f, top = 0.0f, right = 0.0f, bottom = 0.0f;
+
+    bool contains(float x, float y) const {
+        return x >= left && x <= right && y >= top && y <= bottom;
+    }
+
+    ViewRect expanded(float margin) const {
+        return {left - margin, top - margin, right + margin, bottom + margin};
+    }
+};
+
+// How much detail to render at the current zoom level
+enum DetailLevel {
+    DETAIL_FULL,     // Textured terrain, blend edges, animal sprites
+    DETAIL_REDUCED,  // Shaded hexes only, animals as colored tiles
+    DETAIL_MINIMAL   // Flat hexes, animals as single points
+};
+
+class Camera {
+public:
+    float x = 0.0f, y = 0.0f;  // World position at the screen center
+    float zoom = 1.0f;         // Screen pixels per world pixel
+    float min_zoom = 0.1f;
+    float max_zoom = 4.0f;
+
+    // Move by a screen-space distance
+    void pan(float screen_dx, float screen_dy);
+
+    // Zoom by factor, keeping the world point under (screen_x, screen_y) fixed
+    void zoom_at(float factor, float screen_x, float screen_y, int screen_width, int screen_height);
+
+    // Keep the view center inside the world bounds
+    void clamp_to(const ViewRect& world);
+
+    // World rectangle currently covered by the screen
+    ViewRect visible_rect(int screen_width, int screen_height) const;
+
+    DetailLevel detail_level() const;
+};
@@ -0,0 +1,307 @@
+#include "column_export.hpp"
+#include "simulation.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+// ============================================================================
+// COLUMN EXPORT IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const char EXPORT_MAGIC[8] = {'H', 'W', 'C', 'O', 'L', 'S', '0', '1'};
+const char EXPORT_END[8] = {'H', 'W', 'C', 'O', 'L', 'E', 'N', 'D'};
+const uint8_t NO_TERRAIN = 255;
+const uint8_t NO_PLANT = 255;
+
+struct ColumnSpec {
+    const char* name;
+    ColumnType type;
+};
+
+// Written in this order by write_batch
+const ColumnSpec AGENT_COLUMNS[] = {
+    {"species", COLUMN_U8}, {"id", COLUMN_U32}, {"parent", COLUMN_U32}, {"q", COLUMN_I32}, {"r", COLUMN_I32},
+    {"energy", COLUMN_F32}, {"thirst", COLUMN_F32}, {"pregnant", COLUMN_U8}, {"pregnancy_timer", COLUMN_F32},
+    {"genome0", COLUMN_F32}, {"genome1", COLUMN_F32}, {"genome2", COLUMN_F32},
+    {"genome3", COLUMN_F32}, {"genome4", COLUMN_F32}, {"genome5", COLUMN_F32},
+};
+const ColumnSpec TILE_COLUMNS[] = {
+    {"q", COLUMN_I32}, {"r", COLUMN_I32}, {"terrain", COLUMN_U8}, {"nutrients", COLUMN_F32}, {"plant", COLUMN_U8},
+};
+const size_t AGENT_COLUMN_COUNT = sizeof(AGENT_COLUMNS) / sizeof(AGENT_COLUMNS[0]);
+const size_t TILE_COLUMN_COUNT = sizeof(TILE_COLUMNS) / sizeof(TILE_COLUMNS[0]);
+static_assert(AGENT_COLUMN_COUNT == 9 + GENOME_VALUES, "one column per genome value");
+
+ColumnEncoding encoding_of(ColumnType type) {
+    switch (type) {
+        case COLUMN_U8: return ENCODING_RLE;
+        case COLUMN_U32:
+        case COLUMN_I32: return ENCODING_DELTA;
+        case COLUMN_F32: return ENCODING_XOR;
+    }
+    return ENCODING_RLE;
+}
+
+// Rows [begin, end) of a column, encoded for its type
+void encode(const std::vector<uint8_t>& values, size_t begin, size_t end, RecordWriter& out) {
+    for (size_t i = begin; i < end;) {
+        size_t run = 1;
+        while (i + run < end && values[i + run] == values[i]) ++run;
+        out.varint(run);
+        out.u8(values[i]);
+        i += run;
+    }
+}
+
+template <typename Int>
+void encode(const std::vector<Int>& values, size_t begin, size_t end, RecordWriter& out) {
+    int64_t previous = 0;
+    for (size_t i = begin; i < end; ++i) {
+        out.svarint(static_cast<int64_t>(values[i]) - previous);
+        previous = values[i];
+    }
+}
+
+void encode(const std::vector<float>& values, size_t begin, size_t end, RecordWriter& out) {
+    uint32_t previous = 0;
+    for (size_t i = begin; i < end; ++i) {
+        uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        out.varint(bits ^ previous);
+        previous = bits;
+    }
+}
+
+void write_schema(RecordWriter& out, ExportTable table, const ColumnSpec* columns, size_t count) {
+    out.u8(table);
+    out.varint(count);
+    for (size_t c = 0; c < count; ++c) {
+        size_t length = std::strlen(columns[c].name);
+        out.varint(length);
+        out.bytes.insert(out.bytes.end(), columns[c].name, columns[c].name + length);
+        out.u8(columns[c].type);
+        out.u8(encoding_of(columns[c].type));
+    }
+}
+
+} // namespace
+
+ColumnExporter::ColumnExporter(const std::string& path, uint64_t interval)
+    : path_(path), interval_(interval > 0 ? interval : 1), file_(path, std::ios::binary) {
+    if (!file_) {
+        throw std::runtime_error("Failed to open export file: " + path);
+    }
+    file_.write(EXPORT_MAGIC, sizeof(EXPORT_MAGIC));
+    file_pos_ = sizeof(EXPORT_MAGIC);
+    columns_.resize(std::max(AGENT_COLUMN_COUNT, TILE_COLUMN_COUNT));
+    free_.resize(EXPORT_QUEUE_DEPTH + 1);  // One more for the batch being written
+    writer_ = std::thread(&ColumnExporter::work, this);
+}
+
+ColumnExporter::~ColumnExporter() {
+    finish();
+}
+
+void ColumnExporter::finish() {
+    if (!writer_.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    writer_.join();
+    write_footer();
+    file_.close();
+}
+
+template <typename Animal>
+void ColumnExporter::gather(Batch& batch, const std::vector<Animal>& animals, uint64_t tick) {
+    for (const Animal& animal : animals) {
+        RecordedAnimal recorded = record_animal(animal);
+        batch.species.push_back(recorded.species);
+        batch.id.push_back(animal.id);
+        batch.parent.push_back(animal.parent_id);
+        batch.q.push_back(animal.q);
+        batch.r.push_back(animal.r);
+        if constexpr (std::is_same_v<Animal, Salmon>) {
+            batch.energy.push_back(animal.energy_at(tick));
+            batch.thirst.push_back(1.0f);  // Salmon never thirst
+            batch.pregnant.push_back(0);
+            batch.pregnancy_timer.push_back(0.0f);
+        } else {
+            batch.energy.push_back(animal.energy);
+            batch.thirst.push_back(animal.thirst);
+            batch.pregnant.push_back(animal.is_pregnant);
+            batch.pregnancy_timer.push_back(animal.pregnancy_timer);
+        }
+        for (int g = 0; g < GENOME_VALUES; ++g) batch.genome[g].push_back(recorded.genome[g]);
+    }
+}
+
+void ColumnExporter::capture(const Simulation& sim) {
+    if (sim.tick_count % interval_ != 0) return;
+
+    Batch batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        batch = std::move(free_.back());
+        free_.pop_back();
+    }
+
+    // Clearing keeps the capacity of the last dump
+    batch.tick = sim.tick_count;
+    batch.species.clear(); batch.pregnant.clear();
+    batch.id.clear(); batch.parent.clear();
+    batch.q.clear(); batch.r.clear();
+    batch.energy.clear(); batch.thirst.clear(); batch.pregnancy_timer.clear();
+    for (auto& genome : batch.genome) genome.clear();
+    batch.tile_q.clear(); batch.tile_r.clear();
+    batch.terrain.clear(); batch.plant.clear();
+    batch.nutrients.clear();
+
+    gather(batch, sim.hares, sim.tick_count);
+    gather(batch, sim.foxes, sim.tick_count);
+    gather(batch, sim.wolves, sim.tick_count);
+    gather(batch, sim.salmons, sim.tick_count);
+
+    // Hexagons, terrain and plants are all ordered by (q, r), so one pass
+    // pairs them up
+    auto tile = sim.grid.terrainTiles.begin();
+    auto plant = sim.grid.plants.begin();
+    for (const auto& hexagon : sim.grid.hexagons) {
+        const auto& coord = hexagon.first;
+        while (tile != sim.grid.terrainTiles.end() && tile->first < coord) ++tile;
+        while (plant != sim.grid.plants.end() && plant->first < coord) ++plant;
+        bool has_terrain = tile != sim.grid.terrainTiles.end() && tile->first == coord;
+        bool planted = plant != sim.grid.plants.end() && plant->first == coord;
+        batch.tile_q.push_back(coord.first);
+        batch.tile_r.push_back(coord.second);
+        batch.terrain.push_back(has_terrain ? static_cast<uint8_t>(tile->second.type) : NO_TERRAIN);
+        batch.nutrients.push_back(sim.grid.nutrients.get(coord.first, coord.second));
+        batch.plant.push_back(planted ? static_cast<uint8_t>(plant->second.stage) : NO_PLANT);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(batch));
+    }
+    ready_.notify_one();
+}
+
+void ColumnExporter::work() {
+    for (;;) {
+        Batch batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;  // Stopping and drained
+            batch = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        write_batch(batch);
+        if (file_) {
+            written_.fetch_add(1, std::memory_order_relaxed);
+        } else if (!failed_) {
+            failed_ = true;
+            std::cerr << "Warning: Could not write export file " << path_ << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(batch));
+    }
+}
+
+void ColumnExporter::write_batch(const Batch& batch) {
+    // Every table writes at least one chunk, so empty dumps keep their tick
+    size_t agents = batch.id.size();
+    size_t begin = 0;
+    do {
+        size_t end = std::min(agents, begin + EXPORT_CHUNK_ROWS);
+        for (auto& column : columns_) column.bytes.clear();
+        size_t c = 0;
+        encode(batch.species, begin, end, columns_[c++]);
+        encode(batch.id, begin, end, columns_[c++]);
+        encode(batch.parent, begin, end, columns_[c++]);
+        encode(batch.q, begin, end, columns_[c++]);
+        encode(batch.r, begin, end, columns_[c++]);
+        encode(batch.energy, begin, end, columns_[c++]);
+        encode(batch.thirst, begin, end, columns_[c++]);
+        encode(batch.pregnant, begin, end, columns_[c++]);
+        encode(batch.pregnancy_timer, begin, end, columns_[c++]);
+        for (const auto& genome : batch.genome) encode(genome, begin, end, columns_[c++]);
+        write_chunk(TABLE_AGENTS, batch.tick, end - begin, c);
+        begin = end;
+    } while (begin < agents);
+
+    size_t tiles = batch.tile_q.size();
+    begin = 0;
+    do {
+        size_t end = std::min(tiles, begin + EXPORT_CHUNK_ROWS);
+        for (auto& column : columns_) column.bytes.clear();
+        size_t c = 0;
+        encode(batch.tile_q, begin, end, columns_[c++]);
+        encode(batch.tile_r, begin, end, columns_[c++]);
+        encode(batch.terrain, begin, end, columns_[c++]);
+        encode(batch.nutrients, begin, end, columns_[c++]);
+        encode(batch.plant, begin, end, columns_[c++]);
+        write_chunk(TABLE_TILES, batch.tick, end - begin, c);
+        begin = end;
+    } while (begin < tiles);
+}
+
+void ColumnExporter::write_chunk(ExportTable table, uint64_t tick, size_t rows, size_t columns) {
+    header_.bytes.clear();
+    header_.u8(table);
+    header_.varint(tick);
+    header_.varint(rows);
+    header_.varint(columns);
+    for (size_t c = 0; c < columns; ++c) header_.varint(columns_[c].bytes.size());
+    write_bytes(header_.bytes);
+
+    ChunkIndex chunk{table, tick, rows, {}, {}};
+    for (size_t c = 0; c < columns; ++c) {
+        chunk.offsets.push_back(file_pos_);
+        chunk.sizes.push_back(columns_[c].bytes.size());
+        write_bytes(columns_[c].bytes);
+    }
+    index_.push_back(std::move(chunk));
+}
+
+void ColumnExporter::write_footer() {
+    uint64_t footer = file_pos_;
+    header_.bytes.clear();
+    header_.varint(2);
+    write_schema(header_, TABLE_AGENTS, AGENT_COLUMNS, AGENT_COLUMN_COUNT);
+    write_schema(header_, TABLE_TILES, TILE_COLUMNS, TILE_COLUMN_COUNT);
+    header_.varint(index_.size());
+    for (const ChunkIndex& chunk : index_) {
+        header_.u8(chunk.table);
+        header_.varint(chunk.tick);
+        header_.varint(chunk.rows);
+        for (size_t c = 0; c < chunk.offsets.size(); ++c) {
+            header_.varint(chunk.offsets[c]);
+            header_.varint(chunk.sizes[c]);
+        }
+    }
+    for (int i = 0; i < 8; ++i) header_.u8(static_cast<uint8_t>(footer >> (8 * i)));
+    header_.bytes.insert(header_.bytes.end(), EXPORT_END, EXPORT_END + sizeof(EXPORT_END));
+    write_bytes(header_.bytes);
+    if (!file_ && !failed_) {
+        failed_ = true;
+        std::cerr << "Warning: Could not write export file " << path_ << std::endl;
+    }
+}
+
+void ColumnExporter::write_bytes(const std::vector<uint8_t>& bytes) {
+    file_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file_pos_ += bytes.size();
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include "recording.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class Simulation;
+
+// ============================================================================
+// COLUMN EXPORT - Periodic columnar dumps of every agent and tile
+// ============================================================================
+//
+// File layout: magic "HWCOLS01", then chunks, then a footer index and a
+// trailer. A chunk holds up to EXPORT_CHUNK_ROWS rows of one table at one
+// tick, column after column:
+//
+//   u8 table, varint tick, varint rows, varint column count,
+//   varint encoded bytes per column, then the columns' bytes
+//
+// so a scan can skip every column it does not need. Chunks decode on their
+// own; a dump with no rows still writes an empty chunk for its tick.
+//
+// The footer holds the schema (varint tables, then per table: u8 table,
+// varint columns, and per column a varint-length name, u8 ColumnType and
+// u8 ColumnEncoding) and the index (varint chunks, then per chunk: u8
+// table, varint tick, varint rows, and varint absolute offset and size per
+// column). The trailer is the footer's offset as a little-endian u64
+// followed by "HWCOLEND". Readers can memory-map the file and jump to
+// columns from the footer; a file cut short (no trailer) can still be read
+// chunk by chunk, with the column order listed at ExportTable.
+//
+// Columns are compressed by type, varints as in recordings:
+//   ENCODING_RLE    u8 columns: (varint run length, byte value) pairs
+//   ENCODING_DELTA  integer columns: zigzag varint of the difference to the previous row
+//   ENCODING_XOR    f32 columns: varint of the bits XOR the previous row's bits,
+//                   short when neighbouring values share sign, exponent and high bits
+
+enum ExportTable : uint8_t {
+    TABLE_AGENTS,  // species, id, parent, q, r, energy, thirst, pregnant, pregnancy_timer, genome0-5
+    TABLE_TILES    // q, r, terrain (TerrainType, 255 = none), nutrients, plant (PlantStage, 255 = none)
+};
+
+enum ColumnType : uint8_t {
+    COLUMN_U8,
+    COLUMN_U32,
+    COLUMN_I32,
+    COLUMN_F32
+};
+
+enum ColumnEncoding : uint8_t {
+    ENCODING_RLE,
+    ENCODING_DELTA,
+    ENCODING_XOR
+};
+
+// The simulation thread only copies columns into one of a fixed pool of
+// batches and queues it; encoding and disk writes happen on a writer
+// thread. When every batch is in use the dump is dropped rather than
+// stalling the tick.
+class ColumnExporter {
+public:
+    // Dump every `interval` ticks; throws if the file cannot be created
+    ColumnExporter(const std::string& path, uint64_t interval);
+    ~ColumnExporter();
+
+    // Called by Simulation::tick once the dead are removed; dumps on interval ticks
+    void capture(const Simulation& sim);
+
+    // Write out queued dumps and the footer, then join the writer
+    void finish();
+
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    // Columns of one dump, kept between uses for their capacity
+    struct Batch {
+        uint64_t tick = 0;
+        std::vector<uint8_t> species, pregnant;
+        std::vector<uint32_t> id, parent;
+        std::vector<int32_t> q, r;
+        std::vector<float> energy, thirst, pregnancy_timer;
+        std::vector<float> genome[GENOME_VALUES];
+        std::vector<int32_t> tile_q, tile_r;
+        std::vector<uint8_t> terrain, plant;
+        std::vector<float> nutrients;
+    };
+
+    struct ChunkIndex {
+        ExportTable table;
+        uint64_t tick;
+        uint64_t rows;
+        std::vector<uint64_t> offsets;  // Absolute, per column
+        std::vector<uint64_t> sizes;
+    };
+
+    std::string path_;
+    uint64_t interval_;
+    std::ofstream file_;
+    uint64_t file_pos_ = 0;
+    std::vector<ChunkIndex> index_;  // Writer thread only
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Batch> queue_;
+    std::vector<Batch> free_;
+    bool stopping_ = false;
+    std::thread writer_;
+
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    bool failed_ = false;  // Writer thread only; warned once
+
+    // Reused by the writer
+    std::vector<RecordWriter> columns_;
+    RecordWriter header_;
+
+    template <typename Animal>
+    void gather(Batch& batch, const std::vector<Animal>& animals, uint64_t tick);
+    void work();
+    void write_batch(const Batch& batch);
+    void write_chunk(ExportTable table, uint64_t tick, size_t rows, size_t columns);  // From columns_
+    void write_footer();
+    void write_bytes(const std::vector<uint8_t>& bytes);
+};
@@ -4,7 +4,7 @@
 #include <SFML/Graphics.hpp>
 
 const float HEX_SIZE = 12.0f;
-const float SQRT3 = 1.73205080757f;
+constexpr float SQRT3 = 1.73205080757f;
 
 // Animation speeds for terrain types
 const float ROCK_ANIM_SPEED = 1.5f;
@@ -16,6 +16,76 @@ const sf::Color SOIL_COLOR(139, 69, 19);   // Brown
 const sf::Color ROCK_COLOR(128, 128, 128); // Grey
 const sf::Color WATER_COLOR(0, 100, 200);  // Blue
 
+// Camera
+const float CAMERA_PAN_SPEED = 600.0f;   // Screen pixels per second
+const float CAMERA_ZOOM_STEP = 1.15f;    // Zoom factor per wheel notch / key press
+const float LOD_REDUCED_ZOOM = 0.75f;    // Below this zoom, drop terrain textures
+const float LOD_MINIMAL_ZOOM = 0.35f;    // Below this zoom, flat hexes and point animals
+
+// Plant and fire layer
+const float PLANT_CHUNK_SIZE = 256.0f;          // World pixels per side of a cached chunk
+const size_t PLANT_LAYER_TEXELS = 32u << 20;    // Chunk texture budget (128 MB), least recently drawn evicted first
+const float FIRE_FRAME_TIME = 0.25f;            // Seconds of burn per flame size step
+const unsigned int TILE_CHANGE_WINDOW = 16;     // Publishes of tile changes a snapshot carries; a renderer further behind redraws every chunk
+
+// Parallel frame building
+const size_t FRAME_CHUNK_TILES = 48;        // Full-detail hexes per vertex buffer built on one worker
+const size_t FRAME_CHUNK_ANIMALS = 256;     // Animals per vertex buffer
+const float BATCH_CIRCLE_TOLERANCE = 0.25f; // Screen pixels a batched circle's edge may fall inside the true circle
+
+// Simulation timing
+const float SIM_DT = 1.0f / 60.0f;            // Fixed simulation timestep in seconds
+const float GRAPH_UPDATE_INTERVAL = 1.0f;     // Population graph sample every second
+const size_t MAX_HISTORY = 1000;              // Population graph samples kept
+const float LOG_INTERVAL = 10.0f;             // Console population log every 10 seconds
+const float SNAPSHOT_MIN_INTERVAL = 0.008f;   // Publish render snapshots at most ~120 times a second
+const float SPRITE_SNAP_TIME = 1.0f;          // Simulated seconds between frames beyond which sprites snap instead of easing
+const float SPRITE_VIEW_MARGIN = 4.0f * HEX_SIZE;  // World pixels beyond the view within which sprites are still eased
+
+// Tick budget governor
+const unsigned int GOVERNOR_MAX_SLICES = 8;        // Most ticks deferrable work is spread over
+const unsigned int GOVERNOR_HOLD_TICKS = 60;       // Ticks between slice changes, long enough for the average to settle
+const float GOVERNOR_SMOOTHING = 0.05f;            // Weight of the latest tick in the average cost
+const float GOVERNOR_RELAX_FRACTION = 0.4f;        // Average cost, as a fraction of the budget, below which slicing halves
+const float GOVERNOR_REPORT_INTERVAL = 1.0f;       // Real seconds between overrun reports
+
+// Per-tile fields
+const float NUTRIENT_DIFFUSION_RATE = 0.01f;      // Fraction of the difference exchanged with each soil neighbour per second
+const float NUTRIENT_DIFFUSION_INTERVAL = 1.0f;   // Seconds between diffusion steps
+
+// Recording and replay
+const unsigned int KEYFRAME_INTERVAL = 600;   // Ticks between full keyframes (10 simulated seconds)
+const float REPLAY_SEEK_STEP = 10.0f;         // Simulated seconds skipped per seek key press
+const float REPLAY_MAX_SPEED = 1024.0f;       // Fastest playback, in multiples of real time
+
+// Frame capture
+const unsigned int CAPTURE_QUEUE_DEPTH = 8;   // Frames waiting to be written before new ones are dropped
+const unsigned int CAPTURE_WORKERS = 2;       // Threads encoding and writing frames
+
+// Column export
+const float EXPORT_INTERVAL = 10.0f;          // Simulated seconds between snapshot dumps
+const unsigned int EXPORT_QUEUE_DEPTH = 2;    // Dumps waiting to be written before new ones are dropped
+const size_t EXPORT_CHUNK_ROWS = 65536;       // Rows per chunk; readers decode a chunk at a time
+
+// Metrics endpoint
+const float METRICS_POLL_INTERVAL = 0.2f;           // Seconds between checks for shutdown while idle
+const float METRICS_CLIENT_TIMEOUT = 1.0f;          // Seconds a scraper may take to send its request
+const float METRICS_FPS_SMOOTHING = 0.05f;          // Weight of each new frame in the smoothed frame rate
+
+// Reproduction
+const int MATE_RANGE = 2;   // Hexes within which a parent finds a mate for crossover births
+
+// Island migration
+const float MIGRATION_INTERVAL = 30.0f;            // Simulated seconds between genome exchanges
+const unsigned int MIGRATION_MIGRANTS = 2;         // Genomes sent per species and exchange
+const unsigned int MIGRATION_MAX_MIGRANTS = 1024;  // Keeps a batch within one datagram
+const unsigned int MIGRATION_MIN_RESIDENTS = 4;    // A species never emigrates below this many
+const size_t MIGRATION_RING_BYTES = 1 << 16;       // Shared-memory ring per sending island
+const unsigned short MIGRATION_BASE_PORT = 47600;  // Island i listens on this + i when no peers are given
+
+// Lineage tracking
+const unsigned int LINEAGE_PRUNE_INTERVAL = 3600;  // Ticks between extinct-node sweeps (one simulated minute)
+
 // Seed for random generator
 const unsigned int RANDOM_SEED = 444;
 
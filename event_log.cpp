@@ -0,0 +1,278 @@
+#include "event_log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
+// ============================================================================
+// EVENT LOG IMPLEMENTATION
+// ============================================================================
+
+EventLog event_log;
+
+thread_local EventRing* EventLog::thread_ring_ = nullptr;
+thread_local uint64_t EventLog::thread_tick_ = 0;
+
+namespace {
+
+constexpr uint32_t TYPE_CATEGORIES[EVENT_TYPE_COUNT] = {
+    CATEGORY_HUNT,        // EVENT_CAUGHT
+    CATEGORY_DEATH,       // EVENT_STARVED
+    CATEGORY_DEATH,       // EVENT_DEHYDRATED
+    CATEGORY_DEATH,       // EVENT_BURNED
+    CATEGORY_BIRTH,       // EVENT_PREGNANT
+    CATEGORY_BIRTH,       // EVENT_BIRTH
+    CATEGORY_FIRE,        // EVENT_FIRE_STARTED
+    CATEGORY_GENOME,      // EVENT_GENOME
+    CATEGORY_POPULATION,  // EVENT_POPULATION
+    CATEGORY_WORLD,       // EVENT_TERRAIN
+    CATEGORY_GENOME,      // EVENT_LINEAGE
+    CATEGORY_PERF,        // EVENT_ALLOCATIONS
+    CATEGORY_PERF,        // EVENT_OVERRUN
+    CATEGORY_GENOME       // EVENT_MIGRATION
+};
+
+struct CategoryName {
+    const char* name;
+    uint32_t mask;
+};
+
+constexpr CategoryName CATEGORY_NAMES[] = {
+    {"hunt", CATEGORY_HUNT},
+    {"death", CATEGORY_DEATH},
+    {"birth", CATEGORY_BIRTH},
+    {"fire", CATEGORY_FIRE},
+    {"genome", CATEGORY_GENOME},
+    {"population", CATEGORY_POPULATION},
+    {"world", CATEGORY_WORLD},
+    {"perf", CATEGORY_PERF},
+    {"all", CATEGORY_ALL}
+};
+
+const char* LEVEL_NAMES[] = {"debug", "info", "warn", "off"};
+
+const char* species_name(uint8_t species) {
+    switch (species) {
+        case SPECIES_HARE: return "hare";
+        case SPECIES_FOX: return "fox";
+        case SPECIES_WOLF: return "wolf";
+        case SPECIES_SALMON: return "salmon";
+        default: return "?";
+    }
+}
+
+// Binary log header: magic, then the record size so readers can check layout
+constexpr char BINARY_MAGIC[8] = {'H', 'X', 'E', 'V', 'L', 'O', 'G', '1'};
+
+} // namespace
+
+uint32_t event_category(EventType type) {
+    return type < EVENT_TYPE_COUNT ? TYPE_CATEGORIES[type] : 0;
+}
+
+const char* event_level_name(EventLevel level) {
+    return level <= LOG_OFF ? LEVEL_NAMES[level] : "?";
+}
+
+bool event_level_from_name(const std::string& name, EventLevel& level) {
+    for (int i = LOG_DEBUG; i <= LOG_OFF; ++i) {
+        if (name == LEVEL_NAMES[i]) {
+            level = static_cast<EventLevel>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool event_category_from_name(const std::string& name, uint32_t& mask) {
+    for (const auto& category : CATEGORY_NAMES) {
+        if (name == category.name) {
+            mask = category.mask;
+            return true;
+        }
+    }
+    return false;
+}
+
+EventLog::~EventLog() {
+    stop();
+}
+
+void EventLog::open(const std::string& path, EventFormat format) {
+    format_ = format;
+    if (path.empty()) {
+        out_ = &std::cout;
+    } else {
+        auto mode = std::ios::out | std::ios::trunc;
+        if (format == FORMAT_BINARY) mode |= std::ios::binary;
+        file_.open(path, mode);
+        if (!file_) {
+            throw std::runtime_error("Failed to open event log file: " + path);
+        }
+        out_ = &file_;
+    }
+    if (format_ == FORMAT_BINARY) {
+        uint32_t record_size = sizeof(LogEvent);
+        out_->write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        out_->write(reinterpret_cast<const char*>(&record_size), sizeof(record_size));
+    }
+}
+
+void EventLog::start() {
+    if (!out_) out_ = &std::cout;
+    if (running_.exchange(true)) return;
+    drain_thread_ = std::thread(&EventLog::run, this);
+}
+
+void EventLog::stop() {
+    if (!running_.exchange(false)) return;
+    if (drain_thread_.joinable()) {
+        drain_thread_.join();
+    }
+    drain();
+    report_drops();
+    out_->flush();
+}
+
+uint64_t EventLog::dropped() const {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    uint64_t total = 0;
+    for (const auto& ring : rings_) {
+        total += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void EventLog::push(const LogEvent& event) {
+    EventRing* ring = thread_ring_ ? thread_ring_ : register_thread();
+    uint32_t head = ring->head.load(std::memory_order_relaxed);
+    uint32_t tail = ring->tail.load(std::memory_order_acquire);
+    if (head - tail >= EventRing::CAPACITY) {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ring->slots[head & (EventRing::CAPACITY - 1)] = event;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+EventRing* EventLog::register_thread() {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.push_back(std::make_unique<EventRing>());
+    thread_ring_ = rings_.back().get();
+    return thread_ring_;
+}
+
+size_t EventLog::drain() {
+    size_t count = 0;
+    buffer_.clear();
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        for (auto& ring : rings_) {
+            uint32_t tail = ring->tail.load(std::memory_order_relaxed);
+            uint32_t head = ring->head.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) {
+                format(ring->slots[tail & (EventRing::CAPACITY - 1)]);
+                count++;
+            }
+            ring->tail.store(tail, std::memory_order_release);
+        }
+    }
+    if (!buffer_.empty()) {
+        out_->write(buffer_.data(), buffer_.size());
+        out_->flush();
+    }
+    return count;
+}
+
+void EventLog::format(const LogEvent& e) {
+    if (format_ == FORMAT_BINARY) {
+        buffer_.append(reinterpret_cast<const char*>(&e), sizeof(e));
+        return;
+    }
+
+    char line[256];
+    unsigned long long tick = e.tick;
+    const char* who = species_name(e.species);
+    const float* v = e.values;
+    int n = 0;
+    switch (e.type) {
+        case EVENT_CAUGHT:
+            n = std::snprintf(line, sizeof(line), "%llu hunt %s caught %s at (%d, %d), gained %.2f energy, now %.2f\n",
+                              tick, who, species_name(e.prey), e.q, e.r, v[0], v[1]);
+            break;
+        case EVENT_STARVED:
+            n = std::snprintf(line, sizeof(line), "%llu death %s starved at (%d, %d)\n", tick, who, e.q, e.r);
+            break;
+        case EVENT_DEHYDRATED:
+            n = std::snprintf(line, sizeof(line), "%llu death %s died of dehydration at (%d, %d)\n", tick, who, e.q, e.r);
+            break;
+        case EVENT_BURNED:
+            n = std::snprintf(line, sizeof(line), "%llu death %s burned at (%d, %d)\n", tick, who, e.q, e.r);
+            break;
+        case EVENT_PREGNANT:
+            n = std::snprintf(line, sizeof(line), "%llu birth %s pregnant at (%d, %d), energy was %.2f\n", tick, who, e.q, e.r, v[0]);
+            break;
+        case EVENT_BIRTH:
+            n = std::snprintf(line, sizeof(line), "%llu birth %s gave birth at (%d, %d)\n", tick, who, e.q, e.r);
+            break;
+        case EVENT_FIRE_STARTED:
+            n = std::snprintf(line, sizeof(line), "%llu fire started at (%d, %d)\n", tick, e.q, e.r);
+            break;
+        case EVENT_GENOME:
+            n = std::snprintf(line, sizeof(line),
+                              "%llu genome %s at (%d, %d): reproduction_threshold = %.3f, movement_aggression = %.3f, weight = %.3f, speed = %.3f\n",
+                              tick, who, e.q, e.r, v[0], v[1], v[2], v[3]);
+            break;
+        case EVENT_POPULATION:
+            n = std::snprintf(line, sizeof(line), "%llu population hares %.0f, plants %.0f, salmons %.0f, foxes %.0f, wolves %.0f\n",
+                              tick, v[0], v[1], v[2], v[3], v[4]);
+            break;
+        case EVENT_TERRAIN:
+            n = std::snprintf(line, sizeof(line), "%llu world terrain soil %.0f, water %.0f, rock %.0f\n", tick, v[0], v[1], v[2]);
+            break;
+        case EVENT_LINEAGE:
+            n = std::snprintf(line, sizeof(line), "%llu lineage %.0f nodes (%.0f living, %.0f pruned), %s common ancestor %.0f born at tick %.0f\n",
+                              tick, v[0], v[1], v[2], who, v[3], v[4]);
+            break;
+        case EVENT_ALLOCATIONS:
+            n = std::snprintf(line, sizeof(line), "%llu perf allocations plants %.0f, fires %.0f, animals %.0f, births %.0f, bookkeeping %.0f\n",
+                              tick, v[0], v[1], v[2], v[3], v[4]);
+            break;
+        case EVENT_OVERRUN:
+            n = std::snprintf(line, sizeof(line), "%llu perf overrun %.0f of %.0f ticks over budget, slowest %.2f ms, average %.2f ms, sliced over %.0f ticks\n",
+                              tick, v[0], v[1], v[2], v[3], v[4]);
+            break;
+        case EVENT_MIGRATION:
+            n = std::snprintf(line, sizeof(line), "%llu migration %.0f %s %s island %.0f\n",
+                              tick, v[0], who, v[2] > 0.0f ? "arrived from" : "left for", v[1]);
+            break;
+        default:
+            n = std::snprintf(line, sizeof(line), "%llu unknown event %d\n", tick, static_cast<int>(e.type));
+            break;
+    }
+    if (n > 0) buffer_.append(line, std::min<size_t>(n, sizeof(line) - 1));
+}
+
+void EventLog::report_drops() {
+    uint64_t total = dropped();
+    if (total > reported_drops_) {
+        std::cerr << "Event log: dropped " << (total - reported_drops_) << " events (ring full)" << std::endl;
+        reported_drops_ = total;
+    }
+}
+
+void EventLog::run() {
+    using clock = std::chrono::steady_clock;
+    auto last_report = clock::now();
+    while (running_.load(std::memory_order_relaxed)) {
+        if (drain() == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        auto now = clock::now();
+        if (now - last_report >= std::chrono::seconds(1)) {
+            report_drops();
+            last_report = now;
+        }
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// EVENT LOG - Structured, asynchronous simulation event logging
+// ============================================================================
+
+enum EventLevel : uint8_t {
+    LOG_DEBUG,
+    LOG_INFO,
+    LOG_WARN,
+    LOG_OFF
+};
+
+// Category bits, combined into a filter mask
+enum EventCategory : uint32_t {
+    CATEGORY_HUNT       = 1u << 0,
+    CATEGORY_DEATH      = 1u << 1,
+    CATEGORY_BIRTH      = 1u << 2,
+    CATEGORY_FIRE       = 1u << 3,
+    CATEGORY_GENOME     = 1u << 4,
+    CATEGORY_POPULATION = 1u << 5,
+    CATEGORY_WORLD      = 1u << 6,
+    CATEGORY_PERF       = 1u << 7,
+    CATEGORY_ALL        = (1u << 8) - 1
+};
+
+enum EventType : uint8_t {
+    EVENT_CAUGHT,        // species caught prey; values: gained, energy
+    EVENT_STARVED,
+    EVENT_DEHYDRATED,
+    EVENT_BURNED,
+    EVENT_PREGNANT,      // values: energy before reset
+    EVENT_BIRTH,
+    EVENT_FIRE_STARTED,
+    EVENT_GENOME,        // values: reproduction_threshold, movement_aggression, weight, speed
+    EVENT_POPULATION,    // values: hares, plants, salmons, foxes, wolves
+    EVENT_TERRAIN,       // values: soil, water, rock tile counts
+    EVENT_LINEAGE,       // values: arena nodes, living, pruned, common ancestor id, its birth tick
+    EVENT_ALLOCATIONS,   // values: heap allocations in the plant, fire, animal, birth and bookkeeping phases
+    EVENT_OVERRUN,       // values: ticks over budget, ticks, slowest and average tick ms, time slices
+    EVENT_MIGRATION,     // values: animals, other island, 1 = arrived / 0 = left
+    EVENT_TYPE_COUNT
+};
+
+enum EventSpecies : uint8_t {
+    SPECIES_NONE,
+    SPECIES_HARE,
+    SPECIES_FOX,
+    SPECIES_WOLF,
+    SPECIES_SALMON
+};
+
+enum EventFormat {
+    FORMAT_TEXT,    // One compact line per event
+    FORMAT_BINARY   // Header followed by raw LogEvent records
+};
+
+// Fixed-size record, copied into a ring slot by the emitting thread
+struct LogEvent {
+    uint64_t tick;
+    uint8_t type;
+    uint8_t level;
+    uint8_t species;
+    uint8_t prey;
+    int32_t q, r;
+    float values[5];
+};
+
+// Single producer / single consumer ring, one per emitting thread
+struct EventRing {
+    static constexpr uint32_t CAPACITY = 1u << 14;  // Power of two
+
+    LogEvent slots[CAPACITY];
+    alignas(64) std::atomic<uint32_t> head{0};      // Next slot to write (producer)
+    alignas(64) std::atomic<uint32_t> tail{0};      // Next slot to read (drain thread)
+    std::atomic<uint64_t> dropped{0};               // Events lost to a full ring
+};
+
+uint32_t event_category(EventType type);
+const char* event_level_name(EventLevel level);
+
+// Parse "debug"/"info"/"warn"/"off"; returns false if unknown
+bool event_level_from_name(const std::string& name, EventLevel& level);
+// Parse a category name ("hunt", "death", ..., "all"); returns false if unknown
+bool event_category_from_name(const std::string& name, uint32_t& mask);
+
+// Emitting threads only filter and copy an event into their own ring; a
+// background thread formats and writes everything. A full ring drops the
+// event and counts it instead of blocking the simulation.
+class EventLog {
+public:
+    EventLog() = default;
+    ~EventLog();
+
+    // Output goes to stdout when path is empty
+    void open(const std::string& path, EventFormat format);
+    void start();
+    void stop();  // Drains what is left and reports drops
+
+    void set_level(EventLevel level) { level_.store(level, std::memory_order_relaxed); }
+    EventLevel level() const { return static_cast<EventLevel>(level_.load(std::memory_order_relaxed)); }
+    void set_categories(uint32_t mask) { categories_.store(mask, std::memory_order_relaxed); }
+    uint32_t categories() const { return categories_.load(std::memory_order_relaxed); }
+
+    bool enabled(EventType type, EventLevel level) const {
+        return level >= level_.load(std::memory_order_relaxed)
+            && (categories_.load(std::memory_order_relaxed) & event_category(type));
+    }
+
+    // Tick stamped on events emitted from the calling thread
+    void set_tick(uint64_t tick) { thread_tick_ = tick; }
+
+    void emit(EventType type, EventLevel level, EventSpecies species, int q, int r,
+              std::initializer_list<float> values = {}, EventSpecies prey = SPECIES_NONE) {
+        if (!enabled(type, level)) return;
+        LogEvent event{thread_tick_, type, level, species, prey, q, r, {}};
+        int i = 0;
+        for (float v : values) {
+            if (i == 5) break;
+            event.values[i++] = v;
+        }
+        push(event);
+    }
+
+    // Total events dropped because a ring was full
+    uint64_t dropped() const;
+
+private:
+    std::atomic<uint8_t> level_{LOG_INFO};
+    std::atomic<uint32_t> categories_{CATEGORY_ALL};
+
+    mutable std::mutex rings_mutex_;  // Guards rings_ (taken on thread registration and per drain pass)
+    std::vector<std::unique_ptr<EventRing>> rings_;
+
+    EventFormat format_ = FORMAT_TEXT;
+    std::ofstream file_;
+    std::ostream* out_ = nullptr;
+    std::string buffer_;              // Drain thread's output batch
+    uint64_t reported_drops_ = 0;
+
+    std::atomic<bool> running_{false};
+    std::thread drain_thread_;
+
+    static thread_local EventRing* thread_ring_;
+    static thread_local uint64_t thread_tick_;
+
+    void push(const LogEvent& event);
+    EventRing* register_thread();
+    size_t drain();
+    void format(const LogEvent& event);
+    void report_drops();
+    void run();
+};
+
+extern EventLog event_log;
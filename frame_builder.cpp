@@ -0,0 +1,140 @@
+#include "frame_builder.hpp"
+#include "hex_grid_new.hpp"
+#include "sfml_renderer.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+// ============================================================================
+// FRAME BUILDER IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// Lists a chunk can cover, in drawing order
+enum ChunkList { LIST_TILES, LIST_HARES, LIST_SALMONS, LIST_FOXES, LIST_WOLVES };
+
+const float SPRITE_TEXTURE_SIZE = 64.0f;  // Hare and fox textures, drawn centered
+
+// Overlapping circles for the body, tail and dorsal fins, and an eye
+void append_salmon(VertexBatch& out, const AnimalSprite& salmon, float x, float y) {
+    float scale = salmon.scale;
+    sf::Color color(salmon.color.r, salmon.color.g, salmon.color.b);
+    float body_width = 4.0f * scale;
+    out.circle(sf::Vector2f(x - 2 * scale, y), body_width * 0.8f, color); // Back
+    out.circle(sf::Vector2f(x, y), body_width, color); // Middle (widest)
+    out.circle(sf::Vector2f(x + 2 * scale, y), body_width * 0.8f, color); // Front
+
+    sf::Color fin(std::max(0, color.r - 30), std::max(0, color.g - 30), std::max(0, color.b - 30));
+    out.triangle(sf::Vector2f(x - 4 * scale, y), sf::Vector2f(x - 2 * scale, y - 3 * scale),
+                 sf::Vector2f(x - 2 * scale, y + 3 * scale), fin);
+    out.triangle(sf::Vector2f(x - 1 * scale, y - body_width * 0.8f), sf::Vector2f(x + 1 * scale, y - body_width * 0.8f),
+                 sf::Vector2f(x, y - body_width * 1.3f), fin);
+
+    out.circle(sf::Vector2f(x + 2 * scale, y - 1 * scale), 0.8f * scale, sf::Color::Black);
+}
+
+// Triangle head with ears and white eyes
+void append_wolf(VertexBatch& out, const AnimalSprite& wolf, float x, float y) {
+    float scale = wolf.scale;
+    sf::Color color(wolf.color.r, wolf.color.g, wolf.color.b);
+    out.triangle(sf::Vector2f(x, y + 12 * scale), sf::Vector2f(x - 10 * scale, y - 6 * scale),
+                 sf::Vector2f(x + 10 * scale, y - 6 * scale), color);
+    out.triangle(sf::Vector2f(x - 10 * scale, y - 6 * scale), sf::Vector2f(x - 6 * scale, y - 6 * scale),
+                 sf::Vector2f(x - 7.5f * scale, y - 12 * scale), color);
+    out.triangle(sf::Vector2f(x + 6 * scale, y - 6 * scale), sf::Vector2f(x + 10 * scale, y - 6 * scale),
+                 sf::Vector2f(x + 7.5f * scale, y - 12 * scale), color);
+    out.circle(sf::Vector2f(x - 3 * scale, y + 2.5f * scale), 1.5f * scale, sf::Color::White);
+    out.circle(sf::Vector2f(x + 3 * scale, y + 2.5f * scale), 1.5f * scale, sf::Color::White);
+}
+
+} // namespace
+
+void FrameBuilder::add_chunks(int list, size_t count, size_t chunk_size) {
+    for (size_t begin = 0; begin < count; begin += chunk_size) {
+        chunks_.push_back({list, begin, std::min(count, begin + chunk_size)});
+    }
+}
+
+template <typename Fill>
+void FrameBuilder::build(float zoom, Fill&& fill) {
+    if (batches_.size() < chunks_.size()) batches_.resize(chunks_.size());
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, chunks_.size(), 1), [&](const tbb::blocked_range<size_t>& range) {
+        for (size_t i = range.begin(); i != range.end(); ++i) {
+            VertexBatch& batch = batches_[i];
+            batch.clear();
+            batch.pixel_scale = zoom;
+            fill(chunks_[i], batch);
+        }
+    });
+}
+
+void FrameBuilder::draw_terrain(sf::RenderTarget& target, const HexGrid& grid, const SFMLRenderer& renderer,
+                                const ViewRect& view, float zoom, float offset_x, float offset_y,
+                                float brightness_center_q, float brightness_center_r, bool has_alive_hares) {
+    // Tiles come column by column, so a chunk is a strip of the screen
+    tiles_.clear();
+    grid.for_each_in_rect(view, [&](int q, int r, float x, float y) { tiles_.push_back({q, r, x, y}); });
+    chunks_.clear();
+    add_chunks(LIST_TILES, tiles_.size(), FRAME_CHUNK_TILES);
+
+    build(zoom, [&](const Chunk& chunk, VertexBatch& batch) {
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            const Tile& tile = tiles_[i];
+            grid.append_tile(batch, renderer, tile.q, tile.r, tile.x + offset_x, tile.y + offset_y,
+                             brightness_center_q, brightness_center_r, has_alive_hares);
+        }
+    });
+    for (size_t i = 0; i < chunks_.size(); ++i) batches_[i].draw(target);
+}
+
+void FrameBuilder::draw_animals(sf::RenderTarget& target, const RenderSnapshot& snapshot, const SFMLRenderer& renderer,
+                                float zoom, float offset_x, float offset_y) {
+    chunks_.clear();
+    add_chunks(LIST_HARES, hares.size(), FRAME_CHUNK_ANIMALS);
+    add_chunks(LIST_SALMONS, salmons.size(), FRAME_CHUNK_ANIMALS);
+    add_chunks(LIST_FOXES, foxes.size(), FRAME_CHUNK_ANIMALS);
+    add_chunks(LIST_WOLVES, wolves.size(), FRAME_CHUNK_ANIMALS);
+
+    build(zoom, [&](const Chunk& chunk, VertexBatch& batch) {
+        for (size_t i = chunk.begin; i < chunk.end; ++i) {
+            switch (chunk.list) {
+                case LIST_HARES: {
+                    const AnimalSprite& hare = snapshot.hares[hares[i]];
+                    batch.sprite(sf::Vector2f(hare.x + offset_x, hare.y + offset_y), SPRITE_TEXTURE_SIZE, hare.scale, hare.color);
+                    break;
+                }
+                case LIST_SALMONS: {
+                    const AnimalSprite& salmon = snapshot.salmons[salmons[i]];
+                    append_salmon(batch, salmon, salmon.x + offset_x, salmon.y + offset_y);
+                    break;
+                }
+                case LIST_FOXES: {
+                    const AnimalSprite& fox = snapshot.foxes[foxes[i]];
+                    batch.sprite(sf::Vector2f(fox.x + offset_x, fox.y + offset_y), SPRITE_TEXTURE_SIZE, fox.scale, fox.color);
+                    break;
+                }
+                case LIST_WOLVES: {
+                    const AnimalSprite& wolf = snapshot.wolves[wolves[i]];
+                    append_wolf(batch, wolf, wolf.x + offset_x, wolf.y + offset_y);
+                    break;
+                }
+            }
+        }
+    });
+
+    sf::RenderStates hare_states(&renderer.getHareTexture());
+    sf::RenderStates fox_states(&renderer.getFoxTexture());
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+        switch (chunks_[i].list) {
+            case LIST_HARES: batches_[i].draw(target, hare_states); break;
+            case LIST_FOXES: batches_[i].draw(target, fox_states); break;
+            default: batches_[i].draw(target); break;
+        }
+    }
+    hares.clear();
+    salmons.clear();
+    foxes.clear();
+    wolves.clear();
+}
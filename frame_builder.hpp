@@ -0,0 +1,62 @@
+#pragma once
+
+#include "vertex_batch.hpp"
+#include "render_snapshot.hpp"
+#include "camera.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class HexGrid;
+class SFMLRenderer;
+
+// ============================================================================
+// FRAME BUILDER - Full-detail terrain and animals built on the TBB pool
+// ============================================================================
+
+// Every visible hexagon and animal is turned into triangles rather than
+// drawn shape by shape. The work is cut into chunks of FRAME_CHUNK_TILES
+// tiles (runs of screen columns, left to right) or FRAME_CHUNK_ANIMALS
+// animals, and workers fill one vertex batch per chunk. The render thread
+// then draws the batches in chunk order, so overlapping shapes blend
+// exactly as they would drawn one by one, whichever worker built them.
+class FrameBuilder {
+public:
+    // Visible animals by index into the snapshot's lists, in drawing order;
+    // filled by the caller, emptied by draw_animals
+    std::vector<uint32_t> hares, salmons, foxes, wolves;
+
+    // Build and draw the tiles intersecting the view (world pixels);
+    // (offset_x, offset_y) is where the world origin is drawn
+    void draw_terrain(sf::RenderTarget& target, const HexGrid& grid, const SFMLRenderer& renderer,
+                      const ViewRect& view, float zoom, float offset_x, float offset_y,
+                      float brightness_center_q, float brightness_center_r, bool has_alive_hares);
+
+    // Build and draw the listed animals, species by species: hares and
+    // foxes as the renderer's sprites, salmon and wolves from shapes
+    void draw_animals(sf::RenderTarget& target, const RenderSnapshot& snapshot, const SFMLRenderer& renderer,
+                      float zoom, float offset_x, float offset_y);
+
+private:
+    struct Tile {
+        int q, r;
+        float x, y;
+    };
+
+    // A range of one list, built into one batch
+    struct Chunk {
+        int list;
+        size_t begin, end;
+    };
+
+    std::vector<Tile> tiles_;
+    std::vector<Chunk> chunks_;
+    std::vector<VertexBatch> batches_;  // One per chunk, kept between frames for their capacity
+
+    void add_chunks(int list, size_t count, size_t chunk_size);
+
+    // Clear and fill every chunk's batch with fill(chunk, batch) in parallel
+    template <typename Fill>
+    void build(float zoom, Fill&& fill);
+};
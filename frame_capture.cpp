@@ -0,0 +1,119 @@
+#include "frame_capture.hpp"
+#include "constants.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+// ============================================================================
+// FRAME CAPTURE IMPLEMENTATION
+// ============================================================================
+
+FrameCapture::FrameCapture(const std::string& directory, CaptureFormat format, unsigned every)
+    : directory_(directory), format_(format), every_(every > 0 ? every : 1) {
+    std::filesystem::create_directories(directory_);
+    free_.resize(CAPTURE_QUEUE_DEPTH + CAPTURE_WORKERS);
+    for (unsigned i = 0; i < CAPTURE_WORKERS; ++i) {
+        workers_.emplace_back(&FrameCapture::work, this);
+    }
+}
+
+FrameCapture::~FrameCapture() {
+    finish();
+}
+
+void FrameCapture::finish() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    ready_.notify_all();
+    for (auto& worker : workers_) worker.join();
+    workers_.clear();
+}
+
+void FrameCapture::capture(const sf::RenderWindow& window) {
+    if (paused || frame_counter_++ % every_ != 0) return;
+
+    std::vector<uint8_t> pixels;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (free_.empty()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        pixels = std::move(free_.back());
+        free_.pop_back();
+    }
+
+    // Copy the back buffer into a texture and read it back
+    sf::Vector2u size = window.getSize();
+    if (texture_.getSize() != size && !texture_.resize(size)) {
+        std::cerr << "Warning: Could not create capture texture" << std::endl;
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(pixels));
+        return;
+    }
+    texture_.update(window);
+    sf::Image image = texture_.copyToImage();
+    pixels.resize(static_cast<size_t>(size.x) * size.y * 4);
+    if (const uint8_t* data = image.getPixelsPtr()) {
+        std::memcpy(pixels.data(), data, pixels.size());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back({next_index_++, size, std::move(pixels)});
+    }
+    ready_.notify_one();
+}
+
+void FrameCapture::work() {
+    for (;;) {
+        Frame frame;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;  // Stopping and drained
+            frame = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        if (write(frame)) {
+            written_.fetch_add(1, std::memory_order_relaxed);
+        } else if (!failed_.exchange(true)) {
+            std::cerr << "Warning: Could not write capture frames to " << directory_ << std::endl;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(std::move(frame.pixels));  // Keeps its capacity for the next frame
+    }
+}
+
+bool FrameCapture::write(const Frame& frame) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%06llu.%s", static_cast<unsigned long long>(frame.index),
+                  format_ == CAPTURE_PNG ? "png" : "ppm");
+    std::string path = (std::filesystem::path(directory_) / name).string();
+
+    if (format_ == CAPTURE_PNG) {
+        sf::Image image(frame.size, frame.pixels.data());
+        return image.saveToFile(path);
+    }
+
+    // PPM has no alpha channel, so each row is packed down to RGB
+    std::ofstream out(path, std::ios::binary);
+    out << "P6\n" << frame.size.x << " " << frame.size.y << "\n255\n";
+    std::vector<char> row(static_cast<size_t>(frame.size.x) * 3);
+    for (unsigned y = 0; y < frame.size.y; ++y) {
+        const uint8_t* src = frame.pixels.data() + static_cast<size_t>(y) * frame.size.x * 4;
+        for (unsigned x = 0; x < frame.size.x; ++x) {
+            row[x * 3 + 0] = static_cast<char>(src[x * 4 + 0]);
+            row[x * 3 + 1] = static_cast<char>(src[x * 4 + 1]);
+            row[x * 3 + 2] = static_cast<char>(src[x * 4 + 2]);
+        }
+        out.write(row.data(), row.size());
+    }
+    return static_cast<bool>(out);
+}
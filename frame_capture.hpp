@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ============================================================================
+// FRAME CAPTURE - Window frames written to disk by background workers
+// ============================================================================
+
+enum CaptureFormat {
+    CAPTURE_PNG,
+    CAPTURE_PPM   // Uncompressed binary PPM (fast to write, readable by ffmpeg)
+};
+
+// The render thread only reads the frame back into one of a fixed pool of
+// pixel buffers and queues it; encoding and disk writes happen on worker
+// threads. When every buffer is in use the frame is dropped rather than
+// stalling the render loop. Files are numbered consecutively, so dropped
+// and skipped frames leave no gaps in the sequence.
+class FrameCapture {
+public:
+    // Capture every `every`-th frame into directory (created if missing)
+    FrameCapture(const std::string& directory, CaptureFormat format, unsigned every);
+    ~FrameCapture();
+
+    // Write out queued frames and join the workers
+    void finish();
+
+    // Call after the frame is drawn and before it is displayed
+    void capture(const sf::RenderWindow& window);
+
+    bool paused = false;
+
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    struct Frame {
+        uint64_t index;
+        sf::Vector2u size;
+        std::vector<uint8_t> pixels;  // RGBA, from the pool
+    };
+
+    std::string directory_;
+    CaptureFormat format_;
+    unsigned every_;
+    uint64_t frame_counter_ = 0;  // Frames offered, for the skip
+    uint64_t next_index_ = 0;     // Next file number
+    sf::Texture texture_;         // Readback target, reused
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::deque<Frame> queue_;
+    std::vector<std::vector<uint8_t>> free_;  // Pixel buffer pool
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> failed_{false};
+
+    void work();
+    bool write(const Frame& frame) const;
+};
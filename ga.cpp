@@ -0,0 +1,88 @@
+#include "ga.hpp"
+#include "simd_lanes.hpp"
+
+// ============================================================================
+// GENETIC OPERATORS IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+constexpr float TWO_PI = 6.28318530718f;
+constexpr float LN2 = 0.69314718056f;
+constexpr float UNIT = 1.0f / 16777216.0f;  // 2^-24
+
+// Natural log of positive normal floats: ln(m * 2^e) with m in [0.5, 1),
+// ln(m) = 2 atanh((m - 1) / (m + 1)) as an odd series (error below 1e-7)
+template <typename L>
+typename L::F log_lanes(typename L::F x) {
+    const auto one = L::splat(1.0f);
+    auto m = L::mantissa(x);
+    auto s = L::div(L::sub(m, one), L::add(m, one));
+    auto s2 = L::mul(s, s);
+    auto p = L::splat(1.0f / 11.0f);
+    p = L::add(L::mul(p, s2), L::splat(1.0f / 9.0f));
+    p = L::add(L::mul(p, s2), L::splat(1.0f / 7.0f));
+    p = L::add(L::mul(p, s2), L::splat(1.0f / 5.0f));
+    p = L::add(L::mul(p, s2), L::splat(1.0f / 3.0f));
+    p = L::add(L::mul(p, s2), one);
+    return L::add(L::mul(L::exponent(x), L::splat(LN2)), L::mul(L::splat(2.0f), L::mul(s, p)));
+}
+
+// Sine and cosine on [-pi, pi] as Taylor polynomials (error below 1e-6)
+template <typename L>
+void sincos_lanes(typename L::F x, typename L::F& sin_out, typename L::F& cos_out) {
+    auto x2 = L::mul(x, x);
+    auto s = L::splat(1.0f / 1307674368000.0f);    // 1/15!
+    s = L::sub(L::splat(1.0f / 6227020800.0f), L::mul(s, x2));
+    s = L::sub(L::splat(1.0f / 39916800.0f), L::mul(s, x2));
+    s = L::sub(L::splat(1.0f / 362880.0f), L::mul(s, x2));
+    s = L::sub(L::splat(1.0f / 5040.0f), L::mul(s, x2));
+    s = L::sub(L::splat(1.0f / 120.0f), L::mul(s, x2));
+    s = L::sub(L::splat(1.0f / 6.0f), L::mul(s, x2));
+    s = L::sub(L::splat(1.0f), L::mul(s, x2));
+    sin_out = L::mul(s, x);
+
+    auto c = L::splat(1.0f / 20922789888000.0f);   // 1/16!
+    c = L::sub(L::splat(1.0f / 87178291200.0f), L::mul(c, x2));
+    c = L::sub(L::splat(1.0f / 479001600.0f), L::mul(c, x2));
+    c = L::sub(L::splat(1.0f / 3628800.0f), L::mul(c, x2));
+    c = L::sub(L::splat(1.0f / 40320.0f), L::mul(c, x2));
+    c = L::sub(L::splat(1.0f / 720.0f), L::mul(c, x2));
+    c = L::sub(L::splat(1.0f / 24.0f), L::mul(c, x2));
+    c = L::sub(L::splat(1.0f / 2.0f), L::mul(c, x2));
+    cos_out = L::sub(L::splat(1.0f), L::mul(c, x2));
+}
+
+// Box-Muller: each pair of uniforms gives two independent normals, the
+// cosine half written to out and the sine half to out + pairs
+template <typename L>
+size_t box_muller_lanes(float* out, const int32_t* u1, const int32_t* u2, size_t pairs, size_t i) {
+    const auto unit = L::splat(UNIT);
+    const auto minus_two = L::splat(-2.0f);
+    const auto two_pi = L::splat(TWO_PI);
+    const auto pi = L::splat(TWO_PI / 2.0f);
+    for (; i + L::WIDTH <= pairs; i += L::WIDTH) {
+        auto radius = L::sqrt(L::mul(minus_two, log_lanes<L>(L::mul(L::load_int(u1 + i), unit))));
+        auto angle = L::sub(L::mul(L::mul(L::load_int(u2 + i), unit), two_pi), pi);
+        typename L::F s, c;
+        sincos_lanes<L>(angle, s, c);
+        L::store(out + i, L::mul(radius, c));
+        L::store(out + pairs + i, L::mul(radius, s));
+    }
+    return i;
+}
+
+} // namespace
+
+void gaussian_batch(float* out, size_t n, std::mt19937& rng, std::vector<int32_t>& scratch) {
+    // 24-bit uniforms, converted exactly to floats: u1 in (0, 1] so its log
+    // is finite, u2 in [0, 1) for the angle
+    size_t pairs = n / 2;
+    scratch.resize(2 * pairs);
+    for (size_t i = 0; i < pairs; ++i) {
+        scratch[i] = static_cast<int32_t>(rng() >> 8) + 1;
+        scratch[pairs + i] = static_cast<int32_t>(rng() >> 8);
+    }
+    size_t i = box_muller_lanes<WideLanes>(out, scratch.data(), scratch.data() + pairs, pairs, 0);
+    box_muller_lanes<ScalarLanes>(out, scratch.data(), scratch.data() + pairs, pairs, i);
+}
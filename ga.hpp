@@ -3,129 +3,212 @@
 #include <vector>
 #include <random>
 #include <algorithm>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <tuple>
+#include <type_traits>
+
+// Genome trait quantized to 16 bits over [MIN_MILLI, MAX_MILLI] / 1000. The
+// step count is even, so both range ends and the midpoint decode exactly.
+// Assigning a float clamps it to the range and rounds to the nearest step.
+template <int MIN_MILLI, int MAX_MILLI>
+struct Trait16 {
+    static constexpr float LOW = MIN_MILLI / 1000.0f;
+    static constexpr float HIGH = MAX_MILLI / 1000.0f;
+    static constexpr uint32_t STEPS = 65534;
+
+    uint16_t code;
+
+    constexpr Trait16(float value) : code(encode(value)) {}
+    Trait16& operator=(float value) { code = encode(value); return *this; }
+    constexpr operator float() const { return LOW + (HIGH - LOW) * code / STEPS; }
+
+    static constexpr uint16_t encode(float value) {
+        float t = (std::clamp(value, LOW, HIGH) - LOW) / (HIGH - LOW);
+        return static_cast<uint16_t>(t * STEPS + 0.5f);
+    }
+};
 
 struct HareGenome {
-    float reproduction_threshold = 1.5f;
-    float movement_aggression = 0.5f; // 0 = random movement, 1 = always seek plants
-    float weight = 1.0f; // 0.5 = light/fast, 1.5 = heavy/slow
-    float fear = 0.5f; // 0 = fearless (takes risks), 1 = fearful (avoids danger)
-    float movement_efficiency = 1.0f; // 0.5 = inefficient/high cost, 1.5 = efficient/low cost
+    Trait16<1000, 2000> reproduction_threshold = 1.5f;
+    Trait16<0, 1000> movement_aggression = 0.5f; // 0 = random movement, 1 = always seek plants
+    Trait16<500, 1500> weight = 1.0f; // 0.5 = light/fast, 1.5 = heavy/slow
+    Trait16<0, 1000> fear = 0.5f; // 0 = fearless (takes risks), 1 = fearful (avoids danger)
+    Trait16<500, 1500> movement_efficiency = 1.0f; // 0.5 = inefficient/high cost, 1.5 = efficient/low cost
     bool can_burrow = false; // Can burrow to hide
 
     HareGenome() = default;
     HareGenome(float thresh, float aggression, float w, float f) : reproduction_threshold(thresh), movement_aggression(aggression), weight(w), fear(f) {}
-
-    HareGenome mutate(std::mt19937& gen) const {
-        std::normal_distribution<float> dist(0.0f, 0.1f); // Small mutations
-        HareGenome child = *this;
-        child.reproduction_threshold += dist(gen);
-        child.reproduction_threshold = std::clamp(child.reproduction_threshold, 1.0f, 2.0f);
-        child.movement_aggression += dist(gen);
-        child.movement_aggression = std::clamp(child.movement_aggression, 0.0f, 1.0f);
-        child.weight += dist(gen);
-        child.weight = std::clamp(child.weight, 0.5f, 1.5f);
-        child.fear += dist(gen);
-        child.fear = std::clamp(child.fear, 0.0f, 1.0f);
-        child.movement_efficiency += dist(gen);
-        child.movement_efficiency = std::clamp(child.movement_efficiency, 0.5f, 1.5f);
-        // Burrow trait: rare mutation
-        if (std::uniform_real_distribution<float>(0.0f, 1.0f)(gen) < 0.01f) {
-            child.can_burrow = !child.can_burrow;
-        }
-        return child;
-    }
-
-    bool operator<(const HareGenome& other) const {
-        if (reproduction_threshold != other.reproduction_threshold) {
-            return reproduction_threshold < other.reproduction_threshold;
-        }
-        if (movement_aggression != other.movement_aggression) {
-            return movement_aggression < other.movement_aggression;
-        }
-        if (weight != other.weight) {
-            return weight < other.weight;
-        }
-        if (fear != other.fear) {
-            return fear < other.fear;
-        }
-        if (movement_efficiency != other.movement_efficiency) {
-            return movement_efficiency < other.movement_efficiency;
-        }
-        return can_burrow < other.can_burrow;
-    }
 };
 
 struct FoxGenome {
-    float reproduction_threshold = 4.0f;
-    float hunting_aggression = 0.5f; // 0 = passive, 1 = aggressive
-    float weight = 1.0f; // 0.5 = light/fast, 1.5 = heavy/slow
-    float movement_efficiency = 1.0f; // 0.5 = inefficient/high cost, 1.5 = efficient/low cost
+    Trait16<2000, 6000> reproduction_threshold = 4.0f;
+    Trait16<0, 1000> hunting_aggression = 0.5f; // 0 = passive, 1 = aggressive
+    Trait16<500, 1500> weight = 1.0f; // 0.5 = light/fast, 1.5 = heavy/slow
+    Trait16<500, 1500> movement_efficiency = 1.0f; // 0.5 = inefficient/high cost, 1.5 = efficient/low cost
 
     FoxGenome() = default;
     FoxGenome(float thresh, float aggression, float w, float eff) : reproduction_threshold(thresh), hunting_aggression(aggression), weight(w), movement_efficiency(eff) {}
-
-    FoxGenome mutate(std::mt19937& gen) const {
-        std::normal_distribution<float> dist(0.0f, 0.1f); // Small mutations
-        FoxGenome child = *this;
-        child.reproduction_threshold += dist(gen);
-        child.reproduction_threshold = std::min(std::max(child.reproduction_threshold, 2.0f), 6.0f);
-        child.hunting_aggression += dist(gen);
-        child.hunting_aggression = std::min(std::max(child.hunting_aggression, 0.0f), 1.0f);
-        child.weight += dist(gen);
-        child.weight = std::min(std::max(child.weight, 0.5f), 1.5f);
-        child.movement_efficiency += dist(gen);
-        child.movement_efficiency = std::min(std::max(child.movement_efficiency, 0.5f), 1.5f);
-        return child;
-    }
-
-    bool operator<(const FoxGenome& other) const {
-        if (reproduction_threshold != other.reproduction_threshold) {
-            return reproduction_threshold < other.reproduction_threshold;
-        }
-        if (hunting_aggression != other.hunting_aggression) {
-            return hunting_aggression < other.hunting_aggression;
-        }
-        if (weight != other.weight) {
-            return weight < other.weight;
-        }
-        return movement_efficiency < other.movement_efficiency;
-    }
 };
 
 struct WolfGenome {
-    float reproduction_threshold = 6.0f;
-    float hunting_aggression = 0.5f; // 0 = passive, 1 = aggressive
-    float weight = 1.0f; // 0.5 = light/fast, 1.5 = heavy/slow
-    float movement_efficiency = 1.0f; // 0.5 = inefficient/high cost, 1.5 = efficient/low cost
+    Trait16<5000, 7000> reproduction_threshold = 6.0f;
+    Trait16<0, 1000> hunting_aggression = 0.5f; // 0 = passive, 1 = aggressive
+    Trait16<500, 1500> weight = 1.0f; // 0.5 = light/fast, 1.5 = heavy/slow
+    Trait16<500, 1500> movement_efficiency = 1.0f; // 0.5 = inefficient/high cost, 1.5 = efficient/low cost
 
     WolfGenome() = default;
     WolfGenome(float thresh, float aggression, float w, float eff) : reproduction_threshold(thresh), hunting_aggression(aggression), weight(w), movement_efficiency(eff) {}
+};
 
-    WolfGenome mutate(std::mt19937& gen) const {
-        std::normal_distribution<float> dist(0.0f, 0.1f); // Small mutations
-        WolfGenome child = *this;
-        child.reproduction_threshold += dist(gen);
-        child.reproduction_threshold = std::clamp(child.reproduction_threshold, 5.0f, 7.0f);
-        child.hunting_aggression += dist(gen);
-        child.hunting_aggression = std::clamp(child.hunting_aggression, 0.0f, 1.0f);
-        child.weight += dist(gen);
-        child.weight = std::clamp(child.weight, 0.5f, 1.5f);
-        child.movement_efficiency += dist(gen);
-        child.movement_efficiency = std::clamp(child.movement_efficiency, 0.5f, 1.5f);
-        return child;
-    }
+// ============================================================================
+// GENOME LAYOUTS - Which fields mutate, and how
+// ============================================================================
 
-    bool operator<(const WolfGenome& other) const {
-        if (reproduction_threshold != other.reproduction_threshold) {
-            return reproduction_threshold < other.reproduction_threshold;
-        }
-        if (hunting_aggression != other.hunting_aggression) {
-            return hunting_aggression < other.hunting_aggression;
+// A quantized trait (its range comes from the Trait16 type) and the standard
+// deviation of its mutation step
+template <typename Genome, typename Trait>
+struct Gene {
+    Trait Genome::*field;
+    float sigma;
+};
+
+// An on/off trait and its chance of flipping per birth
+template <typename Genome>
+struct Flag {
+    bool Genome::*field;
+    float flip_chance;
+};
+
+template <typename Genome, typename Trait>
+constexpr Gene<Genome, Trait> gene(Trait Genome::*field, float sigma) { return {field, sigma}; }
+
+template <typename Genome>
+constexpr Flag<Genome> flag(bool Genome::*field, float flip_chance) { return {field, flip_chance}; }
+
+// One specialization per genome lists its genes and flags; mutation,
+// crossover and ordering are generic over the table, so a new trait is a
+// field plus a row here
+template <typename Genome>
+struct GenomeLayout;
+
+template <>
+struct GenomeLayout<HareGenome> {
+    static constexpr auto genes = std::make_tuple(
+        gene(&HareGenome::reproduction_threshold, 0.1f),
+        gene(&HareGenome::movement_aggression, 0.1f),
+        gene(&HareGenome::weight, 0.1f),
+        gene(&HareGenome::fear, 0.1f),
+        gene(&HareGenome::movement_efficiency, 0.1f));
+    static constexpr auto flags = std::make_tuple(
+        flag(&HareGenome::can_burrow, 0.01f));  // Rare
+};
+
+template <>
+struct GenomeLayout<FoxGenome> {
+    static constexpr auto genes = std::make_tuple(
+        gene(&FoxGenome::reproduction_threshold, 0.1f),
+        gene(&FoxGenome::hunting_aggression, 0.1f),
+        gene(&FoxGenome::weight, 0.1f),
+        gene(&FoxGenome::movement_efficiency, 0.1f));
+    static constexpr auto flags = std::make_tuple();
+};
+
+template <>
+struct GenomeLayout<WolfGenome> {
+    static constexpr auto genes = std::make_tuple(
+        gene(&WolfGenome::reproduction_threshold, 0.1f),
+        gene(&WolfGenome::hunting_aggression, 0.1f),
+        gene(&WolfGenome::weight, 0.1f),
+        gene(&WolfGenome::movement_efficiency, 0.1f));
+    static constexpr auto flags = std::make_tuple();
+};
+
+// ============================================================================
+// GENETIC OPERATORS
+// ============================================================================
+
+// Fill out with n (even) standard normal samples; the uniforms come from
+// rng in order, the transforms run vectorized
+void gaussian_batch(float* out, size_t n, std::mt19937& rng, std::vector<int32_t>& scratch);
+
+// Reused buffers for mutate_genomes
+struct MutationScratch {
+    std::vector<float> noise;
+    std::vector<int32_t> bits;
+};
+
+// Mutate count genomes in place, genome(i) giving the i-th: every gene
+// takes a normal step of its sigma (clamped to its range) and every flag
+// flips with its chance. All steps are drawn in one batch.
+template <typename GenomeAt>
+void mutate_genomes(size_t count, GenomeAt genome, std::mt19937& rng, MutationScratch& scratch) {
+    using Genome = std::remove_reference_t<decltype(genome(0))>;
+    using Layout = GenomeLayout<Genome>;
+    constexpr size_t GENES = std::tuple_size_v<decltype(Layout::genes)>;
+    if (count == 0) return;
+
+    scratch.noise.resize((count * GENES + 1) & ~size_t(1));
+    gaussian_batch(scratch.noise.data(), scratch.noise.size(), rng, scratch.bits);
+
+    const float* noise = scratch.noise.data();
+    auto mutate_gene = [&](const auto& g) {
+        for (size_t i = 0; i < count; ++i) {
+            auto& trait = genome(i).*g.field;
+            trait = trait + g.sigma * noise[i];  // Trait16 clamps to its range
         }
-        if (weight != other.weight) {
-            return weight < other.weight;
+        noise += count;
+    };
+    std::apply([&](const auto&... g) { (mutate_gene(g), ...); }, Layout::genes);
+
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+    auto mutate_flag = [&](const auto& f) {
+        for (size_t i = 0; i < count; ++i) {
+            if (chance(rng) < f.flip_chance) genome(i).*f.field = !(genome(i).*f.field);
         }
-        return movement_efficiency < other.movement_efficiency;
-    }
-};
+    };
+    std::apply([&](const auto&... f) { (mutate_flag(f), ...); }, Layout::flags);
+}
+
+// Uniform crossover: every gene and flag comes from either parent at random
+template <typename Genome>
+Genome crossover(const Genome& a, const Genome& b, std::mt19937& rng) {
+    Genome child = a;
+    uint32_t picks = rng();
+    std::apply([&](const auto&... g) {
+        ((child.*g.field = (picks & 1) ? b.*g.field : a.*g.field, picks >>= 1), ...);
+    }, GenomeLayout<Genome>::genes);
+    std::apply([&](const auto&... f) {
+        ((child.*f.field = (picks & 1) ? b.*f.field : a.*f.field, picks >>= 1), ...);
+    }, GenomeLayout<Genome>::flags);
+    return child;
+}
+
+// Make a genome copied in from raw bytes valid: trait codes past the last
+// step are clamped to it and flags become exactly false or true. The flag
+// bytes are read as bytes, since reading any other value as a bool is undefined.
+template <typename Genome>
+void sanitize_genome(Genome& genome) {
+    auto clamp_gene = [&](auto& trait) {
+        trait.code = static_cast<uint16_t>(std::min<uint32_t>(trait.code, std::remove_reference_t<decltype(trait)>::STEPS));
+    };
+    std::apply([&](const auto&... g) { (clamp_gene(genome.*g.field), ...); }, GenomeLayout<Genome>::genes);
+    auto sanitize_flag = [&](bool& flag) {
+        unsigned char byte;
+        std::memcpy(&byte, &flag, 1);
+        flag = byte != 0;
+    };
+    std::apply([&](const auto&... f) { (sanitize_flag(genome.*f.field), ...); }, GenomeLayout<Genome>::flags);
+}
+
+// Lexicographic order over the genes, then the flags, in table order
+template <typename Genome, typename = decltype(GenomeLayout<Genome>::genes)>
+bool operator<(const Genome& a, const Genome& b) {
+    auto key = [](const Genome& g) {
+        return std::tuple_cat(
+            std::apply([&](const auto&... gn) { return std::make_tuple(static_cast<float>(g.*gn.field)...); }, GenomeLayout<Genome>::genes),
+            std::apply([&](const auto&... fl) { return std::make_tuple(g.*fl.field...); }, GenomeLayout<Genome>::flags));
+    };
+    return key(a) < key(b);
+}
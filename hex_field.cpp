@@ -0,0 +1,76 @@
+#include "hex_field.hpp"
+#include "hex_math.hpp"
+#include "simd_lanes.hpp"
+#include <algorithm>
+
+// ============================================================================
+// HEX FIELD IMPLEMENTATION
+// ============================================================================
+
+void HexField::resize(int radius) {
+    radius_ = radius;
+    stride_ = static_cast<size_t>(2 * radius + 3);
+    values_.assign(stride_ * stride_, 0.0f);
+    scratch_.assign(stride_ * stride_, 0.0f);
+}
+
+void HexField::assign(const float* values) {
+    std::copy(values, values + values_.size(), values_.begin());
+}
+
+void HexField::fill(float value) {
+    // Only the tiles; the border stays zero
+    for (size_t row = 1; row + 1 < stride_; ++row) {
+        std::fill(values_.begin() + row * stride_ + 1, values_.begin() + (row + 1) * stride_ - 1, value);
+    }
+}
+
+void HexField::add_ring(int q, int r, float amount) {
+    for (const auto& [dq, dr] : HEX_DIRECTIONS) {
+        add(q + dq, r + dr, amount);
+    }
+}
+
+namespace {
+
+// Axial neighbour directions as index offsets (q steps a row, r a column)
+struct Neighbors {
+    ptrdiff_t o[6];
+    explicit Neighbors(size_t stride) {
+        for (int dir = 0; dir < 6; ++dir) {
+            o[dir] = HEX_DIRECTIONS[dir].first * static_cast<ptrdiff_t>(stride) + HEX_DIRECTIONS[dir].second;
+        }
+    }
+};
+
+template <typename L>
+size_t diffuse_lanes(float* out, const float* src, const float* open, const Neighbors& n,
+                     float exchange, float keep, size_t i, size_t end) {
+    const auto k_exchange = L::splat(exchange);
+    const auto k_keep = L::splat(keep);
+    for (; i + L::WIDTH <= end; i += L::WIDTH) {
+        auto v = L::load(src + i);
+        auto flux = L::splat(0.0f);
+        for (int d = 0; d < 6; ++d) {
+            auto gate = L::load(open + i + n.o[d]);
+            flux = L::add(flux, L::mul(gate, L::sub(L::load(src + i + n.o[d]), v)));
+        }
+        auto moved = L::mul(L::mul(L::load(open + i), k_exchange), flux);
+        L::store(out + i, L::mul(L::add(v, moved), k_keep));
+    }
+    return i;
+}
+
+} // namespace
+
+void HexField::diffuse(const HexField& open, float rate, float decay, float dt) {
+    Neighbors n(stride_);
+    float exchange = rate * dt;
+    float keep = 1.0f - decay * dt;
+    for (size_t row = 1; row + 1 < stride_; ++row) {
+        size_t begin = row * stride_ + 1, end = (row + 1) * stride_ - 1;
+        size_t i = diffuse_lanes<WideLanes>(scratch_.data(), values_.data(), open.values_.data(), n, exchange, keep, begin, end);
+        diffuse_lanes<ScalarLanes>(scratch_.data(), values_.data(), open.values_.data(), n, exchange, keep, i, end);
+    }
+    values_.swap(scratch_);  // Borders are zero in both buffers
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <vector>
+
+// ============================================================================
+// HEX FIELD - Dense per-tile scalar field over the hexagonal grid
+// ============================================================================
+
+// Tiles within `radius` of the origin live in a (2 * radius + 3)^2 row-major
+// array indexed by axial (q, r), with an always-zero border cell on every
+// side. A tile's six neighbours are then at fixed index offsets, so stencils
+// sweep contiguous rows without bounds checks and vectorize directly. Cells
+// of the rhombus outside the hexagonal grid are simply left at zero.
+class HexField {
+public:
+    // Reallocate for a grid of the given radius, zero-filled
+    void resize(int radius);
+
+    int radius() const { return radius_; }
+    size_t size() const { return values_.size(); }  // Cells, including the border
+    bool contains(int q, int r) const { return std::abs(q) <= radius_ && std::abs(r) <= radius_; }
+    size_t index(int q, int r) const { return static_cast<size_t>(q + radius_ + 1) * stride_ + (r + radius_ + 1); }
+    size_t stride() const { return stride_; }  // Cells per row (one q)
+    const float* data() const { return values_.data(); }
+
+    // Zero outside the field
+    float get(int q, int r) const { return contains(q, r) ? values_[index(q, r)] : 0.0f; }
+    void set(int q, int r, float value) { if (contains(q, r)) values_[index(q, r)] = value; }
+
+    // Scatter-accumulate, e.g. one per agent standing on the tile
+    void add(int q, int r, float amount) { if (contains(q, r)) values_[index(q, r)] += amount; }
+
+    // Scatter-accumulate onto the six tiles around (q, r), so a read at any
+    // tile sees the total over its neighbours
+    void add_ring(int q, int r, float amount);
+
+    void fill(float value);
+
+    // Copy size() values laid out as above, e.g. from a map file
+    void assign(const float* values);
+
+    // One explicit diffusion step with a 7-point stencil: each tile exchanges
+    // rate * dt of its difference with every neighbour, only between tiles
+    // where open is 1, then everything decays by decay * dt. Exchange is
+    // symmetric, so without decay the total over open tiles is conserved.
+    // Stable while 6 * rate * dt <= 1.
+    void diffuse(const HexField& open, float rate, float decay, float dt);
+
+private:
+    int radius_ = -1;
+    size_t stride_ = 0;
+    std::vector<float> values_;
+    std::vector<float> scratch_;  // Second buffer for diffusion, swapped in
+};
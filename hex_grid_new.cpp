@@ -22,17 +22,17 @@
 // HEX GRID CLASS IMPLEMENTATION
 // ============================================================================
 
-std::pair<float, float> HexGrid::axial_to_pixel(int q, int r) const {
-    // Convert axial coordinates to pixel position for flat-top hexagons
-    const float sqrt3 = SQRT3;
-    float x = hex_size * (3.0f/2.0f * q);
-    float y = hex_size * (sqrt3/2.0f * q + sqrt3 * r);
-    return {x, y};
+float base_nutrients(TerrainType type) {
+    switch (type) {
+        case SOIL: return 0.8f;
+        case WATER: return 0.5f;
+        case ROCK: return 0.2f;
+    }
+    return 0.0f;
 }
 
 void HexGrid::add_hexagon(int q, int r) {
-    int dist = (std::abs(q) + std::abs(r) + std::abs(q + r)) / 2;
-    if (dist > max_grid_distance) return;
+    if (hex_distance(q, r) > max_grid_distance) return;
     if (!has_hexagon(q, r)) {
         auto [x, y] = axial_to_pixel(q, r);
         hexagons[{q, r}] = {x, y};
@@ -44,7 +44,7 @@ void HexGrid::add_hexagon(int q, int r) {
         // Count neighbor types
         std::map<TerrainType, int> neighbor_counts;
         for (int dir = 0; dir < 6; ++dir) {
-            auto [nq, nr] = get_neighbor_coords(q, r, dir);
+            auto [nq, nr] = hex_neighbor(q, r, dir);
             if (has_hexagon(nq, nr)) {
                 auto it = terrainTiles.find({nq, nr});
                 if (it != terrainTiles.end()) {
@@ -93,19 +93,15 @@ void HexGrid::add_hexagon(int q, int r) {
         }
 
         // Assign nutrients based on type
-        float base_nutrients;
-        switch (type) {
-            case SOIL: base_nutrients = 0.8f; break;
-            case WATER: base_nutrients = 0.5f; break;
-            case ROCK: base_nutrients = 0.2f; break;
-        }
-        float nutrients = std::clamp(base_nutrients + static_cast<float>(nutrient_var(gen)), 0.0f, 1.0f);
+        float tile_nutrients = std::clamp(base_nutrients(type) + static_cast<float>(nutrient_var(gen)), 0.0f, 1.0f);
 
-        terrainTiles.insert({{q, r}, TerrainTile(q, r, type, nutrients)});
+        terrainTiles.insert({{q, r}, TerrainTile(q, r, type)});
+        if (nutrients.radius() != max_grid_distance) nutrients.resize(max_grid_distance);
+        nutrients.set(q, r, tile_nutrients);
 
         // Spawn plant on soil with chance
         if (type == SOIL && (gen() % 100) < 10) { // 10% chance
-            plants.insert({{q, r}, Plant(q, r, SEED, nutrients)});
+            plants.insert({{q, r}, Plant(q, r, SEED, tile_nutrients)});
         }
     }
 }
@@ -123,7 +119,7 @@ void HexGrid::create_neighbors() {
 
         // Check each of the 6 neighbor directions
         for (int dir = 0; dir < 6; ++dir) {
-            auto [nq, nr] = get_neighbor_coords(q, r, dir);
+            auto [nq, nr] = hex_neighbor(q, r, dir);
             if (!has_hexagon(nq, nr)) {
                 new_hexagons.push_back({nq, nr});
             }
@@ -144,373 +140,386 @@ void HexGrid::expand_grid(int layers) {
 
 void HexGrid::draw(SFMLRenderer& renderer, uint8_t r, uint8_t g, uint8_t b,
                    uint8_t outline_r, uint8_t outline_g, uint8_t outline_b,
-                   float offset_x, float offset_y, int screen_width, int screen_height,
+                   float offset_x, float offset_y, const ViewRect& view, DetailLevel detail,
                    float brightness_center_q, float brightness_center_r,
                    bool has_alive_hares) const {
-    const float sqrt3 = SQRT3;
-    for (const auto& [coords, pos] : hexagons) {
-        auto [q, r_coord] = coords;
-        auto [x, y] = pos;
-        float cx = x + offset_x;
-        float cy = y + offset_y;
-        float left = cx - hex_size;
-        float right = cx + hex_size;
-        float top = cy - hex_size * sqrt3 / 2.0f;
-        float bottom = cy + hex_size * sqrt3 / 2.0f;
-        if (left >= 0 && right <= screen_width && top >= 0 && bottom <= screen_height) {
-            // Get terrain type and base colors
-            TerrainType type = SOIL;
-            auto it = terrainTiles.find({q, r_coord});
-            if (it != terrainTiles.end()) type = it->second.type;
-
-            uint8_t base_r, base_g, base_b;
-            switch (type) {
-                case SOIL: base_r = 139; base_g = 69; base_b = 19; break; // Brown
-                case WATER: base_r = 0; base_g = 150; base_b = 255; break; // Brighter Blue
-                case ROCK: base_r = 128; base_g = 128; base_b = 128; break; // Gray
-            }
+    // Zoomed out: batch untextured hexes into a single vertex array
+    if (detail != DETAIL_FULL) {
+        draw_batched(renderer, offset_x, offset_y, view, detail,
+                     brightness_center_q, brightness_center_r, has_alive_hares);
+        return;
+    }
 
-            // Calculate distance for brightness adjustment from brightness center
-            float factor;
-            if (!has_alive_hares) {
-                factor = 0.5f;  // Dim whole map if no alive hares
-            } else {
-                float dist = std::max({std::abs(q - brightness_center_q), std::abs(r_coord - brightness_center_r), std::abs((q - brightness_center_q) + (r_coord - brightness_center_r))});
-                factor = 1.0f - std::min(dist / 15.0f, 1.0f) * 0.5f;
-            }
-            uint8_t br = (uint8_t)(base_r * factor);
-            uint8_t bg = (uint8_t)(base_g * factor);
-            uint8_t bb = (uint8_t)(base_b * factor);
+    // Full detail, one tile after another (the viewer builds these in parallel)
+    sf::RenderWindow* window = renderer.getWindow();
+    if (!window) return;
+    terrain_vertices.clear();
+    terrain_vertices.pixel_scale = window->getSize().x / window->getView().getSize().x;
+    for_each_in_rect(view, [&](int q, int r_coord, float x, float y) {
+        append_tile(terrain_vertices, renderer, q, r_coord, x + offset_x, y + offset_y,
+                    brightness_center_q, brightness_center_r, has_alive_hares);
+    });
+    terrain_vertices.draw(*window);
+}
 
-            // Add to terrain vertex array (main fill)
-            for (int i = 0; i < 6; ++i) {
-                sf::Vector2f center(cx, cy);
-                sf::Vector2f p1 = center + hexagon_points[i] * hex_size;
-                sf::Vector2f p2 = center + hexagon_points[(i + 1) % 6] * hex_size;
-                float variation = (i % 3) * 10.0f - 10.0f;
-                uint8_t tr = std::clamp((int)br + (int)variation, 0, 255);
-                uint8_t tg = std::clamp((int)bg + (int)variation, 0, 255);
-                uint8_t tb = std::clamp((int)bb + (int)variation, 0, 255);
-                // Note: terrain_vertices is passed by reference or global, but since const, need to modify draw signature
-                // For now, keep individual draws but optimized
-            }
+void HexGrid::append_tile(VertexBatch& out, const SFMLRenderer& renderer, int q, int r_coord, float cx, float cy,
+                          float brightness_center_q, float brightness_center_r, bool has_alive_hares) const {
+    TileShade shade = shade_tile(q, r_coord, brightness_center_q, brightness_center_r, has_alive_hares);
+    TerrainType type = shade.type;
+    uint8_t base_r = shade.base_r, base_g = shade.base_g, base_b = shade.base_b;
+    uint8_t br = shade.r, bg = shade.g, bb = shade.b;
+
+    // Keep shadows as before for now
+    HexPoints shadow_points = renderer.calculateHexagonPoints(cx + 3, cy + 3, hex_size);
+    out.convex(shadow_points.data(), shadow_points.size(), sf::Color(0, 0, 0, 100));
+
+    // Draw filled hexagon as pizza slices
+    HexPoints points = renderer.calculateHexagonPoints(cx, cy, hex_size);
+    const sf::Vector2f center(cx, cy);
+    for (int i = 0; i < 6; ++i) {
+        sf::Vector2f triangle[3] = {center, points[i], points[(i + 1) % 6]};
+        float variation = (i % 3) * 10.0f - 10.0f;
+        uint8_t tr = std::clamp((int)br + (int)variation, 0, 255);
+        uint8_t tg = std::clamp((int)bg + (int)variation, 0, 255);
+        uint8_t tb = std::clamp((int)bb + (int)variation, 0, 255);
+        out.convex(triangle, 3, sf::Color(tr, tg, tb));
+    }
 
-            // Keep shadows as before for now
-            auto shadow_points = renderer.calculateHexagonPoints(cx + 3, cy + 3, hex_size);
-            std::vector<std::pair<float, float>> shadow_point_pairs;
-            for (auto& p : shadow_points) shadow_point_pairs.emplace_back(p.x, p.y);
-            renderer.drawConvexShape(shadow_point_pairs, 0, 0, 0, 100);
+    // Shine and shadow triangles
+    uint8_t sr = std::min(255, (int)(br + 80));
+    uint8_t sg = std::min(255, (int)(bg + 80));
+    uint8_t sb = std::min(255, (int)(bb + 80));
+    uint8_t shr = (uint8_t)(br * 0.3f);
+    uint8_t shg = (uint8_t)(bg * 0.3f);
+    uint8_t shb = (uint8_t)(bb * 0.3f);
+
+    sf::Vector2f shine1[3] = {center, points[0], points[1]};
+    out.convex(shine1, 3, sf::Color(sr, sg, sb));
+
+    sf::Vector2f shine2[3] = {center, points[1], points[2]};
+    out.convex(shine2, 3, sf::Color(sr, sg, sb));
+
+    sf::Vector2f shadow1[3] = {center, points[3], points[4]};
+    out.convex(shadow1, 3, sf::Color(shr, shg, shb));
+
+    sf::Vector2f shadow2[3] = {center, points[4], points[5]};
+    out.convex(shadow2, 3, sf::Color(shr, shg, shb));
+
+    // Add wavy texture for water
+    if (type == WATER) {
+        std::mt19937 wave_gen(q * 1000 + r_coord);
+        std::uniform_real_distribution<float> offset_dist(-hex_size * 0.5f, hex_size * 0.5f);
+        std::uniform_real_distribution<float> size_dist(0.6f, 1.4f);
+
+        int num_back_waves = 15; // Background subtle waves
+        int num_front_waves = 12; // Foreground lighter waves
+        float wave_radius = hex_size * 0.35f;
+
+        // Draw background subtle waves with base colors (darker, more diffused)
+        for (int i = 0; i < num_back_waves; ++i) {
+            float offset_x = offset_dist(wave_gen);
+            float offset_y = offset_dist(wave_gen);
+            float size_mult = size_dist(wave_gen);
+            float radius = wave_radius * size_mult;
+
+            // Slightly darker than base for subtle depth
+            int color_var = (wave_gen() % 20) - 10;
+            uint8_t wave_r = std::clamp((int)(br * 0.8f) + color_var, 0, 255);
+            uint8_t wave_g = std::clamp((int)(bg * 0.8f) + color_var, 0, 255);
+            uint8_t wave_b = std::clamp((int)(bb * 0.9f) + color_var, 0, 255);
+            uint8_t alpha = 40 + (wave_gen() % 60); // Very diffused
+
+            out.circle(sf::Vector2f(cx + offset_x, cy + offset_y), radius, sf::Color(wave_r, wave_g, wave_b, alpha));
+        }
 
-            // Draw filled hexagon as pizza slices
-            auto points = renderer.calculateHexagonPoints(cx, cy, hex_size);
-            for (int i = 0; i < 6; ++i) {
-                sf::ConvexShape triangle(3);
-                triangle.setPoint(0, sf::Vector2f(cx, cy));
-                triangle.setPoint(1, points[i]);
-                triangle.setPoint(2, points[(i + 1) % 6]);
-                float variation = (i % 3) * 10.0f - 10.0f;
-                uint8_t tr = std::clamp((int)br + (int)variation, 0, 255);
-                uint8_t tg = std::clamp((int)bg + (int)variation, 0, 255);
-                uint8_t tb = std::clamp((int)bb + (int)variation, 0, 255);
-                triangle.setFillColor(sf::Color(tr, tg, tb));
-                renderer.getWindow()->draw(triangle);
-            }
+        // Draw foreground lighter waves for highlights
+        for (int i = 0; i < num_front_waves; ++i) {
+            float offset_x = offset_dist(wave_gen);
+            float offset_y = offset_dist(wave_gen);
+            float size_mult = size_dist(wave_gen);
+            float radius = wave_radius * size_mult * 0.8f; // Slightly smaller
+
+            // Lighter blue variants for wave highlights
+            int color_var = (wave_gen() % 40) - 10;
+            uint8_t wave_r = std::clamp((int)br + color_var, 0, 255);
+            uint8_t wave_g = std::clamp((int)bg + color_var, 0, 255);
+            uint8_t wave_b = std::clamp((int)bb + color_var + 20, 0, 255); // More blue
+            uint8_t alpha = 60 + (wave_gen() % 80); // More diffused
+
+            out.circle(sf::Vector2f(cx + offset_x, cy + offset_y), radius, sf::Color(wave_r, wave_g, wave_b, alpha));
+        }
+    }
 
-            // Shine and shadow triangles
-            uint8_t sr = std::min(255, (int)(br + 80));
-            uint8_t sg = std::min(255, (int)(bg + 80));
-            uint8_t sb = std::min(255, (int)(bb + 80));
-            uint8_t shr = (uint8_t)(br * 0.3f);
-            uint8_t shg = (uint8_t)(bg * 0.3f);
-            uint8_t shb = (uint8_t)(bb * 0.3f);
-
-            sf::ConvexShape shine1(3);
-            shine1.setPoint(0, sf::Vector2f(cx, cy));
-            shine1.setPoint(1, points[0]);
-            shine1.setPoint(2, points[1]);
-            shine1.setFillColor(sf::Color(sr, sg, sb));
-            renderer.getWindow()->draw(shine1);
-
-            sf::ConvexShape shine2(3);
-            shine2.setPoint(0, sf::Vector2f(cx, cy));
-            shine2.setPoint(1, points[1]);
-            shine2.setPoint(2, points[2]);
-            shine2.setFillColor(sf::Color(sr, sg, sb));
-            renderer.getWindow()->draw(shine2);
-
-            sf::ConvexShape shadow1(3);
-            shadow1.setPoint(0, sf::Vector2f(cx, cy));
-            shadow1.setPoint(1, points[3]);
-            shadow1.setPoint(2, points[4]);
-            shadow1.setFillColor(sf::Color(shr, shg, shb));
-            renderer.getWindow()->draw(shadow1);
-
-            sf::ConvexShape shadow2(3);
-            shadow2.setPoint(0, sf::Vector2f(cx, cy));
-            shadow2.setPoint(1, points[4]);
-            shadow2.setPoint(2, points[5]);
-            shadow2.setFillColor(sf::Color(shr, shg, shb));
-            renderer.getWindow()->draw(shadow2);
-
-            // Add wavy texture for water
-            if (type == WATER) {
-                std::mt19937 wave_gen(q * 1000 + r_coord);
-                std::uniform_real_distribution<float> offset_dist(-hex_size * 0.5f, hex_size * 0.5f);
-                std::uniform_real_distribution<float> size_dist(0.6f, 1.4f);
-
-                int num_back_waves = 15; // Background subtle waves
-                int num_front_waves = 12; // Foreground lighter waves
-                float wave_radius = hex_size * 0.35f;
-
-                // Draw background subtle waves with base colors (darker, more diffused)
-                for (int i = 0; i < num_back_waves; ++i) {
-                    float offset_x = offset_dist(wave_gen);
-                    float offset_y = offset_dist(wave_gen);
-                    float size_mult = size_dist(wave_gen);
-                    float radius = wave_radius * size_mult;
-
-                    // Slightly darker than base for subtle depth
-                    int color_var = (wave_gen() % 20) - 10;
-                    uint8_t wave_r = std::clamp((int)(br * 0.8f) + color_var, 0, 255);
-                    uint8_t wave_g = std::clamp((int)(bg * 0.8f) + color_var, 0, 255);
-                    uint8_t wave_b = std::clamp((int)(bb * 0.9f) + color_var, 0, 255);
-                    uint8_t alpha = 40 + (wave_gen() % 60); // Very diffused
-
-                    renderer.drawCircle(cx + offset_x, cy + offset_y, radius, wave_r, wave_g, wave_b, alpha);
-                }
+    // Add earthy texture for soil
+    if (type == SOIL) {
+        std::mt19937 soil_gen(q * 1000 + r_coord);
+        std::uniform_real_distribution<float> offset_dist(-hex_size * 0.5f, hex_size * 0.5f);
+        std::uniform_real_distribution<float> size_dist(0.5f, 1.5f);
+
+        int num_dark_patches = 18; // Dark soil patches
+        int num_light_patches = 10; // Lighter dirt spots
+        float patch_radius = hex_size * 0.3f;
+
+        // Draw dark patches using shadow colors for depth
+        for (int i = 0; i < num_dark_patches; ++i) {
+            float offset_x = offset_dist(soil_gen);
+            float offset_y = offset_dist(soil_gen);
+            float size_mult = size_dist(soil_gen);
+            float radius = patch_radius * size_mult;
+
+            // Use shadow colors for darker soil patches
+            int color_var = (soil_gen() % 30) - 15;
+            uint8_t patch_r = std::clamp((int)shr + color_var, 0, 255);
+            uint8_t patch_g = std::clamp((int)shg + color_var, 0, 255);
+            uint8_t patch_b = std::clamp((int)shb + color_var, 0, 255);
+            uint8_t alpha = 80 + (soil_gen() % 100); // Semi-transparent
+
+            out.circle(sf::Vector2f(cx + offset_x, cy + offset_y), radius, sf::Color(patch_r, patch_g, patch_b, alpha));
+        }
 
-                // Draw foreground lighter waves for highlights
-                for (int i = 0; i < num_front_waves; ++i) {
-                    float offset_x = offset_dist(wave_gen);
-                    float offset_y = offset_dist(wave_gen);
-                    float size_mult = size_dist(wave_gen);
-                    float radius = wave_radius * size_mult * 0.8f; // Slightly smaller
-
-                    // Lighter blue variants for wave highlights
-                    int color_var = (wave_gen() % 40) - 10;
-                    uint8_t wave_r = std::clamp((int)br + color_var, 0, 255);
-                    uint8_t wave_g = std::clamp((int)bg + color_var, 0, 255);
-                    uint8_t wave_b = std::clamp((int)bb + color_var + 20, 0, 255); // More blue
-                    uint8_t alpha = 60 + (wave_gen() % 80); // More diffused
-
-                    renderer.drawCircle(cx + offset_x, cy + offset_y, radius, wave_r, wave_g, wave_b, alpha);
-                }
-            }
+        // Draw lighter patches for variation
+        for (int i = 0; i < num_light_patches; ++i) {
+            float offset_x = offset_dist(soil_gen);
+            float offset_y = offset_dist(soil_gen);
+            float size_mult = size_dist(soil_gen);
+            float radius = patch_radius * size_mult * 0.7f; // Smaller
+
+            // Lighter brown variants
+            int color_var = (soil_gen() % 30);
+            uint8_t patch_r = std::clamp((int)br + color_var, 0, 255);
+            uint8_t patch_g = std::clamp((int)bg + color_var, 0, 255);
+            uint8_t patch_b = std::clamp((int)bb + color_var, 0, 255);
+            uint8_t alpha = 50 + (soil_gen() % 80); // More diffused
+
+            out.circle(sf::Vector2f(cx + offset_x, cy + offset_y), radius, sf::Color(patch_r, patch_g, patch_b, alpha));
+        }
+    }
 
-            // Add earthy texture for soil
-            if (type == SOIL) {
-                std::mt19937 soil_gen(q * 1000 + r_coord);
-                std::uniform_real_distribution<float> offset_dist(-hex_size * 0.5f, hex_size * 0.5f);
-                std::uniform_real_distribution<float> size_dist(0.5f, 1.5f);
-
-                int num_dark_patches = 18; // Dark soil patches
-                int num_light_patches = 10; // Lighter dirt spots
-                float patch_radius = hex_size * 0.3f;
-
-                // Draw dark patches using shadow colors for depth
-                for (int i = 0; i < num_dark_patches; ++i) {
-                    float offset_x = offset_dist(soil_gen);
-                    float offset_y = offset_dist(soil_gen);
-                    float size_mult = size_dist(soil_gen);
-                    float radius = patch_radius * size_mult;
-
-                    // Use shadow colors for darker soil patches
-                    int color_var = (soil_gen() % 30) - 15;
-                    uint8_t patch_r = std::clamp((int)shr + color_var, 0, 255);
-                    uint8_t patch_g = std::clamp((int)shg + color_var, 0, 255);
-                    uint8_t patch_b = std::clamp((int)shb + color_var, 0, 255);
-                    uint8_t alpha = 80 + (soil_gen() % 100); // Semi-transparent
-
-                    renderer.drawCircle(cx + offset_x, cy + offset_y, radius, patch_r, patch_g, patch_b, alpha);
-                }
+    // Add rocky, jagged texture for rocks
+    if (type == ROCK) {
+        std::mt19937 rock_gen(q * 1000 + r_coord);
+        std::uniform_real_distribution<float> offset_dist(-hex_size * 0.5f, hex_size * 0.5f);
+        std::uniform_real_distribution<float> length_dist(hex_size * 0.1f, hex_size * 0.4f);
+        std::uniform_real_distribution<float> angle_dist(0.0f, 6.28318f); // 0 to 2*PI
+
+        int num_dark_lines = 20; // Dark cracks/lines
+        int num_light_lines = 12; // Light edge highlights
+        int num_dots = 25; // Small rocky dots
+
+        // Draw dark jagged lines for cracks and depth
+        for (int i = 0; i < num_dark_lines; ++i) {
+            float x1 = cx + offset_dist(rock_gen);
+            float y1 = cy + offset_dist(rock_gen);
+            float length = length_dist(rock_gen);
+            float angle = angle_dist(rock_gen);
+            float x2 = x1 + length * std::cos(angle);
+            float y2 = y1 + length * std::sin(angle);
+
+            // Dark lines using shadow colors
+            int color_var = (rock_gen() % 20) - 10;
+            uint8_t line_r = std::clamp((int)shr + color_var, 0, 255);
+            uint8_t line_g = std::clamp((int)shg + color_var, 0, 255);
+            uint8_t line_b = std::clamp((int)shb + color_var, 0, 255);
+            uint8_t alpha = 120 + (rock_gen() % 100);
+
+            out.line(sf::Vector2f(x1, y1), sf::Vector2f(x2, y2), 1.5f, sf::Color(line_r, line_g, line_b, alpha));
+        }
 
-                // Draw lighter patches for variation
-                for (int i = 0; i < num_light_patches; ++i) {
-                    float offset_x = offset_dist(soil_gen);
-                    float offset_y = offset_dist(soil_gen);
-                    float size_mult = size_dist(soil_gen);
-                    float radius = patch_radius * size_mult * 0.7f; // Smaller
+        // Draw lighter lines for highlights
+        for (int i = 0; i < num_light_lines; ++i) {
+            float x1 = cx + offset_dist(rock_gen);
+            float y1 = cy + offset_dist(rock_gen);
+            float length = length_dist(rock_gen) * 0.6f;
+            float angle = angle_dist(rock_gen);
+            float x2 = x1 + length * std::cos(angle);
+            float y2 = y1 + length * std::sin(angle);
+
+            // Lighter grey highlights
+            int color_var = (rock_gen() % 40);
+            uint8_t line_r = std::clamp((int)br + color_var, 0, 255);
+            uint8_t line_g = std::clamp((int)bg + color_var, 0, 255);
+            uint8_t line_b = std::clamp((int)bb + color_var, 0, 255);
+            uint8_t alpha = 80 + (rock_gen() % 80);
+
+            out.line(sf::Vector2f(x1, y1), sf::Vector2f(x2, y2), 1.0f, sf::Color(line_r, line_g, line_b, alpha));
+        }
+
+        // Draw small rocky dots for texture
+        for (int i = 0; i < num_dots; ++i) {
+            float dot_x = cx + offset_dist(rock_gen);
+            float dot_y = cy + offset_dist(rock_gen);
+            float dot_radius = 0.5f + (rock_gen() % 20) * 0.1f; // 0.5-2.5 pixels
+
+            // Mix of dark and light dots
+            bool is_dark = (rock_gen() % 2) == 0;
+            int color_var = (rock_gen() % 30) - 15;
+            uint8_t dot_r, dot_g, dot_b;
+            if (is_dark) {
+                dot_r = std::clamp((int)shr + color_var, 0, 255);
+                dot_g = std::clamp((int)shg + color_var, 0, 255);
+                dot_b = std::clamp((int)shb + color_var, 0, 255);
+            } else {
+                dot_r = std::clamp((int)br + color_var + 20, 0, 255);
+                dot_g = std::clamp((int)bg + color_var + 20, 0, 255);
+                dot_b = std::clamp((int)bb + color_var + 20, 0, 255);
+            }
+            uint8_t alpha = 100 + (rock_gen() % 120);
+
+            out.circle(sf::Vector2f(dot_x, dot_y), dot_radius, sf::Color(dot_r, dot_g, dot_b, alpha));
+        }
+    }
 
-                    // Lighter brown variants
-                    int color_var = (soil_gen() % 30);
+    // Create irregular overlap where soil meets water
+    if (type == SOIL) {
+        for (int edge = 0; edge < 6; ++edge) {
+            auto [nq, nr] = hex_neighbor(q, r_coord, edge);
+            auto neighbor_it = terrainTiles.find({nq, nr});
+
+            if (neighbor_it != terrainTiles.end() && neighbor_it->second.type == WATER) {
+                // Soil meets water - create irregular dirt invasion
+                sf::Vector2f p1 = points[edge];
+                sf::Vector2f p2 = points[(edge + 1) % 6];
+
+                // Use edge-specific seed for consistent but varied patterns
+                std::mt19937 edge_gen(q * 10000 + r_coord * 100 + edge);
+                std::uniform_real_distribution<float> offset_dist(0.0f, 1.0f);
+                std::uniform_real_distribution<float> size_dist(0.6f, 1.2f);
+                std::uniform_real_distribution<float> extend_dist(0.2f, 0.6f);
+
+                // Draw 5-8 irregular soil patches along this edge
+                int num_patches = 5 + (edge_gen() % 4);
+                for (int i = 0; i < num_patches; ++i) {
+                    // Position along the edge
+                    float t = offset_dist(edge_gen);
+                    float edge_x = p1.x + (p2.x - p1.x) * t;
+                    float edge_y = p1.y + (p2.y - p1.y) * t;
+
+                    // Calculate direction towards water (perpendicular to edge, outward)
+                    float dx = p2.x - p1.x;
+                    float dy = p2.y - p1.y;
+                    float edge_len = std::sqrt(dx * dx + dy * dy);
+                    float perp_x = -dy / edge_len; // Perpendicular direction
+                    float perp_y = dx / edge_len;
+
+                    // Extend into water tile
+                    float extension = extend_dist(edge_gen) * hex_size;
+                    float patch_x = edge_x + perp_x * extension;
+                    float patch_y = edge_y + perp_y * extension;
+
+                    // Draw soil patch
+                    float radius = (2.0f + offset_dist(edge_gen) * 3.0f) * size_dist(edge_gen);
+                    int color_var = (edge_gen() % 20) - 10;
                     uint8_t patch_r = std::clamp((int)br + color_var, 0, 255);
                     uint8_t patch_g = std::clamp((int)bg + color_var, 0, 255);
                     uint8_t patch_b = std::clamp((int)bb + color_var, 0, 255);
-                    uint8_t alpha = 50 + (soil_gen() % 80); // More diffused
+                    uint8_t alpha = 150 + (edge_gen() % 80);
 
-                    renderer.drawCircle(cx + offset_x, cy + offset_y, radius, patch_r, patch_g, patch_b, alpha);
+                    out.circle(sf::Vector2f(patch_x, patch_y), radius, sf::Color(patch_r, patch_g, patch_b, alpha));
                 }
             }
+        }
+    }
 
-            // Add rocky, jagged texture for rocks
-            if (type == ROCK) {
-                std::mt19937 rock_gen(q * 1000 + r_coord);
-                std::uniform_real_distribution<float> offset_dist(-hex_size * 0.5f, hex_size * 0.5f);
-                std::uniform_real_distribution<float> length_dist(hex_size * 0.1f, hex_size * 0.4f);
-                std::uniform_real_distribution<float> angle_dist(0.0f, 6.28318f); // 0 to 2*PI
-
-                int num_dark_lines = 20; // Dark cracks/lines
-                int num_light_lines = 12; // Light edge highlights
-                int num_dots = 25; // Small rocky dots
-
-                // Draw dark jagged lines for cracks and depth
-                for (int i = 0; i < num_dark_lines; ++i) {
-                    float x1 = cx + offset_dist(rock_gen);
-                    float y1 = cy + offset_dist(rock_gen);
-                    float length = length_dist(rock_gen);
-                    float angle = angle_dist(rock_gen);
-                    float x2 = x1 + length * std::cos(angle);
-                    float y2 = y1 + length * std::sin(angle);
-
-                    // Dark lines using shadow colors
-                    int color_var = (rock_gen() % 20) - 10;
-                    uint8_t line_r = std::clamp((int)shr + color_var, 0, 255);
-                    uint8_t line_g = std::clamp((int)shg + color_var, 0, 255);
-                    uint8_t line_b = std::clamp((int)shb + color_var, 0, 255);
-                    uint8_t alpha = 120 + (rock_gen() % 100);
-
-                    renderer.drawLine(x1, y1, x2, y2, line_r, line_g, line_b, alpha, 1.5f);
-                }
+    // Smooth edges between tiles of the same terrain type
+    for (int edge = 0; edge < 6; ++edge) {
+        auto [nq, nr] = hex_neighbor(q, r_coord, edge);
+        auto neighbor_it = terrainTiles.find({nq, nr});
 
-                // Draw lighter lines for highlights
-                for (int i = 0; i < num_light_lines; ++i) {
-                    float x1 = cx + offset_dist(rock_gen);
-                    float y1 = cy + offset_dist(rock_gen);
-                    float length = length_dist(rock_gen) * 0.6f;
-                    float angle = angle_dist(rock_gen);
-                    float x2 = x1 + length * std::cos(angle);
-                    float y2 = y1 + length * std::sin(angle);
-
-                    // Lighter grey highlights
-                    int color_var = (rock_gen() % 40);
-                    uint8_t line_r = std::clamp((int)br + color_var, 0, 255);
-                    uint8_t line_g = std::clamp((int)bg + color_var, 0, 255);
-                    uint8_t line_b = std::clamp((int)bb + color_var, 0, 255);
-                    uint8_t alpha = 80 + (rock_gen() % 80);
-
-                    renderer.drawLine(x1, y1, x2, y2, line_r, line_g, line_b, alpha, 1.0f);
-                }
+        if (neighbor_it != terrainTiles.end() && neighbor_it->second.type == type) {
+            // Same terrain type - draw blending edge
+            sf::Vector2f p1 = points[edge];
+            sf::Vector2f p2 = points[(edge + 1) % 6];
 
-                // Draw small rocky dots for texture
-                for (int i = 0; i < num_dots; ++i) {
-                    float dot_x = cx + offset_dist(rock_gen);
-                    float dot_y = cy + offset_dist(rock_gen);
-                    float dot_radius = 0.5f + (rock_gen() % 20) * 0.1f; // 0.5-2.5 pixels
-
-                    // Mix of dark and light dots
-                    bool is_dark = (rock_gen() % 2) == 0;
-                    int color_var = (rock_gen() % 30) - 15;
-                    uint8_t dot_r, dot_g, dot_b;
-                    if (is_dark) {
-                        dot_r = std::clamp((int)shr + color_var, 0, 255);
-                        dot_g = std::clamp((int)shg + color_var, 0, 255);
-                        dot_b = std::clamp((int)shb + color_var, 0, 255);
-                    } else {
-                        dot_r = std::clamp((int)br + color_var + 20, 0, 255);
-                        dot_g = std::clamp((int)bg + color_var + 20, 0, 255);
-                        dot_b = std::clamp((int)bb + color_var + 20, 0, 255);
-                    }
-                    uint8_t alpha = 100 + (rock_gen() % 120);
+            // Use averaged color between this tile and center for smooth blend
+            uint8_t blend_r = (br + base_r) / 2;
+            uint8_t blend_g = (bg + base_g) / 2;
+            uint8_t blend_b = (bb + base_b) / 2;
 
-                    renderer.drawCircle(dot_x, dot_y, dot_radius, dot_r, dot_g, dot_b, alpha);
-                }
-            }
-
-            // Create irregular overlap where soil meets water
-            if (type == SOIL) {
-                for (int edge = 0; edge < 6; ++edge) {
-                    auto [nq, nr] = get_neighbor_coords(q, r_coord, edge);
-                    auto neighbor_it = terrainTiles.find({nq, nr});
-
-                    if (neighbor_it != terrainTiles.end() && neighbor_it->second.type == WATER) {
-                        // Soil meets water - create irregular dirt invasion
-                        sf::Vector2f p1 = points[edge];
-                        sf::Vector2f p2 = points[(edge + 1) % 6];
-
-                        // Use edge-specific seed for consistent but varied patterns
-                        std::mt19937 edge_gen(q * 10000 + r_coord * 100 + edge);
-                        std::uniform_real_distribution<float> offset_dist(0.0f, 1.0f);
-                        std::uniform_real_distribution<float> size_dist(0.6f, 1.2f);
-                        std::uniform_real_distribution<float> extend_dist(0.2f, 0.6f);
-
-                        // Draw 5-8 irregular soil patches along this edge
-                        int num_patches = 5 + (edge_gen() % 4);
-                        for (int i = 0; i < num_patches; ++i) {
-                            // Position along the edge
-                            float t = offset_dist(edge_gen);
-                            float edge_x = p1.x + (p2.x - p1.x) * t;
-                            float edge_y = p1.y + (p2.y - p1.y) * t;
-
-                            // Calculate direction towards water (perpendicular to edge, outward)
-                            float dx = p2.x - p1.x;
-                            float dy = p2.y - p1.y;
-                            float edge_len = std::sqrt(dx * dx + dy * dy);
-                            float perp_x = -dy / edge_len; // Perpendicular direction
-                            float perp_y = dx / edge_len;
-
-                            // Extend into water tile
-                            float extension = extend_dist(edge_gen) * hex_size;
-                            float patch_x = edge_x + perp_x * extension;
-                            float patch_y = edge_y + perp_y * extension;
-
-                            // Draw soil patch
-                            float radius = (2.0f + offset_dist(edge_gen) * 3.0f) * size_dist(edge_gen);
-                            int color_var = (edge_gen() % 20) - 10;
-                            uint8_t patch_r = std::clamp((int)br + color_var, 0, 255);
-                            uint8_t patch_g = std::clamp((int)bg + color_var, 0, 255);
-                            uint8_t patch_b = std::clamp((int)bb + color_var, 0, 255);
-                            uint8_t alpha = 150 + (edge_gen() % 80);
-
-                            renderer.drawCircle(patch_x, patch_y, radius, patch_r, patch_g, patch_b, alpha);
-                        }
-                    }
-                }
-            }
-
-            // Smooth edges between tiles of the same terrain type
-            for (int edge = 0; edge < 6; ++edge) {
-                auto [nq, nr] = get_neighbor_coords(q, r_coord, edge);
-                auto neighbor_it = terrainTiles.find({nq, nr});
+            out.line(sf::Vector2f(p1.x, p1.y), sf::Vector2f(p2.x, p2.y), 2.0f, sf::Color(blend_r, blend_g, blend_b, 180));
+        }
+    }
+}
 
-                if (neighbor_it != terrainTiles.end() && neighbor_it->second.type == type) {
-                    // Same terrain type - draw blending edge
-                    sf::Vector2f p1 = points[edge];
-                    sf::Vector2f p2 = points[(edge + 1) % 6];
+HexGrid::TileShade HexGrid::shade_tile(int q, int r, float brightness_center_q, float brightness_center_r,
+                                       bool has_alive_hares) const {
+    TileShade shade;
+    shade.type = get_terrain_type(q, r);
+    switch (shade.type) {
+        case SOIL: shade.base_r = 139; shade.base_g = 69; shade.base_b = 19; break; // Brown
+        case WATER: shade.base_r = 0; shade.base_g = 150; shade.base_b = 255; break; // Brighter Blue
+        case ROCK: shade.base_r = 128; shade.base_g = 128; shade.base_b = 128; break; // Gray
+    }
 
-                    // Use averaged color between this tile and center for smooth blend
-                    uint8_t blend_r = (br + base_r) / 2;
-                    uint8_t blend_g = (bg + base_g) / 2;
-                    uint8_t blend_b = (bb + base_b) / 2;
+    // Calculate distance for brightness adjustment from brightness center
+    float factor;
+    if (!has_alive_hares) {
+        factor = 0.5f;  // Dim whole map if no alive hares
+    } else {
+        float dist = hex_distance(q - brightness_center_q, r - brightness_center_r);
+        factor = 1.0f - std::min(dist / 15.0f, 1.0f) * 0.5f;
+    }
+    shade.r = (uint8_t)(shade.base_r * factor);
+    shade.g = (uint8_t)(shade.base_g * factor);
+    shade.b = (uint8_t)(shade.base_b * factor);
+    return shade;
+}
 
-                    renderer.drawLine(p1.x, p1.y, p2.x, p2.y, blend_r, blend_g, blend_b, 180, 2.0f);
-                }
+void HexGrid::draw_batched(SFMLRenderer& renderer, float offset_x, float offset_y,
+                           const ViewRect& view, DetailLevel detail,
+                           float brightness_center_q, float brightness_center_r,
+                           bool has_alive_hares) const {
+    terrain_vertices.clear();
+    auto add_triangle = [&](sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+        terrain_vertices.triangle(a, b, c, color);
+    };
+
+    for_each_in_rect(view, [&](int q, int r, float x, float y) {
+        sf::Vector2f center(x + offset_x, y + offset_y);
+        TileShade shade = shade_tile(q, r, brightness_center_q, brightness_center_r, has_alive_hares);
+
+        if (detail == DETAIL_MINIMAL) {
+            // Flat hexagon, no shading
+            sf::Color flat(shade.r, shade.g, shade.b);
+            for (int i = 0; i < 6; ++i) {
+                add_triangle(center, center + hexagon_points[i] * hex_size,
+                             center + hexagon_points[(i + 1) % 6] * hex_size, flat);
             }
+            return;
         }
 
+        // Drop shadow, then the same pizza slices, shine and shadow as full detail
+        sf::Vector2f shadow_center = center + sf::Vector2f(3.0f, 3.0f);
+        for (int i = 0; i < 6; ++i) {
+            add_triangle(shadow_center, shadow_center + hexagon_points[i] * hex_size,
+                         shadow_center + hexagon_points[(i + 1) % 6] * hex_size, sf::Color(0, 0, 0, 100));
+        }
+        sf::Color shine(std::min(255, shade.r + 80), std::min(255, shade.g + 80), std::min(255, shade.b + 80));
+        sf::Color shadow((uint8_t)(shade.r * 0.3f), (uint8_t)(shade.g * 0.3f), (uint8_t)(shade.b * 0.3f));
+        for (int i = 0; i < 6; ++i) {
+            sf::Color color;
+            if (i == 0 || i == 1) {
+                color = shine;
+            } else if (i == 3 || i == 4) {
+                color = shadow;
+            } else {
+                int variation = (i % 3) * 10 - 10;
+                color = sf::Color(std::clamp(shade.r + variation, 0, 255),
+                                  std::clamp(shade.g + variation, 0, 255),
+                                  std::clamp(shade.b + variation, 0, 255));
+            }
+            add_triangle(center, center + hexagon_points[i] * hex_size,
+                         center + hexagon_points[(i + 1) % 6] * hex_size, color);
+        }
+    });
 
-    }
-}
-
-std::pair<int, int> HexGrid::get_neighbor_coords(int q, int r, int direction) const {
-    auto [dq, dr] = directions[direction % 6];
-    return {q + dq, r + dr};
+    terrain_vertices.draw(*renderer.getWindow());
 }
 
 
-
 // ============================================================================
 // END OF HEX GRID CLASS IMPLEMENTATION
 // ============================================================================
 
-const std::vector<std::pair<int, int>> HexGrid::directions = {
-    {0, -1},  // top
-    {1, -1},  // upper-right
-    {1, 0},   // lower-right
-    {0, 1},   // bottom
-    {-1, 1},  // lower-left
-    {-1, 0}   // upper-left
-};
-
 TerrainType HexGrid::get_terrain_type(int q, int r) const {
     auto it = terrainTiles.find({q, r});
     if (it != terrainTiles.end()) {
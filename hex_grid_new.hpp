@@ -1,7 +1,15 @@
 #pragma once
 
 #include "sfml_renderer.hpp"
+#include "camera.hpp"
+#include "constants.hpp"
 #include "ga.hpp"
+#include "hex_field.hpp"
+#include "hex_math.hpp"
+#include "pool_allocator.hpp"
+#include "vertex_batch.hpp"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -9,6 +17,13 @@
 #include <vector>
 #include <random>
 #include <set>
+#include <tuple>
+
+// Coordinate-keyed containers that change every tick recycle their nodes
+template <typename V>
+using CoordMap = std::map<std::pair<int, int>, V, std::less<std::pair<int, int>>,
+                          PoolAllocator<std::pair<const std::pair<int, int>, V>>>;
+using CoordSet = std::set<std::pair<int, int>, std::less<std::pair<int, int>>, PoolAllocator<std::pair<int, int>>>;
 
 // Terrain types
 enum TerrainType {
@@ -17,17 +32,22 @@ enum TerrainType {
     ROCK
 };
 
+// Nutrients of a new tile before random variation
+float base_nutrients(TerrainType type);
+
 // Terrain tile class
 struct TerrainTile {
     int q, r;
     TerrainType type;
-    float nutrients; // 0.0 to 1.0, affects plant growth likelihood and quality
-    TerrainTile(int q, int r, TerrainType type, float nutrients) : q(q), r(r), type(type), nutrients(nutrients) {}
+    TerrainTile(int q, int r, TerrainType type) : q(q), r(r), type(type) {}
 };
 
 // Plant stages
 enum PlantStage { SEED, SPROUT, PLANT, CHARRED };
 
+// Why an animal died (EATEN animals are removed by the hunter directly)
+enum DeathCause : uint8_t { CAUSE_NONE, CAUSE_STARVED, CAUSE_DEHYDRATED, CAUSE_BURNED, CAUSE_EATEN, CAUSE_EMIGRATED };
+
 // Plant class
 struct Plant {
     int q, r;
@@ -47,12 +67,15 @@ public:
     float hex_size;
     std::map<std::pair<int, int>, std::pair<float, float>> hexagons;  // (q,r) -> (x,y)
     std::map<std::pair<int, int>, TerrainTile> terrainTiles;  // (q,r) -> tile
-    std::map<std::pair<int, int>, Plant> plants;  // (q,r) -> plant
-    std::map<std::pair<int, int>, float> fire_timers;  // (q,r) -> time left burning
+    CoordMap<Plant> plants;  // (q,r) -> plant
+    CoordMap<float> fire_timers;  // (q,r) -> time left burning
     std::vector<sf::Vector2f> hexagon_points;  // Cached points for size 1.0
     int max_grid_distance = 10;  // Will be set based on screen size
-    std::set<std::pair<int, int>> hare_positions;  // Occupied by hares
-    static const std::vector<std::pair<int, int>> directions;
+    CoordSet hare_positions;  // Occupied by hares
+    HexField nutrients;       // 0.0 to 1.0 per tile, affects plant growth likelihood and quality
+    HexField hare_density;    // Hares per tile, rebuilt before the predators move
+    HexField fox_density;     // Foxes per tile, rebuilt before the foxes move
+    HexField fox_neighbors;   // Foxes on the six surrounding tiles, rebuilt with fox_density
 
     HexGrid(float size) : hex_size(size) {
         // Cache hexagon points for size 1.0
@@ -64,7 +87,7 @@ public:
     }
 
     // Convert axial coordinates to pixel position
-    std::pair<float, float> axial_to_pixel(int q, int r) const;
+    std::pair<float, float> axial_to_pixel(int q, int r) const { return hex_to_pixel(q, r, hex_size); }
 
     // Add hexagon at axial coordinates (q, r)
     void add_hexagon(int q, int r);
@@ -78,15 +101,49 @@ public:
     // Expand grid by one layer
     void expand_grid(int layers = 1);
 
-    // Draw all hexagons
+    // Draw hexagons intersecting the view rectangle (world pixels) at the given detail
     void draw(SFMLRenderer& renderer, uint8_t r, uint8_t g, uint8_t b,
               uint8_t outline_r, uint8_t outline_g, uint8_t outline_b,
-              float offset_x, float offset_y, int screen_width, int screen_height,
+              float offset_x, float offset_y, const ViewRect& view, DetailLevel detail,
               float brightness_center_q = 0, float brightness_center_r = 0,
               bool has_alive_hares = true) const;
 
-    // Get neighbor coordinates for a given direction
-    std::pair<int, int> get_neighbor_coords(int q, int r, int direction) const;
+    // Append the full-detail look of one tile centered at (cx, cy): shaded
+    // slices, water waves, soil patches, rock cracks and edge blending.
+    // Reads the grid only, so tiles can be appended from several threads.
+    void append_tile(VertexBatch& out, const SFMLRenderer& renderer, int q, int r, float cx, float cy,
+                     float brightness_center_q, float brightness_center_r, bool has_alive_hares) const;
+
+    // Call fn(q, r_min, r_max) for every column q of the axial range covering
+    // the rectangle; a superset of the hexagons that intersect it
+    template <typename Fn>
+    void for_each_column_in_rect(const ViewRect& view, Fn&& fn) const {
+        const float half_height = hex_size * SQRT3 / 2.0f;
+        int q_min = std::max(-max_grid_distance, (int)std::floor((view.left - hex_size) / (1.5f * hex_size)));
+        int q_max = std::min(max_grid_distance, (int)std::ceil((view.right + hex_size) / (1.5f * hex_size)));
+        for (int q = q_min; q <= q_max; ++q) {
+            int r_min = std::max(-max_grid_distance, (int)std::floor((view.top - half_height) / (hex_size * SQRT3) - q / 2.0f));
+            int r_max = std::min(max_grid_distance, (int)std::ceil((view.bottom + half_height) / (hex_size * SQRT3) - q / 2.0f));
+            fn(q, r_min, r_max);
+        }
+    }
+
+    // Call fn(q, r, x, y) for every hexagon whose bounds intersect the rectangle.
+    // Walks the axial range covering the rectangle, so cost scales with the view.
+    template <typename Fn>
+    void for_each_in_rect(const ViewRect& view, Fn&& fn) const {
+        const float half_height = hex_size * SQRT3 / 2.0f;
+        for_each_column_in_rect(view, [&](int q, int r_min, int r_max) {
+            for (int r = r_min; r <= r_max; ++r) {
+                auto it = hexagons.find({q, r});
+                if (it == hexagons.end()) continue;
+                auto [x, y] = it->second;
+                if (x + hex_size < view.left || x - hex_size > view.right ||
+                    y + half_height < view.top || y - half_height > view.bottom) continue;
+                fn(q, r, x, y);
+            }
+        });
+    }
 
     // Get terrain type at coordinates
     TerrainType get_terrain_type(int q, int r) const;
@@ -101,6 +158,21 @@ public:
     static float calculate_visibility(sf::Color hare_color, TerrainType terrain);
 
 private:
+    // Terrain base color and brightness-adjusted color for a tile
+    struct TileShade {
+        TerrainType type;
+        uint8_t base_r, base_g, base_b;
+        uint8_t r, g, b;
+    };
+    TileShade shade_tile(int q, int r, float brightness_center_q, float brightness_center_r,
+                         bool has_alive_hares) const;
+
+    // Untextured terrain for zoomed-out views
+    void draw_batched(SFMLRenderer& renderer, float offset_x, float offset_y,
+                      const ViewRect& view, DetailLevel detail,
+                      float brightness_center_q, float brightness_center_r,
+                      bool has_alive_hares) const;
+    mutable VertexBatch terrain_vertices;  // All visible hexes in one draw call, reused between frames
 };
 
 // ============================================================================
@@ -109,11 +181,11 @@ private:
 
 struct HexObject {
     int q, r;
+    uint32_t id = 0;         // Unique per simulation, 0 = unassigned
+    uint32_t parent_id = 0;  // Id of the parent, 0 for the initial population
     HexObject(int q, int r) : q(q), r(r) {}
     void move(int direction) {
-        auto [dq, dr] = HexGrid::directions[direction % 6];
-        q += dq;
-        r += dr;
+        std::tie(q, r) = hex_neighbor(q, r, direction % 6);
     }
 };
 
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "constants.hpp"
+#include "simd_lanes.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// ============================================================================
+// HEX MATH - Axial coordinate math for flat-top hexagons
+// ============================================================================
+
+// Neighbour offsets in direction order; recordings store these indices
+constexpr std::array<std::pair<int, int>, 6> HEX_DIRECTIONS = {{
+    {0, -1},  // top
+    {1, -1},  // upper-right
+    {1, 0},   // lower-right
+    {0, 1},   // bottom
+    {-1, 1},  // lower-left
+    {-1, 0}   // upper-left
+}};
+
+// Neighbour of (q, r) in a direction from 0 to 5
+constexpr std::pair<int, int> hex_neighbor(int q, int r, int direction) {
+    return {q + HEX_DIRECTIONS[direction].first, r + HEX_DIRECTIONS[direction].second};
+}
+
+// Steps covered by an axial offset
+constexpr int hex_distance(int dq, int dr) {
+    int ds = dq + dr;
+    return ((dq < 0 ? -dq : dq) + (dr < 0 ? -dr : dr) + (ds < 0 ? -ds : ds)) / 2;
+}
+
+// Same for fractional offsets (e.g. from an averaged position)
+inline float hex_distance(float dq, float dr) {
+    return std::max({std::abs(dq), std::abs(dr), std::abs(dq + dr)});
+}
+
+// Direction of a neighbouring offset, -1 if the tiles are not adjacent
+constexpr int hex_direction(int dq, int dr) {
+    for (int dir = 0; dir < 6; ++dir) {
+        if (HEX_DIRECTIONS[dir].first == dq && HEX_DIRECTIONS[dir].second == dr) return dir;
+    }
+    return -1;
+}
+
+// Center of a tile in pixels, with (0, 0) at the origin
+constexpr std::pair<float, float> hex_to_pixel(int q, int r, float size) {
+    return {size * (3.0f / 2.0f * q), size * (SQRT3 / 2.0f * q + SQRT3 * r)};
+}
+
+// Nearest tile to a fractional axial position
+inline std::pair<int, int> hex_round(float q, float r) {
+    float s = -q - r;
+    float rq = std::round(q), rr = std::round(r), rs = std::round(s);
+    float dq = std::abs(rq - q), dr = std::abs(rr - r), ds = std::abs(rs - s);
+    if (dq > dr && dq > ds) {
+        rq = -rr - rs;
+    } else if (dr > ds) {
+        rr = -rq - rs;
+    }
+    return {static_cast<int>(rq), static_cast<int>(rr)};
+}
+
+// Tile containing a pixel position
+inline std::pair<int, int> pixel_to_hex(float x, float y, float size) {
+    float q = (2.0f / 3.0f * x) / size;
+    float r = (-1.0f / 3.0f * x + SQRT3 / 3.0f * y) / size;
+    return hex_round(q, r);
+}
+
+// Call fn(q, r) for the 6 * radius tiles at exactly radius steps from the
+// center, walking around from the lower-left corner
+template <typename Fn>
+void hex_ring(int q, int r, int radius, Fn&& fn) {
+    if (radius <= 0) {
+        fn(q, r);
+        return;
+    }
+    q += HEX_DIRECTIONS[4].first * radius;
+    r += HEX_DIRECTIONS[4].second * radius;
+    for (int dir = 0; dir < 6; ++dir) {
+        for (int step = 0; step < radius; ++step) {
+            fn(q, r);
+            q += HEX_DIRECTIONS[(8 - dir) % 6].first;  // Lower-right, then counter-clockwise
+            r += HEX_DIRECTIONS[(8 - dir) % 6].second;
+        }
+    }
+}
+
+// Call fn(q, r) for every tile within radius, center first, then ring by ring
+template <typename Fn>
+void hex_spiral(int q, int r, int radius, Fn&& fn) {
+    for (int k = 0; k <= radius; ++k) {
+        hex_ring(q, r, k, fn);
+    }
+}
+
+// Call fn(q, r) for each tile on the straight line between two tiles, both ends included
+template <typename Fn>
+void hex_line(int q0, int r0, int q1, int r1, Fn&& fn) {
+    int n = hex_distance(q1 - q0, r1 - r0);
+    if (n == 0) {
+        fn(q0, r0);
+        return;
+    }
+    // Nudge off the edges so ties between two tiles always break the same way
+    const float eq = 1e-6f, er = 2e-6f;
+    for (int i = 0; i <= n; ++i) {
+        float t = static_cast<float>(i) / n;
+        auto [q, r] = hex_round(q0 + eq + (q1 - q0) * t, r0 + er + (r1 - r0) * t);
+        fn(q, r);
+    }
+}
+
+// ============================================================================
+// BATCH VARIANTS
+// ============================================================================
+
+namespace hex_detail {
+
+template <typename L>
+size_t to_pixel_lanes(const int32_t* q, const int32_t* r, size_t n, float size, float* x, float* y, size_t i) {
+    const auto kx = L::splat(size * 1.5f);
+    const auto kq = L::splat(size * (SQRT3 / 2.0f));
+    const auto kr = L::splat(size * SQRT3);
+    for (; i + L::WIDTH <= n; i += L::WIDTH) {
+        auto fq = L::load_int(q + i), fr = L::load_int(r + i);
+        L::store(x + i, L::mul(kx, fq));
+        L::store(y + i, L::add(L::mul(kq, fq), L::mul(kr, fr)));
+    }
+    return i;
+}
+
+} // namespace hex_detail
+
+// Pixel centers of n tiles at once
+inline void hex_to_pixel_batch(const int32_t* q, const int32_t* r, size_t n, float size, float* x, float* y) {
+    size_t i = hex_detail::to_pixel_lanes<WideLanes>(q, r, n, size, x, y, 0);
+    hex_detail::to_pixel_lanes<ScalarLanes>(q, r, n, size, x, y, i);
+}
@@ -0,0 +1,266 @@
+#include "hexaworld_api.h"
+#include "simulation.hpp"
+#include "constants.hpp"
+#include "event_log.hpp"
+#include "world_digest.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// HEXAWORLD C API IMPLEMENTATION
+// ============================================================================
+
+// Animal fields are read in place from the species vectors and the hex
+// fields are handed out as they are. Terrain, plants and fires live in maps
+// and salmon energy is settled lazily, so those are gathered into dense
+// arrays once per step and viewed from there.
+struct hw_world {
+    Simulation sim{HEX_SIZE};
+    int radius = 0;
+    size_t row = 0;
+    std::vector<uint8_t> terrain, plant_stage;
+    std::vector<float> plant_growth, fire;
+    std::vector<float> salmon_energy;
+    std::vector<std::pair<int, int>> plant_cells, fire_cells;  // Where the arrays were last written
+};
+
+namespace {
+
+const uint8_t TILE_EMPTY = 255;
+
+size_t tile_index(const hw_world& world, int q, int r) {
+    return static_cast<size_t>(q + world.radius + 1) * world.row + (r + world.radius + 1);
+}
+
+bool in_tiles(const hw_world& world, int q, int r) {
+    return std::abs(q) <= world.radius && std::abs(r) <= world.radius;
+}
+
+// Bring the gathered arrays up to date; only the cells written last time
+// are cleared, so this costs the number of plants, fires and salmon
+void refresh(hw_world& world) {
+    for (auto [q, r] : world.plant_cells) {
+        world.plant_stage[tile_index(world, q, r)] = TILE_EMPTY;
+        world.plant_growth[tile_index(world, q, r)] = 0.0f;
+    }
+    world.plant_cells.clear();
+    for (const auto& [coord, plant] : world.sim.grid.plants) {
+        if (!in_tiles(world, coord.first, coord.second)) continue;
+        world.plant_stage[tile_index(world, coord.first, coord.second)] = static_cast<uint8_t>(plant.stage);
+        world.plant_growth[tile_index(world, coord.first, coord.second)] = plant.growth_time;
+        world.plant_cells.push_back(coord);
+    }
+
+    for (auto [q, r] : world.fire_cells) world.fire[tile_index(world, q, r)] = 0.0f;
+    world.fire_cells.clear();
+    for (const auto& [coord, left] : world.sim.grid.fire_timers) {
+        if (!in_tiles(world, coord.first, coord.second)) continue;
+        world.fire[tile_index(world, coord.first, coord.second)] = left;
+        world.fire_cells.push_back(coord);
+    }
+
+    world.salmon_energy.resize(world.sim.salmons.size());
+    for (size_t i = 0; i < world.sim.salmons.size(); ++i) {
+        world.salmon_energy[i] = world.sim.salmons[i].energy_at(world.sim.tick_count);
+    }
+}
+
+template <typename T>
+hw_view make_view(const T* first, size_t count, size_t stride, hw_type type, float offset = 0.0f, float scale = 1.0f) {
+    return {count > 0 ? first : nullptr, count, stride, type, offset, scale};
+}
+
+hw_view empty_view() {
+    return {nullptr, 0, 0, HW_F32, 0.0f, 1.0f};
+}
+
+template <typename Animal>
+hw_view animal_view(const std::vector<Animal>& animals, hw_animal_field field) {
+    const Animal* first = animals.data();
+    size_t n = animals.size();
+    if (n == 0) return empty_view();
+    switch (field) {
+        case HW_ANIMAL_ID: return make_view(&first->id, n, sizeof(Animal), HW_U32);
+        case HW_ANIMAL_Q: return make_view(&first->q, n, sizeof(Animal), HW_I32);
+        case HW_ANIMAL_R: return make_view(&first->r, n, sizeof(Animal), HW_I32);
+        case HW_ANIMAL_ENERGY: return make_view(&first->energy, n, sizeof(Animal), HW_F32);
+        case HW_ANIMAL_THIRST:
+            if constexpr (!std::is_same_v<Animal, Salmon>) return make_view(&first->thirst, n, sizeof(Animal), HW_F32);
+            break;
+    }
+    return empty_view();
+}
+
+// Trait `index` of the genome layout: genes first, then flags
+template <typename Animal>
+hw_view genome_view(const std::vector<Animal>& animals, uint32_t index) {
+    using Layout = GenomeLayout<decltype(Animal::genome)>;
+    hw_view view = empty_view();
+    if (animals.empty()) return view;
+    const auto& genome = animals.front().genome;
+    size_t n = animals.size();
+    uint32_t i = 0;
+    auto view_gene = [&](const auto& g) {
+        using Trait = std::decay_t<decltype(genome.*g.field)>;
+        if (i++ == index) view = make_view(&(genome.*g.field).code, n, sizeof(Animal), HW_U16, Trait::LOW, (Trait::HIGH - Trait::LOW) / Trait::STEPS);
+    };
+    auto view_flag = [&](const auto& f) {
+        static_assert(sizeof(bool) == 1, "flags are viewed as bytes");
+        if (i++ == index) view = make_view(reinterpret_cast<const uint8_t*>(&(genome.*f.field)), n, sizeof(Animal), HW_U8);
+    };
+    std::apply([&](const auto&... g) { (view_gene(g), ...); }, Layout::genes);
+    std::apply([&](const auto&... f) { (view_flag(f), ...); }, Layout::flags);
+    return view;
+}
+
+template <typename Genome>
+constexpr uint32_t trait_count() {
+    using Layout = GenomeLayout<Genome>;
+    return static_cast<uint32_t>(std::tuple_size_v<decltype(Layout::genes)> +
+                                 std::tuple_size_v<decltype(Layout::flags)>);
+}
+
+hw_view field_view(const HexField& field) {
+    return make_view(field.data(), field.size(), sizeof(float), HW_F32);
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t hw_api_version(void) {
+    return HW_API_VERSION;
+}
+
+hw_world* hw_world_create(uint32_t seed, float width, float height) {
+    try {
+        // Nothing drains the event log in a library
+        event_log.set_level(LOG_OFF);
+        gen.seed(seed);
+
+        auto world = std::make_unique<hw_world>();
+        world->sim.generate(width, height);
+        world->radius = world->sim.grid.nutrients.radius();
+        world->row = world->sim.grid.nutrients.stride();
+        size_t cells = world->sim.grid.nutrients.size();
+        world->terrain.assign(cells, TILE_EMPTY);
+        world->plant_stage.assign(cells, TILE_EMPTY);
+        world->plant_growth.assign(cells, 0.0f);
+        world->fire.assign(cells, 0.0f);
+        for (const auto& [coord, tile] : world->sim.grid.terrainTiles) {
+            if (in_tiles(*world, coord.first, coord.second)) {
+                world->terrain[tile_index(*world, coord.first, coord.second)] = static_cast<uint8_t>(tile.type);
+            }
+        }
+        refresh(*world);
+        return world.release();
+    } catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+void hw_world_destroy(hw_world* world) {
+    delete world;
+}
+
+void hw_world_step(hw_world* world, uint32_t ticks) {
+    for (uint32_t i = 0; i < ticks; ++i) {
+        world->sim.tick(SIM_DT);
+    }
+    refresh(*world);
+}
+
+uint64_t hw_world_tick(const hw_world* world) {
+    return world->sim.tick_count;
+}
+
+uint64_t hw_world_digest(const hw_world* world) {
+    return digest_world(world->sim, gen).total;
+}
+
+int hw_world_start_fire(hw_world* world) {
+    bool lit = world->sim.start_fire();
+    refresh(*world);
+    return lit;
+}
+
+int hw_world_ignite(hw_world* world, int32_t q, int32_t r) {
+    bool lit = world->sim.ignite(q, r);
+    refresh(*world);
+    return lit;
+}
+
+uint32_t hw_world_spawn(hw_world* world, hw_species species, int32_t q, int32_t r) {
+    uint32_t id = world->sim.spawn(static_cast<EventSpecies>(species), q, r);
+    refresh(*world);
+    return id;
+}
+
+size_t hw_animal_count(const hw_world* world, hw_species species) {
+    switch (species) {
+        case HW_HARE: return world->sim.hares.size();
+        case HW_FOX: return world->sim.foxes.size();
+        case HW_WOLF: return world->sim.wolves.size();
+        case HW_SALMON: return world->sim.salmons.size();
+    }
+    return 0;
+}
+
+hw_view hw_animal_view(const hw_world* world, hw_species species, hw_animal_field field) {
+    switch (species) {
+        case HW_HARE: return animal_view(world->sim.hares, field);
+        case HW_FOX: return animal_view(world->sim.foxes, field);
+        case HW_WOLF: return animal_view(world->sim.wolves, field);
+        case HW_SALMON:
+            if (field == HW_ANIMAL_ENERGY) {
+                return make_view(world->salmon_energy.data(), world->salmon_energy.size(), sizeof(float), HW_F32);
+            }
+            return animal_view(world->sim.salmons, field);
+    }
+    return empty_view();
+}
+
+uint32_t hw_genome_trait_count(hw_species species) {
+    switch (species) {
+        case HW_HARE: return trait_count<HareGenome>();
+        case HW_FOX: return trait_count<FoxGenome>();
+        case HW_WOLF: return trait_count<WolfGenome>();
+        case HW_SALMON: return 0;
+    }
+    return 0;
+}
+
+hw_view hw_genome_view(const hw_world* world, hw_species species, uint32_t trait) {
+    switch (species) {
+        case HW_HARE: return genome_view(world->sim.hares, trait);
+        case HW_FOX: return genome_view(world->sim.foxes, trait);
+        case HW_WOLF: return genome_view(world->sim.wolves, trait);
+        case HW_SALMON: break;
+    }
+    return empty_view();
+}
+
+int32_t hw_tile_radius(const hw_world* world) {
+    return world->radius;
+}
+
+hw_view hw_tile_view(const hw_world* world, hw_tile_field field) {
+    switch (field) {
+        case HW_TILE_TERRAIN: return make_view(world->terrain.data(), world->terrain.size(), 1, HW_U8);
+        case HW_TILE_PLANT_STAGE: return make_view(world->plant_stage.data(), world->plant_stage.size(), 1, HW_U8);
+        case HW_TILE_PLANT_GROWTH: return make_view(world->plant_growth.data(), world->plant_growth.size(), sizeof(float), HW_F32);
+        case HW_TILE_FIRE: return make_view(world->fire.data(), world->fire.size(), sizeof(float), HW_F32);
+        case HW_TILE_NUTRIENTS: return field_view(world->sim.grid.nutrients);
+        case HW_TILE_HARE_DENSITY: return field_view(world->sim.grid.hare_density);
+        case HW_TILE_FOX_DENSITY: return field_view(world->sim.grid.fox_density);
+    }
+    return empty_view();
+}
+
+} // extern "C"
@@ -0,0 +1,146 @@
+#ifndef HEXAWORLD_API_H
+#define HEXAWORLD_API_H
+
+/* ============================================================================
+ * HEXAWORLD C API - Headless worlds for scripts and analysis tools
+ * ============================================================================
+ *
+ * Built as libhexaworld. A world is created from a seed, stepped a number of
+ * ticks at a time, and read through views: pointers straight into the
+ * simulation's own arrays with a stride, so reading state costs no copies.
+ * Views stay valid until the world is next stepped, changed or destroyed.
+ *
+ * Worlds are not thread-safe, and every world in a process draws from one
+ * random generator: hw_world_create reseeds it, so a run is repeatable as
+ * long as one world is created and stepped at a time.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define HW_EXPORT __attribute__((visibility("default")))
+#else
+#define HW_EXPORT
+#endif
+
+/* Bumped when a declaration here changes incompatibly */
+#define HW_API_VERSION 1
+
+typedef struct hw_world hw_world;
+
+/* Same values as the event log's species */
+typedef enum hw_species {
+    HW_HARE = 1,
+    HW_FOX = 2,
+    HW_WOLF = 3,
+    HW_SALMON = 4
+} hw_species;
+
+typedef enum hw_type {
+    HW_U8,
+    HW_U16,
+    HW_U32,
+    HW_I32,
+    HW_F32
+} hw_type;
+
+/* count elements of type, stride bytes apart; element i reads as
+ * offset + scale * *(type*)((const char*)data + i * stride) */
+typedef struct hw_view {
+    const void* data;  /* NULL when count is 0 */
+    size_t count;
+    size_t stride;
+    hw_type type;
+    float offset;
+    float scale;
+} hw_view;
+
+/* Per-animal fields; every species has them all except thirst (not salmon) */
+typedef enum hw_animal_field {
+    HW_ANIMAL_ID,      /* u32, increasing in birth order */
+    HW_ANIMAL_Q,       /* i32, axial column */
+    HW_ANIMAL_R,       /* i32, axial row */
+    HW_ANIMAL_ENERGY,  /* f32 */
+    HW_ANIMAL_THIRST   /* f32, 1 = fully hydrated */
+} hw_animal_field;
+
+/* Genome traits by species, in layout order (salmon have none) */
+enum {
+    HW_HARE_REPRODUCTION_THRESHOLD,
+    HW_HARE_MOVEMENT_AGGRESSION,
+    HW_HARE_WEIGHT,
+    HW_HARE_FEAR,
+    HW_HARE_MOVEMENT_EFFICIENCY,
+    HW_HARE_CAN_BURROW  /* u8, 0 or 1 */
+};
+enum {
+    HW_FOX_REPRODUCTION_THRESHOLD,
+    HW_FOX_HUNTING_AGGRESSION,
+    HW_FOX_WEIGHT,
+    HW_FOX_MOVEMENT_EFFICIENCY
+};
+enum {
+    HW_WOLF_REPRODUCTION_THRESHOLD,
+    HW_WOLF_HUNTING_AGGRESSION,
+    HW_WOLF_WEIGHT,
+    HW_WOLF_MOVEMENT_EFFICIENCY
+};
+
+/* Per-tile fields, all laid out as described at hw_tile_radius */
+typedef enum hw_tile_field {
+    HW_TILE_TERRAIN,       /* u8: 0 soil, 1 water, 2 rock, 255 outside the grid */
+    HW_TILE_PLANT_STAGE,   /* u8: 0 seed, 1 sprout, 2 plant, 3 charred, 255 none */
+    HW_TILE_PLANT_GROWTH,  /* f32, seconds in the current stage */
+    HW_TILE_FIRE,          /* f32, seconds left burning, 0 = not burning */
+    HW_TILE_NUTRIENTS,     /* f32, 0 to 1 */
+    HW_TILE_HARE_DENSITY,  /* f32, hares on the tile */
+    HW_TILE_FOX_DENSITY    /* f32, foxes on the tile */
+} hw_tile_field;
+
+HW_EXPORT uint32_t hw_api_version(void);
+
+/* Generate a world filling a width x height pixel area (12-pixel hexes)
+ * and place the initial animals; NULL on failure */
+HW_EXPORT hw_world* hw_world_create(uint32_t seed, float width, float height);
+HW_EXPORT void hw_world_destroy(hw_world* world);
+
+/* Advance by ticks fixed steps of 1/60 simulated second */
+HW_EXPORT void hw_world_step(hw_world* world, uint32_t ticks);
+HW_EXPORT uint64_t hw_world_tick(const hw_world* world);
+
+/* Hash of the whole world state, including the random generator; two runs
+ * that agree on it after every step have stayed identical */
+HW_EXPORT uint64_t hw_world_digest(const hw_world* world);
+
+/* Set a random plant on fire, or the plant at (q, r); 0 if there is none */
+HW_EXPORT int hw_world_start_fire(hw_world* world);
+HW_EXPORT int hw_world_ignite(hw_world* world, int32_t q, int32_t r);
+
+/* Place a founder with the default genome; its id, or 0 if the tile cannot
+ * hold it (hares, foxes and wolves need soil, salmon water, one hare per tile) */
+HW_EXPORT uint32_t hw_world_spawn(hw_world* world, hw_species species, int32_t q, int32_t r);
+
+HW_EXPORT size_t hw_animal_count(const hw_world* world, hw_species species);
+HW_EXPORT hw_view hw_animal_view(const hw_world* world, hw_species species, hw_animal_field field);
+
+/* Traits: hw_genome_trait_count per species, viewed by index. Quantized
+ * traits are u16 codes with offset and scale set to decode them. */
+HW_EXPORT uint32_t hw_genome_trait_count(hw_species species);
+HW_EXPORT hw_view hw_genome_view(const hw_world* world, hw_species species, uint32_t trait);
+
+/* Tiles (q, r) with |q|, |r| <= radius sit at index
+ * (q + radius + 1) * row + (r + radius + 1), row = 2 * radius + 3, with a
+ * border of empty cells; cells outside the hexagon are empty too. */
+HW_EXPORT int32_t hw_tile_radius(const hw_world* world);
+HW_EXPORT hw_view hw_tile_view(const hw_world* world, hw_tile_field field);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEXAWORLD_API_H */
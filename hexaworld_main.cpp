@@ -1,10 +1,25 @@
 #include "hex_grid_new.hpp"
 #include "sfml_renderer.hpp"
-#include "animals/hare.hpp"
-#include "animals/fox.hpp"
-#include "animals/wolf.hpp"
-#include "animals/salmon.hpp"
+#include "simulation.hpp"
+#include "agent_batch.hpp"
+#include "simulation_thread.hpp"
+#include "render_snapshot.hpp"
 #include "constants.hpp"
+#include "camera.hpp"
+#include "event_log.hpp"
+#include "recording.hpp"
+#include "replay.hpp"
+#include "sprite_easing.hpp"
+#include "hud.hpp"
+#include "plant_layer.hpp"
+#include "frame_builder.hpp"
+#include "population_graph.hpp"
+#include "frame_capture.hpp"
+#include "migration.hpp"
+#include "column_export.hpp"
+#include "world_map.hpp"
+#include "world_digest.hpp"
+#include "metrics.hpp"
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -17,6 +32,7 @@
 #include <utility>
 #include <set>
 #include <cmath>
+#include <memory>
 
 std::pair<unsigned int, std::string> get_seed() {
     if (const char* env_seed = std::getenv("HEXAWORLD_SEED")) {
@@ -44,12 +60,270 @@ bool get_maximized() {
     }
     return false; // Default to windowed
 }
+
+bool get_crossover() {
+    if (const char* env = std::getenv("HEXAWORLD_CROSSOVER")) {
+        std::string val(env);
+        return !(val == "0" || val == "false");
+    }
+    return false; // Default to single-parent births
+}
+
+float get_sim_speed() {
+    if (const char* env = std::getenv("HEXAWORLD_SIM_SPEED")) {
+        try {
+            return std::max(0.0f, std::stof(env));
+        } catch (const std::exception&) {
+            // Fallback to real time if invalid
+        }
+    }
+    return 1.0f; // Real time
+}
+
+// Milliseconds a tick may take before work is spread over several ticks;
+// defaults to the tick's share of real time at the given speed
+float get_tick_budget(float sim_speed) {
+    if (const char* env = std::getenv("HEXAWORLD_TICK_BUDGET_MS")) {
+        try {
+            return std::max(0.0f, std::stof(env)) / 1000.0f;
+        } catch (const std::exception&) {
+            // Fallback to the real-time budget if invalid
+        }
+    }
+    return sim_speed > 0.0f ? SIM_DT / sim_speed : 0.0f; // Unlimited speed has no deadline
+}
+
+float get_world_scale() {
+    if (const char* env = std::getenv("HEXAWORLD_WORLD_SCALE")) {
+        try {
+            return std::max(1.0f, std::stof(env));
+        } catch (const std::exception&) {
+            // Fallback to screen-sized world if invalid
+        }
+    }
+    return 1.0f; // World fills exactly one screen
+}
+
+EventLevel get_log_level() {
+    if (const char* env = std::getenv("HEXAWORLD_LOG_LEVEL")) {
+        EventLevel level;
+        if (event_level_from_name(env, level)) return level;
+    }
+    return LOG_INFO;
+}
+
+uint32_t get_log_categories() {
+    if (const char* env = std::getenv("HEXAWORLD_LOG_CATEGORIES")) {
+        // Comma separated names, unknown names are ignored
+        uint32_t mask = 0;
+        std::string list(env);
+        size_t start = 0;
+        while (start <= list.size()) {
+            size_t end = list.find(',', start);
+            if (end == std::string::npos) end = list.size();
+            uint32_t category;
+            if (event_category_from_name(list.substr(start, end - start), category)) mask |= category;
+            start = end + 1;
+        }
+        return mask;
+    }
+    return CATEGORY_ALL;
+}
+
+std::string get_log_file() {
+    if (const char* env = std::getenv("HEXAWORLD_LOG_FILE")) {
+        return env;
+    }
+    return ""; // stdout
+}
+
+EventFormat get_log_format() {
+    if (const char* env = std::getenv("HEXAWORLD_LOG_FORMAT")) {
+        if (std::string(env) == "binary") return FORMAT_BINARY;
+    }
+    return FORMAT_TEXT;
+}
+
+std::string get_record_file() {
+    if (const char* env = std::getenv("HEXAWORLD_RECORD")) {
+        return env;
+    }
+    return ""; // Not recording
+}
+
+std::string get_lineage_file() {
+    if (const char* env = std::getenv("HEXAWORLD_LINEAGE_FILE")) {
+        return env;
+    }
+    return ""; // Extinct lineages are discarded
+}
+
+std::string get_replay_file() {
+    if (const char* env = std::getenv("HEXAWORLD_REPLAY")) {
+        return env;
+    }
+    return ""; // Run the live simulation
+}
+std::string get_map_file() {
+    if (const char* env = std::getenv("HEXAWORLD_MAP")) {
+        return env;
+    }
+    return ""; // Generate a world from the seed
+}
+
+std::string get_capture_dir() {
+    if (const char* env = std::getenv("HEXAWORLD_CAPTURE_DIR")) {
+        return env;
+    }
+    return ""; // Not capturing
+}
+
+unsigned int get_capture_every() {
+    if (const char* env = std::getenv("HEXAWORLD_CAPTURE_EVERY")) {
+        try {
+            return std::max(1, std::stoi(env));
+        } catch (const std::exception&) {
+            // Fallback to every frame if invalid
+        }
+    }
+    return 1; // Every frame
+}
+
+CaptureFormat get_capture_format() {
+    if (const char* env = std::getenv("HEXAWORLD_CAPTURE_FORMAT")) {
+        if (std::string(env) == "ppm") return CAPTURE_PPM;
+    }
+    return CAPTURE_PNG;
+}
+
+std::string get_export_file() {
+    if (const char* env = std::getenv("HEXAWORLD_EXPORT")) {
+        return env;
+    }
+    return ""; // Not exporting
+}
+
+float get_export_interval() {
+    if (const char* env = std::getenv("HEXAWORLD_EXPORT_INTERVAL")) {
+        try {
+            return std::max(SIM_DT, std::stof(env));
+        } catch (const std::exception&) {
+            // Fallback to the default interval if invalid
+        }
+    }
+    return EXPORT_INTERVAL;
+}
+
+std::string get_digest_file() {
+    if (const char* env = std::getenv("HEXAWORLD_DIGEST_FILE")) {
+        return env;
+    }
+    return ""; // Not tracing
+}
+
+std::string get_metrics_endpoint() {
+    if (const char* env = std::getenv("HEXAWORLD_METRICS")) {
+        return env;
+    }
+    return ""; // No metrics endpoint
+}
+
+// Islands in a multi-process run (1 = this process runs alone)
+unsigned int get_islands() {
+    if (const char* env = std::getenv("HEXAWORLD_ISLANDS")) {
+        try {
+            return std::max(1, std::stoi(env));
+        } catch (const std::exception&) {
+            // Fallback to a single world if invalid
+        }
+    }
+    return 1;
+}
+
+unsigned int get_island() {
+    if (const char* env = std::getenv("HEXAWORLD_ISLAND")) {
+        try {
+            return std::max(0, std::stoi(env));
+        } catch (const std::exception&) {
+            // Fallback to the first island if invalid
+        }
+    }
+    return 0;
+}
+
+MigrationTopology get_migration_topology() {
+    if (const char* env = std::getenv("HEXAWORLD_MIGRATION_TOPOLOGY")) {
+        MigrationTopology topology;
+        if (migration_topology_from_name(env, topology)) return topology;
+    }
+    return TOPOLOGY_RING;
+}
+
+MigrationTransportKind get_migration_transport() {
+    if (const char* env = std::getenv("HEXAWORLD_MIGRATION_TRANSPORT")) {
+        MigrationTransportKind kind;
+        if (migration_transport_from_name(env, kind)) return kind;
+    }
+    return TRANSPORT_SHM;
+}
+
+std::vector<std::string> get_migration_peers() {
+    std::vector<std::string> peers;
+    if (const char* env = std::getenv("HEXAWORLD_MIGRATION_PEERS")) {
+        // Comma separated host:port, one per island in island order
+        std::string list(env);
+        size_t start = 0;
+        while (start < list.size()) {
+            size_t end = list.find(',', start);
+            if (end == std::string::npos) end = list.size();
+            if (end > start) peers.push_back(list.substr(start, end - start));
+            start = end + 1;
+        }
+    }
+    return peers; // Empty: localhost, one port per island
+}
+
+std::string get_migration_group() {
+    if (const char* env = std::getenv("HEXAWORLD_MIGRATION_GROUP")) {
+        return env;
+    }
+    return "hexaworld";
+}
+
+float get_migration_interval() {
+    if (const char* env = std::getenv("HEXAWORLD_MIGRATION_INTERVAL")) {
+        try {
+            return std::max(SIM_DT, std::stof(env));
+        } catch (const std::exception&) {
+            // Fallback to the default interval if invalid
+        }
+    }
+    return MIGRATION_INTERVAL;
+}
+
+unsigned int get_migrants() {
+    if (const char* env = std::getenv("HEXAWORLD_MIGRANTS")) {
+        try {
+            return std::max(0, std::stoi(env));
+        } catch (const std::exception&) {
+            // Fallback to the default batch size if invalid
+        }
+    }
+    return MIGRATION_MIGRANTS;
+}
+
 auto [seed_val, source] = get_seed();
-std::mt19937 gen(seed_val); // Fixed seed for repeatable simulation
 
 int main() {
     try {
+        // Islands of one run start from different worlds
+        unsigned int islands = get_islands();
+        unsigned int island = get_island();
         unsigned int seed = seed_val;
+        if (islands > 1) {
+            seed += island;
+        }
+        gen.seed(seed);  // Fixed seed for repeatable simulation
         std::cout << "Using seed: " << seed << " (from " << source << ")" << std::endl;
 
         bool frameless = get_frameless();
@@ -58,288 +332,184 @@ int main() {
         bool maximized = get_maximized();
         std::cout << "Maximized window: " << (maximized ? "yes" : "no") << " (set HEXAWORLD_MAXIMIZED=0 to disable)" << std::endl;
 
+        // Simulation events are written by a background thread
+        event_log.set_level(get_log_level());
+        event_log.set_categories(get_log_categories());
+        event_log.open(get_log_file(), get_log_format());
+        event_log.start();
+        std::cout << "Event log level: " << event_level_name(event_log.level()) << " (set HEXAWORLD_LOG_LEVEL, HEXAWORLD_LOG_CATEGORIES, HEXAWORLD_LOG_FILE, HEXAWORLD_LOG_FORMAT to change)" << std::endl;
+
         // Create renderer in windowed mode with antialiasing
         SFMLRenderer renderer(1280, 1024, "HexaWorld - Hexagonal Grid", false, frameless, maximized, 4);
         renderer.setFramerateLimit(60); // Limit FPS to reduce CPU usage
 
-        // Center the grid in the window
-        float center_x = renderer.getWidth() / 2.0f;
-        float center_y = renderer.getHeight() / 2.0f;
-
-        // Create hex grid
-        HexGrid hexGrid(HEX_SIZE);
-
-        // Set max grid distance based on vertical screen space
-        float hex_vertical_spacing = HEX_SIZE * SQRT3;
-        int max_dist = static_cast<int>(center_y / hex_vertical_spacing);
-        hexGrid.max_grid_distance = max_dist;
-
-        // Add center hexagon
-        hexGrid.add_hexagon(0, 0);
-
-        // Expand grid to fill screen by adding neighbors that fit fully
-        const float sqrt3 = SQRT3;
-        while (true) {
-            size_t old_size = hexGrid.hexagons.size();
-            hexGrid.create_neighbors();
-            // Remove hexagons that are not fully visible
-            for (auto it = hexGrid.hexagons.begin(); it != hexGrid.hexagons.end(); ) {
-                auto [x, y] = it->second;
-                float cx = x + center_x;
-                float cy = y + center_y;
-                float left = cx - HEX_SIZE;
-                float right = cx + HEX_SIZE;
-                float top = cy - HEX_SIZE * sqrt3 / 2.0f;
-                float bottom = cy + HEX_SIZE * sqrt3 / 2.0f;
-                if (left < 0 || right > renderer.getWidth() || top < 0 || bottom > renderer.getHeight()) {
-                    it = hexGrid.hexagons.erase(it);
-                } else {
-                    ++it;
-                }
-            }
-             if (hexGrid.hexagons.size() == old_size) break;
-          }
-
-          // Remove terrain and plants for removed hexagons
-          for (auto it = hexGrid.terrainTiles.begin(); it != hexGrid.terrainTiles.end(); ) {
-              if (hexGrid.hexagons.find(it->first) == hexGrid.hexagons.end()) {
-                  it = hexGrid.terrainTiles.erase(it);
-              } else {
-                  ++it;
-              }
-          }
-          for (auto it = hexGrid.plants.begin(); it != hexGrid.plants.end(); ) {
-              if (hexGrid.hexagons.find(it->first) == hexGrid.hexagons.end()) {
-                  it = hexGrid.plants.erase(it);
-              } else {
-                  ++it;
-              }
-          }
-
-        // Remove isolated water tiles
-       for (auto it = hexGrid.terrainTiles.begin(); it != hexGrid.terrainTiles.end(); ) {
-             auto [q, r] = it->first;
-             if (it->second.type == WATER) {
-                 bool has_water_neighbor = false;
-                 for (int dir = 0; dir < 6; ++dir) {
-                     auto [nq, nr] = hexGrid.get_neighbor_coords(q, r, dir);
-                     auto nit = hexGrid.terrainTiles.find({nq, nr});
-                     if (nit != hexGrid.terrainTiles.end() && nit->second.type == WATER) {
-                         has_water_neighbor = true;
-                         break;
-                     }
-                 }
-                 if (!has_water_neighbor) {
-                     it = hexGrid.terrainTiles.erase(it);
-                     continue;
-                 }
-             }
-             ++it;
+        // Replay mode plays a recording back instead of simulating
+        std::unique_ptr<ReplayPlayer> replay;
+        std::string replay_file = get_replay_file();
+        if (!replay_file.empty()) {
+            replay = std::make_unique<ReplayPlayer>(Recording::load(replay_file));
+            std::cout << "Replaying " << replay_file << ": ticks " << replay->first_tick() << " to " << replay->last_tick() << std::endl;
         }
 
-        // Log terrain counts
-        int soil_count = 0, water_count = 0, rock_count = 0;
-        for (const auto& [coord, tile] : hexGrid.terrainTiles) {
-            if (tile.type == SOIL) soil_count++;
-            else if (tile.type == WATER) water_count++;
-            else if (tile.type == ROCK) rock_count++;
+        // A baked map replaces generation and brings its own world size
+        std::unique_ptr<WorldMap> world_map;
+        std::string map_file = get_map_file();
+        if (!replay && !map_file.empty()) {
+            world_map = std::make_unique<WorldMap>(map_file);
         }
-         std::cout << "Terrain: SOIL " << soil_count << ", WATER " << water_count << ", ROCK " << rock_count << std::endl;
-
-          // Plants are now spawned in add_hexagon, but ensure some exist
-         std::vector<std::pair<int, int>> soil_coords;
-         // Add extra plants if needed
-         for (const auto& [coord, tile] : hexGrid.terrainTiles) {
-             if (tile.type == SOIL) {
-                 soil_coords.push_back(coord);
-             }
-         }
-          std::shuffle(soil_coords.begin(), soil_coords.end(), gen);
-          size_t num_mature = std::min<size_t>(soil_coords.size() / 2, soil_coords.size());
-          size_t num_sprouts = std::min<size_t>(soil_coords.size() / 4, soil_coords.size());
-          // Place mature plants first
-          for (size_t i = 0; i < num_mature; ++i) {
-              auto [q, r] = soil_coords[i];
-              hexGrid.plants.insert({{q, r}, Plant(q, r, PLANT, hexGrid.terrainTiles.at({q, r}).nutrients)});
-          }
-          // Then sprouts
-          for (size_t i = num_mature; i < num_mature + num_sprouts; ++i) {
-              auto [q, r] = soil_coords[i];
-              hexGrid.plants.insert({{q, r}, Plant(q, r, SPROUT, hexGrid.terrainTiles.at({q, r}).nutrients)});
-          }
-            // Then seeds
-            for (size_t i = num_mature + num_sprouts; i < soil_coords.size(); ++i) {
-                auto [q, r] = soil_coords[i];
-                hexGrid.plants.insert({{q, r}, Plant(q, r, SEED, hexGrid.terrainTiles.at({q, r}).nutrients)});
-            }
-
 
+        // World can be larger than the screen; the camera pans over it
+        float world_scale = get_world_scale();
+        float world_width = renderer.getWidth() * world_scale;
+        float world_height = renderer.getHeight() * world_scale;
+        if (replay) {
+            world_width = replay->recording().world_width;
+            world_height = replay->recording().world_height;
+        } else if (world_map) {
+            world_width = world_map->header().world_width;
+            world_height = world_map->header().world_height;
+        } else {
+            std::cout << "World scale: " << world_scale << "x screen (set HEXAWORLD_WORLD_SCALE to change)" << std::endl;
+        }
 
+        // Center the grid in the world
+        float center_x = world_width / 2.0f;
+        float center_y = world_height / 2.0f;
 
-          // Create a movable object
-        HexObject obj(0, 0);
-        auto last_move = std::chrono::steady_clock::now();
-        bool showObject = false;
+        // Generate the world and hand it to the simulation thread
+        Simulation sim(HEX_SIZE);
+        std::string lineage_file = get_lineage_file();
+        if (!replay && !lineage_file.empty()) {
+            sim.lineage.open_stream(lineage_file);
+            std::cout << "Writing lineage to " << lineage_file << std::endl;
+        }
+        if (!replay) {
+            sim.crossover_births = get_crossover();
+            std::cout << "Crossover births: " << (sim.crossover_births ? "yes" : "no") << " (set HEXAWORLD_CROSSOVER=1 to enable)" << std::endl;
+            if (world_map) {
+                sim.load_map(*world_map);
+                world_map.reset();  // Everything is copied out
+                std::cout << "Loaded map " << map_file << ": " << sim.grid.hexagons.size() << " hexagons" << std::endl;
+            } else {
+                sim.generate(world_width, world_height);
+            }
+        }
+        const HexGrid& hexGrid = replay ? replay->grid() : sim.grid;  // Terrain layout is immutable once generated
+
+        // Optionally record the run for later replay
+        std::unique_ptr<Recorder> recorder;
+        std::string record_file = get_record_file();
+        if (!replay && !record_file.empty()) {
+            recorder = std::make_unique<Recorder>(record_file);
+            recorder->begin(sim, world_width, world_height);
+            sim.recorder = recorder.get();
+            std::cout << "Recording to " << record_file << std::endl;
+        }
 
-        // Dashboard toggle
-        bool show_dashboard = false;
+        // Optionally dump agents and tiles for offline analysis
+        std::unique_ptr<ColumnExporter> exporter;
+        std::string export_file = get_export_file();
+        if (!replay && !export_file.empty()) {
+            float interval = get_export_interval();
+            exporter = std::make_unique<ColumnExporter>(export_file, static_cast<uint64_t>(std::lround(interval / SIM_DT)));
+            sim.exporter = exporter.get();
+            std::cout << "Exporting snapshots every " << interval << " s to " << export_file << " (set HEXAWORLD_EXPORT_INTERVAL to change)" << std::endl;
+        }
 
-        // Hare logging
-        bool enableHareLogging = true;
-        auto last_log = std::chrono::steady_clock::now();
-
-         // Population graph data
-         std::vector<int> hare_history;
-         std::vector<int> plant_history;
-         std::vector<int> salmon_history;
-         std::vector<int> fox_history;
-         std::vector<int> wolf_history;
-        float graph_timer = 0.0f;
-        const float GRAPH_UPDATE_INTERVAL = 1.0f; // Update every second
-        const size_t MAX_HISTORY = 1000;
-
-        // Console logging
-        float log_timer = 0.0f;
-        const float LOG_INTERVAL = 10.0f; // Log every 10 seconds
-
-        // Create hares on plant tiles
-        std::vector<Hare> hares;
-        std::vector<Salmon> salmons;
-        std::vector<Wolf> wolves;
-        std::vector<std::pair<int, int>> plant_coords;
-        for (const auto& [coord, plant] : hexGrid.plants) {
-            if (plant.stage == PLANT) {
-                plant_coords.push_back(coord);
-            }
+        // Optionally hash the world after every tick, for comparing runs and builds
+        std::unique_ptr<DigestTrace> digest_trace;
+        std::string digest_file = get_digest_file();
+        if (!replay && !digest_file.empty()) {
+            digest_trace = std::make_unique<DigestTrace>(digest_file);
+            sim.digest_trace = digest_trace.get();
+            std::cout << "Writing world digests to " << digest_file << std::endl;
         }
 
-        size_t grid_size = hexGrid.hexagons.size();
-        // Place hares at the 6 corners of the map
-        std::vector<std::pair<int, int>> corner_positions = {
-            {hexGrid.max_grid_distance, 0},
-            {hexGrid.max_grid_distance, -hexGrid.max_grid_distance},
-            {0, -hexGrid.max_grid_distance},
-            {-hexGrid.max_grid_distance, 0},
-            {-hexGrid.max_grid_distance, hexGrid.max_grid_distance},
-            {0, hexGrid.max_grid_distance}
-        };
-        for (auto [q, r] : corner_positions) {
-            if (hexGrid.has_hexagon(q, r) && hexGrid.get_terrain_type(q, r) == SOIL) {
-                hares.emplace_back(q, r);
-                // Randomize genome for initial population
-                std::uniform_real_distribution<float> thresh_dist(1.0f, 2.0f);
-                std::uniform_real_distribution<float> aggression_dist(0.0f, 1.0f);
-                std::uniform_real_distribution<float> weight_dist(0.5f, 1.5f);
-                std::uniform_real_distribution<float> fear_dist(0.0f, 1.0f);
-                std::uniform_real_distribution<float> efficiency_dist(0.5f, 1.5f);
-                hares.back().genome.reproduction_threshold = thresh_dist(gen);
-                hares.back().genome.movement_aggression = aggression_dist(gen);
-                hares.back().genome.weight = weight_dist(gen);
-                hares.back().genome.fear = fear_dist(gen);
-                hares.back().genome.movement_efficiency = efficiency_dist(gen);
-                hares.back().update_speed();
-                // Set position to avoid flying from center
-                auto [x, y] = hexGrid.axial_to_pixel(q, r);
-                hares.back().current_pos = sf::Vector2f(x, y);
-                hares.back().target_pos = sf::Vector2f(x, y);
-                hexGrid.hare_positions.insert({q, r});
-            }
+        // Optionally trade genomes with the other islands of a multi-process run
+        std::unique_ptr<Migration> migration;
+        if (!replay && islands > 1) {
+            MigrationConfig config;
+            config.group = get_migration_group();
+            config.island = island;
+            config.islands = islands;
+            config.topology = get_migration_topology();
+            config.transport = get_migration_transport();
+            config.peers = get_migration_peers();
+            config.interval = get_migration_interval();
+            config.migrants = get_migrants();
+            migration = std::make_unique<Migration>(config);
+            sim.migration = migration.get();
+            std::cout << "Island " << island << " of " << islands << ": " << migration->config().migrants << " per species every "
+                      << config.interval << " s, " << (config.topology == TOPOLOGY_RING ? "ring" : "all-to-all") << " over "
+                      << (config.transport == TRANSPORT_SOCKET ? "UDP" : "shared memory")
+                      << " (set HEXAWORLD_MIGRATION_TOPOLOGY, HEXAWORLD_MIGRATION_TRANSPORT, HEXAWORLD_MIGRATION_INTERVAL, HEXAWORLD_MIGRANTS to change)" << std::endl;
         }
 
-         // Create salmons on water tiles
-         std::vector<std::pair<int, int>> water_coords;
-         for (const auto& [coord, tile] : hexGrid.terrainTiles) {
-             if (tile.type == WATER) {
-                 water_coords.push_back(coord);
-             }
-         }
-         std::shuffle(water_coords.begin(), water_coords.end(), gen);
-         size_t num_salmons = std::max<size_t>(5, grid_size / 2000);
-         num_salmons = std::min(num_salmons, water_coords.size());
-          for (size_t i = 0; i < num_salmons; ++i) {
-              auto [q, r] = water_coords[i];
-              salmons.emplace_back(q, r);
-              // Set position to avoid flying from center
-              auto [x, y] = hexGrid.axial_to_pixel(q, r);
-              salmons.back().current_pos = sf::Vector2f(x, y);
-              salmons.back().target_pos = sf::Vector2f(x, y);
-          }
-
-         // Create foxes on soil tiles
-        std::vector<Fox> foxes;
-        std::vector<std::pair<int, int>> fox_soil_coords;
-        for (const auto& [coord, tile] : hexGrid.terrainTiles) {
-            if (tile.type == SOIL) {
-                fox_soil_coords.push_back(coord);
-            }
+        // Optionally serve live metrics for a monitoring system to scrape
+        Metrics metrics;
+        std::unique_ptr<MetricsServer> metrics_server;
+        std::string metrics_endpoint = get_metrics_endpoint();
+        if (!metrics_endpoint.empty()) {
+            metrics_server = std::make_unique<MetricsServer>(metrics, metrics_endpoint);
+            std::cout << "Serving metrics on " << metrics_endpoint << " at /metrics" << std::endl;
         }
-        std::shuffle(fox_soil_coords.begin(), fox_soil_coords.end(), gen);
-        size_t num_foxes = std::max<size_t>(2, grid_size / 1500);
-        num_foxes = std::min(num_foxes, fox_soil_coords.size());
-        for (size_t i = 0; i < num_foxes; ++i) {
-            auto [q, r] = fox_soil_coords[i];
-            foxes.emplace_back(q, r);
-            // Randomize genome for initial population
-            std::uniform_real_distribution<float> thresh_dist(2.5f, 4.5f);
-            std::uniform_real_distribution<float> aggression_dist(0.0f, 1.0f);
-            std::uniform_real_distribution<float> weight_dist(0.5f, 1.5f);
-            std::uniform_real_distribution<float> efficiency_dist(0.5f, 1.5f);
-            foxes.back().genome.reproduction_threshold = thresh_dist(gen);
-            foxes.back().genome.hunting_aggression = aggression_dist(gen);
-            foxes.back().genome.weight = weight_dist(gen);
-             foxes.back().genome.movement_efficiency = efficiency_dist(gen);
-              foxes.back().update_speed();
-              // Set position to avoid flying from center
-              auto [x, y] = hexGrid.axial_to_pixel(q, r);
-              foxes.back().current_pos = sf::Vector2f(x, y);
-              foxes.back().target_pos = sf::Vector2f(x, y);
-          }
-
-        // Create wolves on soil tiles
-        std::vector<std::pair<int, int>> wolf_soil_coords;
-        for (const auto& [coord, tile] : hexGrid.terrainTiles) {
-            if (tile.type == SOIL) {
-                wolf_soil_coords.push_back(coord);
-            }
+
+        float sim_speed = get_sim_speed();
+        float tick_budget = get_tick_budget(sim_speed);
+        SimulationThread sim_thread(sim, sim_speed, tick_budget);
+        if (metrics_server) {
+            sim_thread.metrics = &metrics;
         }
-        std::shuffle(wolf_soil_coords.begin(), wolf_soil_coords.end(), gen);
-        size_t num_wolves = std::max<size_t>(1, grid_size / 3000);
-        num_wolves = std::min(num_wolves, wolf_soil_coords.size());
-        for (size_t i = 0; i < num_wolves; ++i) {
-            auto [q, r] = wolf_soil_coords[i];
-            wolves.emplace_back(q, r);
-            // Randomize genome for initial population
-            std::uniform_real_distribution<float> thresh_dist(5.0f, 7.0f);
-            std::uniform_real_distribution<float> aggression_dist(0.0f, 1.0f);
-            std::uniform_real_distribution<float> weight_dist(0.5f, 1.5f);
-            std::uniform_real_distribution<float> efficiency_dist(0.5f, 1.5f);
-            wolves.back().genome.reproduction_threshold = thresh_dist(gen);
-            wolves.back().genome.hunting_aggression = aggression_dist(gen);
-            wolves.back().genome.weight = weight_dist(gen);
-             wolves.back().genome.movement_efficiency = efficiency_dist(gen);
-             wolves.back().update_speed();
-             // Set position to avoid flying from center
-             auto [x, y] = hexGrid.axial_to_pixel(q, r);
-             wolves.back().current_pos = sf::Vector2f(x, y);
-             wolves.back().target_pos = sf::Vector2f(x, y);
-         }
-
-        // Initial brightness center on hares
-        float brightness_center_q = 0, brightness_center_r = 0;
-        int alive_count = 0;
-        for (const auto& hare : hares) {
-            if (hare.energy > 0) {
-                brightness_center_q += hare.q;
-                brightness_center_r += hare.r;
-                alive_count++;
-            }
+        if (!replay) {
+            std::cout << "Simulation speed: " << (sim_speed > 0.0f ? std::to_string(sim_speed) + "x" : std::string("unlimited")) << " (set HEXAWORLD_SIM_SPEED to change)" << std::endl;
+            std::cout << "Tick budget: " << (tick_budget > 0.0f ? std::to_string(tick_budget * 1000.0f) + " ms" : std::string("none")) << " (set HEXAWORLD_TICK_BUDGET_MS to change)" << std::endl;
+            std::cout << "Batch kernels: " << batch_instruction_set() << std::endl;
+            std::cout << "Bytes per agent: hare " << sizeof(Hare) << ", fox " << sizeof(Fox) << ", wolf " << sizeof(Wolf)
+                      << ", salmon " << sizeof(Salmon) << " (no per-agent heap storage)" << std::endl;
+            sim_thread.start();
         }
-        bool has_alive_hares = alive_count > 0;
-        if (has_alive_hares) {
-            brightness_center_q /= alive_count;
-            brightness_center_r /= alive_count;
+
+        // Optionally write rendered frames to disk for a video
+        std::unique_ptr<FrameCapture> capture;
+        std::string capture_dir = get_capture_dir();
+        if (!capture_dir.empty()) {
+            unsigned int every = get_capture_every();
+            capture = std::make_unique<FrameCapture>(capture_dir, get_capture_format(), every);
+            std::cout << "Capturing every " << every << " frame(s) to " << capture_dir << " (V pauses)" << std::endl;
         }
 
+        // Create a movable object
+        HexObject obj(0, 0);
+        std::mt19937 object_rng(seed);  // Render thread must not share the simulation RNG
+        auto last_move = std::chrono::steady_clock::now();
+        bool showObject = false;
+
+        // Dashboard toggle
+        bool show_dashboard = false;
+
+        // Camera starts showing the world center at 1:1
+        Camera camera;
+        const ViewRect world_bounds = {-center_x, -center_y, center_x, center_y};
+        camera.min_zoom = std::min({1.0f, renderer.getWidth() / world_width, renderer.getHeight() / world_height}) * 0.25f;
+
+        // Per-frame drawing state, reused between frames
+        sf::VertexArray lod_markers(sf::PrimitiveType::Triangles);
+        SpriteEasing sprite_easing;  // Drawn positions, eased between frames
+        PlantLayer plant_layer(hexGrid);  // Plants and fires, redrawn only where they changed
+        FrameBuilder frame_builder;       // Full-detail terrain and animals, built in parallel
+
+        // Dashboard text, re-laid out only when the numbers behind it change
+        HudLayer hud(renderer.getFont());
+        std::vector<float> hud_stats, hud_stats_shown;
+
+        // Population graph: hares, foxes, wolves and salmon on a log scale, plants linear
+        PopulationGraph population_graph(MAX_HISTORY);
+        population_graph.add_series(sf::Color(128, 128, 128), true);  // Hares (gray)
+        population_graph.add_series(sf::Color(0, 100, 0), false);     // Plants (mature plant color: dark green)
+        population_graph.add_series(sf::Color(0, 100, 255), true);    // Salmon (blue)
+        population_graph.add_series(sf::Color(255, 140, 0), true);    // Foxes (orange)
+        population_graph.add_series(sf::Color(0, 0, 0), true);        // Wolves (black)
+
         // Main render loop
         while (!renderer.shouldClose()) {
             // Handle events
@@ -358,6 +528,33 @@ int main() {
                 break;
             }
 
+            // Camera: arrows pan, mouse wheel or +/- zoom, Home resets
+            float frame_dt = renderer.getDeltaTime();
+            if (metrics_server) {
+                metrics.record_frame(frame_dt);
+            }
+            float pan_x = 0.0f, pan_y = 0.0f;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Left)) pan_x -= 1.0f;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Right)) pan_x += 1.0f;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Up)) pan_y -= 1.0f;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::Down)) pan_y += 1.0f;
+            camera.pan(pan_x * CAMERA_PAN_SPEED * frame_dt, pan_y * CAMERA_PAN_SPEED * frame_dt);
+            float wheel = renderer.consumeWheelDelta();
+            if (wheel != 0.0f) {
+                sf::Vector2i mouse = renderer.getMousePosition();
+                camera.zoom_at(std::pow(CAMERA_ZOOM_STEP, wheel), mouse.x, mouse.y, renderer.getWidth(), renderer.getHeight());
+            }
+            if (renderer.getLastKey() == sf::Keyboard::Key::Equal || renderer.getLastKey() == sf::Keyboard::Key::Add) {
+                camera.zoom_at(CAMERA_ZOOM_STEP, renderer.getWidth() / 2.0f, renderer.getHeight() / 2.0f, renderer.getWidth(), renderer.getHeight());
+            }
+            if (renderer.getLastKey() == sf::Keyboard::Key::Hyphen || renderer.getLastKey() == sf::Keyboard::Key::Subtract) {
+                camera.zoom_at(1.0f / CAMERA_ZOOM_STEP, renderer.getWidth() / 2.0f, renderer.getHeight() / 2.0f, renderer.getWidth(), renderer.getHeight());
+            }
+            if (renderer.getLastKey() == sf::Keyboard::Key::Home) {
+                camera = Camera{0.0f, 0.0f, 1.0f, camera.min_zoom, camera.max_zoom};
+            }
+            camera.clamp_to(world_bounds);
+
             // Check for 'c' key to toggle object visibility
             if (renderer.getLastKey() == sf::Keyboard::Key::C) {
                 showObject = !showObject;
@@ -378,13 +575,7 @@ int main() {
             static bool fPressed = false;
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::F)) {
                 if (!fPressed) {
-                    if (!hexGrid.plants.empty()) {
-                        auto it = hexGrid.plants.begin();
-                        std::advance(it, gen() % hexGrid.plants.size());
-                        auto [fq, fr] = it->first;
-                        hexGrid.fire_timers[{fq, fr}] = 5.0f;
-                        std::cout << "Fire started at (" << fq << ", " << fr << ")" << std::endl;
-                    }
+                    sim_thread.request_fire();
                     fPressed = true;
                 }
             } else {
@@ -395,589 +586,167 @@ int main() {
             static bool gPressed = false;
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::G)) {
                 if (!gPressed) {
-                    std::cout << "Current hare genomes:" << std::endl;
-                    for (const auto& hare : hares) {
-                        if (!hare.is_dead) {
-                            std::cout << "Hare at (" << hare.q << "," << hare.r << "): reproduction_threshold = " << hare.genome.reproduction_threshold << ", movement_aggression = " << hare.genome.movement_aggression << ", weight = " << hare.genome.weight << ", speed = " << hare.speed << std::endl;
-                        }
-                    }
+                    sim_thread.request_genome_log();
                     gPressed = true;
                 }
             } else {
                 gPressed = false;
             }
 
-             // Update plant growth
-             float dt = renderer.getDeltaTime();
-             for (auto& [coord, plant] : hexGrid.plants) {
-                 plant.growth_time += dt;
-
-                 // Charred plants regrow after 30 seconds
-                 if (plant.stage == CHARRED) {
-                     if (plant.growth_time >= 30.0f) {
-                         plant.stage = SEED;
-                         plant.growth_time = 0.0f;
-                     }
-                     continue; // Skip normal growth processing
-                 }
-
-                 float threshold = 20.0f / (plant.nutrients + 0.1f); // Slower growth
-                 if (plant.growth_time >= threshold) {
-                     if (plant.stage < PLANT) {
-                         plant.stage = static_cast<PlantStage>(plant.stage + 1);
-                     }
-                     plant.growth_time = 0.0f;
-                 }
-
-                 // Mature plants drop seeds randomly
-                 if (plant.stage == PLANT) {
-                     plant.drop_time += dt;
-                     if (plant.drop_time >= 10.0f) { // Every 10 seconds
-                         if ((gen() % 100) < 20) { // 20% chance
-                             // Drop seeds in soil neighbors without plants
-                             for (int dir = 0; dir < 6; ++dir) {
-                                 auto [nq, nr] = hexGrid.get_neighbor_coords(plant.q, plant.r, dir);
-                                 if (hexGrid.has_hexagon(nq, nr) &&
-                                     hexGrid.get_terrain_type(nq, nr) == SOIL &&
-                                     !hexGrid.get_plant(nq, nr)) {
-                                     auto tit = hexGrid.terrainTiles.find({nq, nr});
-                                     float nutrients = (tit != hexGrid.terrainTiles.end()) ? tit->second.nutrients : 0.5f;
-                                     hexGrid.plants.insert({{nq, nr}, Plant(nq, nr, SEED, nutrients)});
-                                 }
-                             }
-                         }
-                         plant.drop_time = 0.0f;
-                     }
-                 }
-             }
-
-             // Update fires
-             for (auto it = hexGrid.fire_timers.begin(); it != hexGrid.fire_timers.end(); ) {
-                 it->second -= dt;
-                 if (it->second <= 0) {
-                     auto coord = it->first;
-                     // Burn the plant - set to CHARRED state
-                     auto plant_it = hexGrid.plants.find(coord);
-                     if (plant_it != hexGrid.plants.end()) {
-                         plant_it->second.stage = CHARRED;
-                         plant_it->second.growth_time = 0.0f; // Reset growth timer
-                     }
-                     it = hexGrid.fire_timers.erase(it);
-                 } else {
-                     ++it;
-                 }
-             }
-
-             // Start fire if many plants (very unlikely)
-             if (hexGrid.plants.size() > 50 && (gen() % 10000) == 0) {
-                 // Pick random plant
-                 auto it = hexGrid.plants.begin();
-                 std::advance(it, gen() % hexGrid.plants.size());
-                 auto [q, r] = it->first;
-                 hexGrid.fire_timers[{q, r}] = 5.0f;
-             }
-
-             // Spread fire to adjacent plants (every 2 seconds)
-             static float fire_spread_timer = 0.0f;
-             fire_spread_timer += dt;
-             if (fire_spread_timer >= 2.0f) {
-                 std::set<std::pair<int, int>> new_fires;
-                 for (auto& [coord, timer] : hexGrid.fire_timers) {
-                     auto [q, r] = coord;
-                     for (int dir = 0; dir < 6; ++dir) {
-                         auto [nq, nr] = hexGrid.get_neighbor_coords(q, r, dir);
-                         auto neighbor_plant = hexGrid.plants.find({nq, nr});
-                         // Only spread to non-charred plants that aren't already burning
-                         if (neighbor_plant != hexGrid.plants.end() &&
-                             neighbor_plant->second.stage != CHARRED &&
-                             hexGrid.fire_timers.find({nq, nr}) == hexGrid.fire_timers.end()) {
-                             new_fires.insert({nq, nr});
-                         }
-                     }
-                 }
-             for (auto& coord : new_fires) {
-                 hexGrid.fire_timers[coord] = 5.0f;
-             }
-                 fire_spread_timer -= 2.0f; // or = 0.0f
-             }
-
-              // Update hares
-              for (auto& hare : hares) {
-                  hare.update(hexGrid, foxes, dt, gen);
-              }
-
-              // Update salmons
-              for (auto& salmon : salmons) {
-                  salmon.update(hexGrid, dt, gen);
-              }
-
-              // Update foxes
-              for (auto& fox : foxes) {
-                  fox.update(hexGrid, hares, foxes, dt, gen);
-              }
-
-              // Update wolves
-              for (auto& wolf : wolves) {
-                  wolf.update(hexGrid, hares, foxes, dt, gen);
-              }
-
-             // Animals die in fire
-             for (auto& hare : hares) {
-                  if (!hare.is_dead && hexGrid.fire_timers.find({hare.q, hare.r}) != hexGrid.fire_timers.end()) {
-                      hare.is_dead = true;
-                      std::cout << "Hare died at (" << hare.q << ", " << hare.r << "), burned" << std::endl;
-                  }
-             }
-             for (auto& salmon : salmons) {
-                  if (!salmon.is_dead && hexGrid.fire_timers.find({salmon.q, salmon.r}) != hexGrid.fire_timers.end()) {
-                      salmon.is_dead = true;
-                      std::cout << "Salmon died at (" << salmon.q << ", " << salmon.r << "), burned" << std::endl;
-                  }
-             }
-             for (auto& fox : foxes) {
-                  if (!fox.is_dead && hexGrid.fire_timers.find({fox.q, fox.r}) != hexGrid.fire_timers.end()) {
-                      fox.is_dead = true;
-                      std::cout << "Fox died at (" << fox.q << ", " << fox.r << "), burned" << std::endl;
-                  }
-             }
-             for (auto& wolf : wolves) {
-                  if (!wolf.is_dead && hexGrid.fire_timers.find({wolf.q, wolf.r}) != hexGrid.fire_timers.end()) {
-                      wolf.is_dead = true;
-                      std::cout << "Wolf died at (" << wolf.q << ", " << wolf.r << "), burned" << std::endl;
-                  }
-             }
-
-              // Handle hare birth
-              for (auto& hare : hares) {
-                  if (hare.ready_to_give_birth) {
-                      // Find a free neighbor for birth
-                      std::vector<std::pair<int, int>> free_neighbors;
-                      for (int dir = 0; dir < 6; ++dir) {
-                          auto [nq, nr] = hexGrid.get_neighbor_coords(hare.q, hare.r, dir);
-                          if (hexGrid.has_hexagon(nq, nr) && hexGrid.hare_positions.find({nq, nr}) == hexGrid.hare_positions.end()) {
-                              free_neighbors.push_back({nq, nr});
-                          }
-                      }
-                      if (!free_neighbors.empty()) {
-                          std::uniform_int_distribution<> dis(0, free_neighbors.size() - 1);
-                          auto [bq, br] = free_neighbors[dis(gen)];
-                          hares.push_back(Hare(bq, br));
-                          hares.back().genome = hare.genome.mutate(gen);
-                          hares.back().energy = 0.5f; // Lower starting energy for evolutionary pressure
-                          // Set position
-                          auto [x, y] = hexGrid.axial_to_pixel(bq, br);
-                          hares.back().current_pos = sf::Vector2f(x, y);
-                          hares.back().target_pos = sf::Vector2f(x, y);
-                          hexGrid.hare_positions.insert({bq, br});
-                          hare.ready_to_give_birth = false;
-                          if (enableHareLogging) {
-                              // std::cout << "Hare gave birth at (" << bq << ", " << br << ")" << std::endl;
-                          }
-                      }
-                  }
-              }
-
-              // Handle salmon birth
-              for (auto& salmon : salmons) {
-                  if (salmon.ready_to_give_birth) {
-                      // Create offspring at same position
-                      salmons.push_back(Salmon(salmon.q, salmon.r));
-                      salmons.back().energy = 0.5f;
-                      // Set position to avoid flying from center
-                      auto [x, y] = hexGrid.axial_to_pixel(salmons.back().q, salmons.back().r);
-                      salmons.back().current_pos = sf::Vector2f(x, y);
-                      salmons.back().target_pos = sf::Vector2f(x, y);
-                      salmon.ready_to_give_birth = false;
-                  }
-              }
-
-             // Handle fox birth
-             for (auto& fox : foxes) {
-                 if (fox.ready_to_give_birth) {
-                     // Create offspring at same position
-                     foxes.push_back(Fox(fox.q, fox.r));
-                     foxes.back().genome = fox.genome.mutate(gen);
-                     foxes.back().energy = 1.5f; // Starting energy for offspring
-                     // Set position to avoid flying from center
-                     auto [x, y] = hexGrid.axial_to_pixel(foxes.back().q, foxes.back().r);
-                     foxes.back().current_pos = sf::Vector2f(x, y);
-                     foxes.back().target_pos = sf::Vector2f(x, y);
-                     fox.ready_to_give_birth = false;
-                     std::cout << "Fox gave birth at (" << fox.q << ", " << fox.r << ")" << std::endl;
-                 }
-             }
-
-             // Handle wolf birth
-             for (auto& wolf : wolves) {
-                 if (wolf.ready_to_give_birth) {
-                     // Create offspring at same position
-                     wolves.push_back(Wolf(wolf.q, wolf.r));
-                     wolves.back().genome = wolf.genome.mutate(gen);
-                     wolves.back().energy = 4.0f; // Starting energy for offspring
-                     // Set position to avoid flying from center
-                     auto [x, y] = hexGrid.axial_to_pixel(wolves.back().q, wolves.back().r);
-                     wolves.back().current_pos = sf::Vector2f(x, y);
-                     wolves.back().target_pos = sf::Vector2f(x, y);
-                     wolf.ready_to_give_birth = false;
-                     std::cout << "Wolf gave birth at (" << wolf.q << ", " << wolf.r << ")" << std::endl;
-                 }
-             }
-
-             // Update population graph
-             graph_timer += dt;
-             if (graph_timer >= GRAPH_UPDATE_INTERVAL) {
-                 hare_history.push_back(hares.size());
-                 plant_history.push_back(hexGrid.plants.size());
-                 salmon_history.push_back(salmons.size());
-                 fox_history.push_back(foxes.size());
-                 wolf_history.push_back(wolves.size());
-                 if (hare_history.size() > MAX_HISTORY) {
-                     hare_history.erase(hare_history.begin());
-                     plant_history.erase(plant_history.begin());
-                     salmon_history.erase(salmon_history.begin());
-                     fox_history.erase(fox_history.begin());
-                     wolf_history.erase(wolf_history.begin());
-                 }
-                 graph_timer = 0.0f;
-             }
-
-             // Console logging
-             log_timer += dt;
-             if (log_timer >= LOG_INTERVAL) {
-                 std::cout << "Populations - Hares: " << hares.size() << ", Plants: " << hexGrid.plants.size() << ", Salmons: " << salmons.size() << ", Foxes: " << foxes.size() << ", Wolves: " << wolves.size() << std::endl;
-                 log_timer = 0.0f;
-             }
-
-              // Remove dead hares
-              for (const auto& h : hares) {
-                  if (h.is_dead) {
-                      hexGrid.hare_positions.erase({h.q, h.r});
-                  }
-              }
-              hares.erase(std::remove_if(hares.begin(), hares.end(), [](const Hare& h) {
-                  return h.is_dead;
-              }), hares.end());
-
-             // Remove dead salmons
-             salmons.erase(std::remove_if(salmons.begin(), salmons.end(), [](const Salmon& s) {
-                 return s.is_dead;
-             }), salmons.end());
-
-             // Remove dead foxes
-             foxes.erase(std::remove_if(foxes.begin(), foxes.end(), [](const Fox& f) {
-                 return f.is_dead;
-             }), foxes.end());
+            // Check for 'l' key to cycle the event log level (one-shot per press)
+            static bool lPressed = false;
+            if (sf::Keyboard::isKeyPressed(sf::Keyboard::Key::L)) {
+                if (!lPressed) {
+                    EventLevel next = static_cast<EventLevel>((event_log.level() + 1) % (LOG_OFF + 1));
+                    event_log.set_level(next);
+                    std::cout << "Event log level: " << event_level_name(next) << std::endl;
+                    lPressed = true;
+                }
+            } else {
+                lPressed = false;
+            }
 
-             // Remove dead wolves
-             wolves.erase(std::remove_if(wolves.begin(), wolves.end(), [](const Wolf& w) {
-                 return w.is_dead;
-             }), wolves.end());
+            // Check for 'v' key to pause or resume frame capture
+            if (capture && renderer.getLastKey() == sf::Keyboard::Key::V) {
+                capture->paused = !capture->paused;
+                std::cout << "Frame capture " << (capture->paused ? "paused" : "resumed") << std::endl;
+            }
 
+            // Replay controls: space pauses, [ and ] change speed, comma and period seek
+            if (replay) {
+                sf::Keyboard::Key key = renderer.getLastKey();
+                if (key == sf::Keyboard::Key::Space) {
+                    replay->paused = !replay->paused;
+                } else if (key == sf::Keyboard::Key::LBracket) {
+                    replay->speed = std::max(0.25f, replay->speed / 2.0f);
+                } else if (key == sf::Keyboard::Key::RBracket) {
+                    replay->speed = std::min(REPLAY_MAX_SPEED, replay->speed * 2.0f);
+                } else if (key == sf::Keyboard::Key::Comma || key == sf::Keyboard::Key::Period) {
+                    int64_t step = static_cast<int64_t>(REPLAY_SEEK_STEP / SIM_DT) * (key == sf::Keyboard::Key::Comma ? -1 : 1);
+                    int64_t target = static_cast<int64_t>(replay->tick()) + step;
+                    replay->seek(static_cast<uint64_t>(std::max<int64_t>(0, target)));
+                }
+            }
 
+            // Latest state published by the simulation thread, or the replay
+            RenderSnapshot& snapshot = replay ? replay->advance(frame_dt) : sim_thread.latest_snapshot();
 
             // Move object randomly every second
             if (showObject) {
                 auto now = std::chrono::steady_clock::now();
                 if (now - last_move > std::chrono::seconds(1)) {
                     std::uniform_int_distribution<> dis(0, 5);
-                    int dir = dis(gen);
+                    int dir = dis(object_rng);
                     obj.move(dir);
                     last_move = now;
                 }
             }
 
-            // Calculate brightness center based on alive animals
-            float brightness_center_q = 0, brightness_center_r = 0;
-            int alive_count = 0;
-            for (const auto& hare : hares) {
-                if (!hare.is_dead) {
-                    brightness_center_q += hare.q;
-                    brightness_center_r += hare.r;
-                    alive_count++;
-                }
-            }
-            for (const auto& fox : foxes) {
-                if (!fox.is_dead) {
-                    brightness_center_q += fox.q;
-                    brightness_center_r += fox.r;
-                    alive_count++;
-                }
-            }
-            for (const auto& wolf : wolves) {
-                if (!wolf.is_dead) {
-                    brightness_center_q += wolf.q;
-                    brightness_center_r += wolf.r;
-                    alive_count++;
-                }
-            }
-            bool has_alive_animals = alive_count > 0;
-            if (has_alive_animals) {
-                brightness_center_q /= alive_count;
-                brightness_center_r /= alive_count;
-            }
-
             // Clear screen
             renderer.clear(20, 20, 30); // Dark blue background
 
+            // World drawing goes through the camera; only what intersects the view is drawn
+            renderer.setCameraView(center_x + camera.x, center_y + camera.y, camera.zoom);
+            const ViewRect visible = camera.visible_rect(renderer.getWidth(), renderer.getHeight());
+            const ViewRect entity_view = visible.expanded(HEX_SIZE * 2.0f); // Sprites overhang their hex
+            const DetailLevel detail = camera.detail_level();
+            sprite_easing.apply(snapshot, hexGrid, entity_view);  // Only the sprites near the view
+
+            // Zoomed out, entities become colored tiles or single points batched in one array
+            lod_markers.clear();
+            const float marker_size = (detail == DETAIL_MINIMAL) ? 1.5f / camera.zoom : HEX_SIZE * 0.4f;
+            auto append_marker = [&](float x, float y, float half_size, sf::Color color) {
+                sf::Vector2f tl(x - half_size, y - half_size), tr(x + half_size, y - half_size);
+                sf::Vector2f bl(x - half_size, y + half_size), br(x + half_size, y + half_size);
+                lod_markers.append(sf::Vertex{tl, color});
+                lod_markers.append(sf::Vertex{tr, color});
+                lod_markers.append(sf::Vertex{br, color});
+                lod_markers.append(sf::Vertex{tl, color});
+                lod_markers.append(sf::Vertex{br, color});
+                lod_markers.append(sf::Vertex{bl, color});
+            };
+
             // Draw hexagons
-            hexGrid.draw(renderer,
-                          100, 150, 200,  // Light blue fill
-                          255, 255, 255,  // White outline
-                          center_x, center_y,
-                          renderer.getWidth(), renderer.getHeight(),
-                          brightness_center_q, brightness_center_r,
-                          has_alive_animals);
-
-             // Draw plants as bushes (overlapping circles)
-             for (const auto& [coord, plant] : hexGrid.plants) {
-                 auto [px, py] = hexGrid.axial_to_pixel(plant.q, plant.r);
-                 float plant_x = px + center_x;
-                 float plant_y = py + center_y;
-                 uint8_t base_r, base_g, base_b;
-                 int num_circles = 1;
-                 float base_radius = 2.0f;
-
-                 switch (plant.stage) {
-                     case SEED:
-                         base_r = 139; base_g = 69; base_b = 19; // Brown seed
-                         num_circles = 2;
-                         base_radius = 2.0f;
-                         break;
-                     case SPROUT:
-                         base_r = 34; base_g = 139; base_b = 34; // Forest green sprout
-                         num_circles = 4;
-                         base_radius = 3.0f;
-                         break;
-                     case PLANT:
-                         base_r = 0; base_g = 100; base_b = 0; // Dark green plant
-                         num_circles = 7;
-                         base_radius = 4.0f;
-                         break;
-                     case CHARRED:
-                         base_r = 40; base_g = 40; base_b = 40; // Dark grey charred remains
-                         num_circles = 5;
-                         base_radius = 3.0f;
-                         break;
-                 }
-
-                 // Use deterministic random based on position for consistent bush shape
-                 std::mt19937 bush_gen(plant.q * 1000 + plant.r);
-                 std::uniform_real_distribution<float> offset_dist(-base_radius * 0.6f, base_radius * 0.6f);
-                 std::uniform_real_distribution<float> size_dist(0.7f, 1.3f);
-
-                 // Draw overlapping circles to create bush effect
-                 for (int i = 0; i < num_circles; ++i) {
-                     float offset_x = offset_dist(bush_gen);
-                     float offset_y = offset_dist(bush_gen);
-                     float size_mult = size_dist(bush_gen);
-                     float radius = base_radius * size_mult;
-
-                     // Vary color slightly for depth
-                     int color_var = (bush_gen() % 40) - 20;
-                     uint8_t r = std::clamp(base_r + color_var, 0, 255);
-                     uint8_t g = std::clamp(base_g + color_var, 0, 255);
-                     uint8_t b = std::clamp(base_b + color_var, 0, 255);
-
-                     renderer.drawCircle(plant_x + offset_x, plant_y + offset_y, radius, r, g, b, 255);
-                 }
-             }
+            if (detail == DETAIL_FULL) {
+                frame_builder.draw_terrain(*renderer.getWindow(), hexGrid, renderer, visible, camera.zoom,
+                                           center_x, center_y,
+                                           snapshot.brightness_center_q, snapshot.brightness_center_r,
+                                           snapshot.has_alive_animals);
+            } else {
+                hexGrid.draw(renderer,
+                              100, 150, 200,  // Light blue fill
+                              255, 255, 255,  // White outline
+                              center_x, center_y,
+                              visible, detail,
+                              snapshot.brightness_center_q, snapshot.brightness_center_r,
+                              snapshot.has_alive_animals);
+            }
 
-             // Draw fires
-             for (const auto& [coord, timer] : hexGrid.fire_timers) {
-                 auto [px, py] = hexGrid.axial_to_pixel(coord.first, coord.second);
-                 float fire_x = px + center_x;
-                 float fire_y = py + center_y;
-                 // Scale based on burn time (grows as it burns)
-                 float scale = 0.5f + 0.5f * ((5.0f - timer) / 5.0f);
-                 // Base circle
-                 renderer.drawCircle(fire_x, fire_y - HEX_SIZE / 2 + 3 * scale, 3.0f * scale, 255, 50, 0, 255); // Red circle at base
-                 // Outer flame triangle
-                 sf::ConvexShape flame(3);
-                 flame.setPoint(0, sf::Vector2f(fire_x, fire_y - HEX_SIZE / 2));
-                 flame.setPoint(1, sf::Vector2f(fire_x - 6 * scale, fire_y - HEX_SIZE * scale));
-                 flame.setPoint(2, sf::Vector2f(fire_x + 6 * scale, fire_y - HEX_SIZE * scale));
-                 flame.setFillColor(sf::Color(255, 100, 0)); // Orange
-                 renderer.getWindow()->draw(flame);
-                 // Inner yellow triangle
-                 sf::ConvexShape inner_flame(3);
-                 inner_flame.setPoint(0, sf::Vector2f(fire_x, fire_y - HEX_SIZE / 2 + 2 * scale));
-                 inner_flame.setPoint(1, sf::Vector2f(fire_x - 3 * scale, fire_y - HEX_SIZE * 0.8f * scale));
-                 inner_flame.setPoint(2, sf::Vector2f(fire_x + 3 * scale, fire_y - HEX_SIZE * 0.8f * scale));
-                 inner_flame.setFillColor(sf::Color(255, 200, 0)); // Yellow
-                 renderer.getWindow()->draw(inner_flame);
+             // Plants and fires: cached chunks up close, markers zoomed out
+             plant_layer.sync(snapshot);
+             if (detail == DETAIL_FULL) {
+                 plant_layer.draw(*renderer.getWindow(), snapshot, visible, camera.zoom, center_x, center_y);
+             } else {
+                 hexGrid.for_each_in_rect(visible, [&](int tile_q, int tile_r, float px, float py) {
+                     const PlantSprite* plant = snapshot.plant_at(tile_q, tile_r);
+                     if (!plant) return;
+                     sf::Color color;
+                     float base_radius = 2.0f;
+                     switch (plant->stage) {
+                         case SEED: color = sf::Color(139, 69, 19); base_radius = 2.0f; break;    // Brown seed
+                         case SPROUT: color = sf::Color(34, 139, 34); base_radius = 3.0f; break;  // Forest green sprout
+                         case PLANT: color = sf::Color(0, 100, 0); base_radius = 4.0f; break;     // Dark green plant
+                         case CHARRED: color = sf::Color(40, 40, 40); base_radius = 3.0f; break;  // Dark grey charred remains
+                     }
+                     append_marker(px + center_x, py + center_y, detail == DETAIL_MINIMAL ? marker_size : base_radius, color);
+                 });
+                 snapshot.for_each_fire_in(hexGrid, visible, [&](const FireSprite& fire) {
+                     auto [px, py] = hexGrid.axial_to_pixel(fire.q, fire.r);
+                     append_marker(px + center_x, py + center_y, marker_size, sf::Color(255, 100, 0));
+                 });
              }
 
-               // Draw hares
-               for (const auto& hare : hares) {
-                   float hare_x = hare.current_pos.x + center_x;
-                   float hare_y = hare.current_pos.y + center_y;
-                  sf::Color color = hare.getColor();
-                  // Scale based on energy (newborns start small but visible)
-                  float scale = std::max(0.8f, std::min(hare.energy / 1.0f, 1.0f));
-                   float head_size = 4.0f * scale;
-                   float ear_width = 1.5f * scale;
-                   float ear_height = 4.0f * scale; // Longer ears
-                   float eye_size = 0.8f * scale;
-                   float ear_offset_x = 2.0f * scale;
-                   float ear_offset_y = 4.0f * scale;
-                   float eye_offset = 1.5f * scale;
-                   // Draw hare as precomputed sprite
-                   renderer.drawSprite(hare_x, hare_y, color, renderer.getHareSprite(), scale);
-              }
-
-               // Draw salmons
-               for (const auto& salmon : salmons) {
-                   float salmon_x = salmon.current_pos.x + center_x;
-                   float salmon_y = salmon.current_pos.y + center_y;
-                   sf::Color color = salmon.getColor();
-                   // Scale based on energy
-                   float scale = std::max(0.8f, std::min(salmon.energy / 1.0f, 1.0f));
-
-                   // Draw fish body (elongated with circles)
-                   float body_length = 8.0f * scale;
-                   float body_width = 4.0f * scale;
-
-                   // Draw body as overlapping circles for smooth fish shape
-                   renderer.drawCircle(salmon_x - 2 * scale, salmon_y, body_width * 0.8f, color.r, color.g, color.b, 255); // Back
-                   renderer.drawCircle(salmon_x, salmon_y, body_width, color.r, color.g, color.b, 255); // Middle (widest)
-                   renderer.drawCircle(salmon_x + 2 * scale, salmon_y, body_width * 0.8f, color.r, color.g, color.b, 255); // Front
-
-                   // Draw tail fin (triangle)
-                   std::vector<std::pair<float, float>> tail = {
-                       {salmon_x - 4 * scale, salmon_y}, // Tip
-                       {salmon_x - 2 * scale, salmon_y - 3 * scale}, // Top
-                       {salmon_x - 2 * scale, salmon_y + 3 * scale}  // Bottom
-                   };
-                   uint8_t tail_r = std::max(0, (int)color.r - 30);
-                   uint8_t tail_g = std::max(0, (int)color.g - 30);
-                   uint8_t tail_b = std::max(0, (int)color.b - 30);
-                   renderer.drawConvexShape(tail, tail_r, tail_g, tail_b, 255);
-
-                   // Draw small dorsal fin on top
-                   std::vector<std::pair<float, float>> dorsal_fin = {
-                       {salmon_x - 1 * scale, salmon_y - body_width * 0.8f}, // Base left
-                       {salmon_x + 1 * scale, salmon_y - body_width * 0.8f}, // Base right
-                       {salmon_x, salmon_y - body_width * 1.3f}  // Tip
-                   };
-                   renderer.drawConvexShape(dorsal_fin, tail_r, tail_g, tail_b, 255);
-
-                   // Draw eye
-                   renderer.drawCircle(salmon_x + 2 * scale, salmon_y - 1 * scale, 0.8f * scale, 0, 0, 0, 255);
+               // Animals in view: markers zoomed out, otherwise listed for the frame builder
+               for (uint32_t i : sprite_easing.hares.visible) {
+                   const AnimalSprite& hare = snapshot.hares[i];
+                   if (detail != DETAIL_FULL) {
+                       append_marker(hare.x + center_x, hare.y + center_y, marker_size, hare.color);
+                   } else {
+                       frame_builder.hares.push_back(i);
+                   }
                }
-
-               // Draw foxes
-               for (const auto& fox : foxes) {
-                   float fox_x = fox.current_pos.x + center_x;
-                   float fox_y = fox.current_pos.y + center_y;
-                  sf::Color color = fox.getColor();
-                  // Scale based on energy (newborns start smaller but visible)
-                  float scale = std::max(0.9f, std::min(fox.energy / 3.5f, 1.0f));
-                   // Draw fox as precomputed sprite
-                   renderer.drawSprite(fox_x, fox_y, color, renderer.getFoxSprite(), scale);
-              }
-
-               // Draw wolves
-               for (const auto& wolf : wolves) {
-                   float wolf_x = wolf.current_pos.x + center_x;
-                   float wolf_y = wolf.current_pos.y + center_y;
-                   sf::Color color = wolf.getColor();
-                   // Scale based on energy (newborns start smaller but visible)
-                   float scale = std::max(0.9f, std::min(wolf.energy / 5.0f, 1.0f));
-                   // Draw wolf as larger triangle head with ears
-                    std::vector<std::pair<float, float>> head_points = {
-                        {wolf_x, wolf_y + 12 * scale}, // Bottom
-                        {wolf_x - 10 * scale, wolf_y - 6 * scale}, // Top left
-                        {wolf_x + 10 * scale, wolf_y - 6 * scale}  // Top right
-                    };
-                   renderer.drawConvexShape(head_points, color.r, color.g, color.b, 255);
-                   // Ears
-                    std::vector<std::pair<float, float>> left_ear = {
-                        {wolf_x - 10 * scale, wolf_y - 6 * scale}, // Base left
-                        {wolf_x - 6 * scale, wolf_y - 6 * scale}, // Base right
-                        {wolf_x - 7.5f * scale, wolf_y - 12 * scale}  // Tip
-                    };
-                   renderer.drawConvexShape(left_ear, color.r, color.g, color.b, 255);
-                    std::vector<std::pair<float, float>> right_ear = {
-                        {wolf_x + 6 * scale, wolf_y - 6 * scale}, // Base left
-                        {wolf_x + 10 * scale, wolf_y - 6 * scale}, // Base right
-                        {wolf_x + 7.5f * scale, wolf_y - 12 * scale}  // Tip
-                    };
-                   renderer.drawConvexShape(right_ear, color.r, color.g, color.b, 255);
-                    // Eyes
-                    renderer.drawCircle(wolf_x - 3 * scale, wolf_y + 2.5f * scale, 1.5f * scale, 255, 255, 255, 255); // Left eye
-                    renderer.drawCircle(wolf_x + 3 * scale, wolf_y + 2.5f * scale, 1.5f * scale, 255, 255, 255, 255); // Right eye
+               for (uint32_t i : sprite_easing.salmons.visible) {
+                   const AnimalSprite& salmon = snapshot.salmons[i];
+                   if (detail != DETAIL_FULL) {
+                       append_marker(salmon.x + center_x, salmon.y + center_y, marker_size, salmon.color);
+                   } else {
+                       frame_builder.salmons.push_back(i);
+                   }
+               }
+               for (uint32_t i : sprite_easing.foxes.visible) {
+                   const AnimalSprite& fox = snapshot.foxes[i];
+                   if (detail != DETAIL_FULL) {
+                       append_marker(fox.x + center_x, fox.y + center_y, marker_size, fox.color);
+                   } else {
+                       frame_builder.foxes.push_back(i);
+                   }
+               }
+               for (uint32_t i : sprite_easing.wolves.visible) {
+                   const AnimalSprite& wolf = snapshot.wolves[i];
+                   if (detail != DETAIL_FULL) {
+                       append_marker(wolf.x + center_x, wolf.y + center_y, marker_size, wolf.color);
+                   } else {
+                       frame_builder.wolves.push_back(i);
+                   }
+               }
+               if (detail == DETAIL_FULL) {
+                   frame_builder.draw_animals(*renderer.getWindow(), snapshot, renderer, camera.zoom, center_x, center_y);
                }
 
-               if (show_dashboard) {
-                   // Draw population graph (bottom 8% of screen)
-                   int graph_height = renderer.getHeight() / 25 * 2;
-                   int graph_y = renderer.getHeight() - graph_height;
-                  renderer.drawRectangle(0, graph_y, renderer.getWidth(), graph_height, 0, 0, 0, 150); // Semi-transparent background
-                   if (!hare_history.empty()) {
-                      int max_count = 0;
-                      for (int h : hare_history) max_count = std::max(max_count, h);
-                      for (int p : plant_history) max_count = std::max(max_count, p);
-                      for (int s : salmon_history) max_count = std::max(max_count, s);
-                      for (int f : fox_history) max_count = std::max(max_count, f);
-                      for (int w : wolf_history) max_count = std::max(max_count, w);
-                      if (max_count == 0) max_count = 1;
-                      // Compute log scales for hares, foxes, and wolves
-                      float max_log_hfw = std::log(max_count + 1.0f);
-                      for (size_t i = 1; i < hare_history.size(); ++i) {
-                          float x1 = (i - 1) * static_cast<float>(renderer.getWidth()) / (hare_history.size() - 1);
-                          float x2 = i * static_cast<float>(renderer.getWidth()) / (hare_history.size() - 1);
-                          // Hare line (gray) - logarithmic
-                          float log_h1 = std::log(hare_history[i - 1] + 1.0f);
-                          float log_h2 = std::log(hare_history[i] + 1.0f);
-                          float y1_h = graph_y + graph_height - (log_h1 * static_cast<float>(graph_height) / max_log_hfw);
-                          float y2_h = graph_y + graph_height - (log_h2 * static_cast<float>(graph_height) / max_log_hfw);
-                          renderer.drawLine(x1, y1_h, x2, y2_h, 128, 128, 128, 255, 2.0f);
-                          // Plant line (mature plant color: dark green) - linear
-                          float y1_p = graph_y + graph_height - (plant_history[i - 1] * static_cast<float>(graph_height) / max_count);
-                          float y2_p = graph_y + graph_height - (plant_history[i] * static_cast<float>(graph_height) / max_count);
-                          renderer.drawLine(x1, y1_p, x2, y2_p, 0, 100, 0, 255, 2.0f);
-                          // Salmon line (blue) - logarithmic
-                          float log_s1 = std::log(salmon_history[i - 1] + 1.0f);
-                          float log_s2 = std::log(salmon_history[i] + 1.0f);
-                          float y1_s = graph_y + graph_height - (log_s1 * static_cast<float>(graph_height) / max_log_hfw);
-                          float y2_s = graph_y + graph_height - (log_s2 * static_cast<float>(graph_height) / max_log_hfw);
-                          renderer.drawLine(x1, y1_s, x2, y2_s, 0, 100, 255, 255, 2.0f);
-                          // Fox line (orange) - logarithmic
-                          float log_f1 = std::log(fox_history[i - 1] + 1.0f);
-                          float log_f2 = std::log(fox_history[i] + 1.0f);
-                          float y1_f = graph_y + graph_height - (log_f1 * static_cast<float>(graph_height) / max_log_hfw);
-                          float y2_f = graph_y + graph_height - (log_f2 * static_cast<float>(graph_height) / max_log_hfw);
-                          renderer.drawLine(x1, y1_f, x2, y2_f, 255, 140, 0, 255, 2.0f);
-                          // Wolf line (black) - logarithmic
-                          float log_w1 = std::log(wolf_history[i - 1] + 1.0f);
-                          float log_w2 = std::log(wolf_history[i] + 1.0f);
-                          float y1_w = graph_y + graph_height - (log_w1 * static_cast<float>(graph_height) / max_log_hfw);
-                          float y2_w = graph_y + graph_height - (log_w2 * static_cast<float>(graph_height) / max_log_hfw);
-                          renderer.drawLine(x1, y1_w, x2, y2_w, 0, 0, 0, 255, 2.0f);
-                      }
-                  }
-
-                  // Display average genome stats and current population
-                  float sum_threshold = 0.0f;
-                  float sum_aggression = 0.0f;
-                  float sum_weight = 0.0f;
-                  int genome_count = 0;
-                  for (const auto& hare : hares) {
-                      if (!hare.is_dead) {
-                          sum_threshold += hare.genome.reproduction_threshold;
-                          sum_aggression += hare.genome.movement_aggression;
-                          sum_weight += hare.genome.weight;
-                          genome_count++;
-                      }
-                  }
-                  int plant_count = hexGrid.plants.size();
-                  int hare_count = hares.size();
-                  int salmon_count = salmons.size();
-                  int fox_count = foxes.size();
-                  int wolf_count = wolves.size();
-                  std::string stats_text = "Plants: " + std::to_string(plant_count) + " | Hares: " + std::to_string(hare_count) + " | Salmons: " + std::to_string(salmon_count) + " | Foxes: " + std::to_string(fox_count) + " | Wolves: " + std::to_string(wolf_count);
-                  renderer.drawText(stats_text, 10, graph_y + 10, 255, 255, 255, 16);
-              }
+               // All zoomed-out plants, fires and animals in one draw call
+               if (lod_markers.getVertexCount() > 0) {
+                   renderer.getWindow()->draw(lod_markers);
+               }
 
             // Draw object
             if (showObject) {
@@ -996,6 +765,47 @@ int main() {
                                       true);
             }
 
+            // Dashboard is drawn in screen space
+            renderer.resetView();
+
+               if (show_dashboard) {
+                   // Draw population graph (bottom 8% of screen)
+                   int graph_height = renderer.getHeight() / 25 * 2;
+                   int graph_y = renderer.getHeight() - graph_height;
+                  renderer.drawRectangle(0, graph_y, renderer.getWidth(), graph_height, 0, 0, 0, 150); // Semi-transparent background
+                  population_graph.sync(snapshot);
+                  population_graph.draw(*renderer.getWindow(), 0, graph_y, renderer.getWidth(), graph_height);
+
+                  // Display current population
+                  int plant_count = snapshot.plants.size();
+                  int hare_count = snapshot.hares.size();
+                  int salmon_count = snapshot.salmons.size();
+                  int fox_count = snapshot.foxes.size();
+                  int wolf_count = snapshot.wolves.size();
+                  hud_stats.assign({static_cast<float>(plant_count), static_cast<float>(hare_count), static_cast<float>(salmon_count),
+                                    static_cast<float>(fox_count), static_cast<float>(wolf_count)});
+                  hud_stats.push_back(static_cast<float>(snapshot.time_slices));
+                  if (replay) {
+                      hud_stats.insert(hud_stats.end(), {static_cast<float>(static_cast<int>(snapshot.sim_time)), replay->speed, replay->paused ? 1.0f : 0.0f});
+                  }
+                  if (hud_stats != hud_stats_shown) {
+                      std::string stats_text = "Plants: " + std::to_string(plant_count) + " | Hares: " + std::to_string(hare_count) + " | Salmons: " + std::to_string(salmon_count) + " | Foxes: " + std::to_string(fox_count) + " | Wolves: " + std::to_string(wolf_count);
+                      if (snapshot.time_slices > 1) {
+                          stats_text += " | Overloaded: AI 1/" + std::to_string(snapshot.time_slices);
+                      }
+                      if (replay) {
+                          stats_text += " | Replay t=" + std::to_string(static_cast<int>(snapshot.sim_time)) + "s x" + std::to_string(replay->speed) + (replay->paused ? " (paused)" : "");
+                      }
+                      hud.set_text(0, stats_text, 10, 10);
+                      hud_stats_shown = hud_stats;
+                  }
+                  hud.set_bounds(0, graph_y, renderer.getWidth(), graph_height);
+                  hud.draw(*renderer.getWindow());
+              }
+
+            if (capture) {
+                capture->capture(*renderer.getWindow());
+            }
 
             // Display frame
             renderer.display();
@@ -1004,6 +814,24 @@ int main() {
             std::this_thread::sleep_for(std::chrono::milliseconds(16)); // ~60 FPS
         }
 
+        sim_thread.stop();
+        if (metrics_server) {
+            std::cout << "Served " << metrics_server->scrapes() << " metrics scrapes" << std::endl;
+        }
+        if (capture) {
+            capture->finish();
+            std::cout << "Captured " << capture->written() << " frames to " << capture_dir << " (" << capture->dropped() << " dropped while the writers were busy)" << std::endl;
+        }
+        if (exporter) {
+            exporter->finish();
+            std::cout << "Exported " << exporter->written() << " snapshots to " << export_file << " (" << exporter->dropped() << " dropped while the writer was busy)" << std::endl;
+        }
+        if (recorder) {
+            recorder->finish();
+            std::cout << "Recorded " << sim.tick_count << " ticks, " << recorder->bytes_written() << " bytes" << std::endl;
+        }
+        sim.lineage.finish();
+        event_log.stop();
         std::cout << "HexaWorld closed successfully" << std::endl;
         return 0;
 
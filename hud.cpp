@@ -0,0 +1,62 @@
+#include "hud.hpp"
+#include <iostream>
+
+// ============================================================================
+// HUD LAYER IMPLEMENTATION
+// ============================================================================
+
+void HudLayer::set_bounds(float x, float y, unsigned width, unsigned height) {
+    position_ = sf::Vector2f(x, y);
+    if (sprite_) sprite_->setPosition(position_);
+    if (width == size_.x && height == size_.y) return;
+
+    size_ = sf::Vector2u(width, height);
+    sprite_.reset();
+    if (width == 0 || height == 0) return;
+    if (!texture_.resize(size_)) {
+        std::cerr << "Warning: Could not create HUD texture, dashboard text disabled" << std::endl;
+        size_ = sf::Vector2u(0, 0);
+        return;
+    }
+    sprite_ = std::make_unique<sf::Sprite>(texture_.getTexture());
+    sprite_->setPosition(position_);
+    dirty_ = true;
+}
+
+void HudLayer::set_text(size_t slot, const std::string& text, float x, float y, sf::Color color, unsigned size) {
+    if (slot >= lines_.size()) lines_.resize(slot + 1);
+    Line& line = lines_[slot];
+    if (!line.shape) {
+        line.shape = std::make_unique<sf::Text>(font_);
+        line.size = 0;  // Forces the style below to be applied
+    }
+
+    if (text != line.text) {
+        line.text = text;
+        line.shape->setString(text);
+        dirty_ = true;
+    }
+    sf::Vector2f position(x, y);
+    if (position != line.position || color != line.color || size != line.size) {
+        line.position = position;
+        line.color = color;
+        line.size = size;
+        line.shape->setPosition(position);
+        line.shape->setFillColor(color);
+        line.shape->setCharacterSize(size);
+        dirty_ = true;
+    }
+}
+
+void HudLayer::draw(sf::RenderTarget& target) {
+    if (!sprite_) return;
+    if (dirty_) {
+        texture_.clear(sf::Color::Transparent);
+        for (const Line& line : lines_) {
+            if (line.shape) texture_.draw(*line.shape);
+        }
+        texture_.display();
+        dirty_ = false;
+    }
+    target.draw(*sprite_);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// HUD LAYER - Retained screen-space text, re-rendered only when it changes
+// ============================================================================
+
+// Each line keeps its sf::Text, so glyphs are laid out again only when that
+// line's string changes. Lines are rendered into an off-screen texture when
+// something changed, and every frame composites the texture with one draw.
+class HudLayer {
+public:
+    explicit HudLayer(const sf::Font& font) : font_(font) {}
+
+    // Place the layer on screen; a new size reallocates the texture
+    void set_bounds(float x, float y, unsigned width, unsigned height);
+
+    // Set line `slot` (created on first use), in layer coordinates
+    void set_text(size_t slot, const std::string& text, float x, float y,
+                  sf::Color color = sf::Color::White, unsigned size = 16);
+
+    // Re-render the texture if anything changed, then draw it
+    void draw(sf::RenderTarget& target);
+
+private:
+    struct Line {
+        std::string text;
+        sf::Vector2f position;
+        sf::Color color;
+        unsigned size = 0;
+        std::unique_ptr<sf::Text> shape;  // Created on first use (needs the font)
+    };
+
+    const sf::Font& font_;
+    sf::RenderTexture texture_;
+    std::unique_ptr<sf::Sprite> sprite_;
+    sf::Vector2u size_;
+    sf::Vector2f position_;
+    std::vector<Line> lines_;
+    bool dirty_ = true;
+};
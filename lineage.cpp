@@ -0,0 +1,179 @@
+#include "lineage.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+// ============================================================================
+// LINEAGE IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+int32_t quantize(float value) {
+    return static_cast<int32_t>(std::lround(value * LINEAGE_GENOME_SCALE));
+}
+
+int16_t clamp_delta(int32_t delta) {
+    return static_cast<int16_t>(std::clamp<int32_t>(delta, std::numeric_limits<int16_t>::min(),
+                                                    std::numeric_limits<int16_t>::max()));
+}
+
+} // namespace
+
+LineageTracker::~LineageTracker() {
+    finish();
+}
+
+void LineageTracker::open_stream(const std::string& path) {
+    stream_.open(path, std::ios::out | std::ios::trunc);
+    if (!stream_) {
+        throw std::runtime_error("Failed to create lineage file: " + path);
+    }
+    stream_ << "id,parent_id,species,generation,birth_tick,death_tick";
+    for (int i = 0; i < GENOME_VALUES; ++i) stream_ << ",g" << i;
+    stream_ << "\n";
+}
+
+void LineageTracker::add(const RecordedAnimal& animal, const RecordedAnimal* parent, uint64_t tick) {
+    if (!nodes_.empty() && animal.id <= nodes_.back().id) {
+        throw std::logic_error("Lineage ids must be added in increasing order");
+    }
+
+    LineageNode node{};
+    node.id = animal.id;
+    node.parent = parent ? slot_of(parent->id) : LINEAGE_NONE;
+    node.birth_tick = static_cast<uint32_t>(tick);
+    node.death_tick = LINEAGE_ALIVE;
+    node.refs = 1;
+    node.species = animal.species;
+    if (node.parent != LINEAGE_NONE) {
+        LineageNode& parent_node = nodes_[node.parent];
+        node.generation = static_cast<uint16_t>(std::min<int>(parent_node.generation + 1, 0xFFFF));
+        parent_node.refs++;
+    }
+
+    // Quantization is exact, so the parent's chain of deltas sums to quantize(parent genome)
+    for (int i = 0; i < GENOME_VALUES; ++i) {
+        int32_t base = node.parent != LINEAGE_NONE ? quantize(parent->genome[i]) : 0;
+        node.genome_delta[i] = clamp_delta(quantize(animal.genome[i]) - base);
+    }
+
+    nodes_.push_back(node);
+    living_++;
+}
+
+void LineageTracker::remove(uint32_t id, uint64_t tick) {
+    uint32_t slot = slot_of(id);
+    if (slot == LINEAGE_NONE || nodes_[slot].death_tick != LINEAGE_ALIVE) return;
+    nodes_[slot].death_tick = static_cast<uint32_t>(tick);
+    living_--;
+    release(slot);
+}
+
+void LineageTracker::release(uint32_t slot) {
+    // A node with no references left is extinct, and stops holding up its parent
+    while (slot != LINEAGE_NONE && --nodes_[slot].refs == 0) {
+        slot = nodes_[slot].parent;
+    }
+}
+
+void LineageTracker::prune() {
+    // Written out before compacting, while their parents' slots still hold the parents
+    if (stream_.is_open()) {
+        compute_absolute_genomes();
+        for (uint32_t slot = 0; slot < nodes_.size(); ++slot) {
+            if (nodes_[slot].refs == 0) write_node(slot);
+        }
+    }
+
+    // Parents precede children, so compacting in place keeps parents valid
+    remap_.assign(nodes_.size(), LINEAGE_NONE);
+    uint32_t kept = 0;
+    for (uint32_t slot = 0; slot < nodes_.size(); ++slot) {
+        if (nodes_[slot].refs == 0) {
+            pruned_++;
+            continue;
+        }
+        LineageNode node = nodes_[slot];
+        if (node.parent != LINEAGE_NONE) node.parent = remap_[node.parent];
+        remap_[slot] = kept;
+        nodes_[kept++] = node;
+    }
+    nodes_.resize(kept);
+    if (stream_.is_open()) stream_.flush();
+}
+
+void LineageTracker::finish() {
+    if (!stream_.is_open()) return;
+    compute_absolute_genomes();
+    for (uint32_t slot = 0; slot < nodes_.size(); ++slot) {
+        write_node(slot);
+    }
+    stream_.close();
+}
+
+uint32_t LineageTracker::common_ancestor(uint32_t a, uint32_t b) const {
+    uint32_t sa = slot_of(a), sb = slot_of(b);
+    if (sa == LINEAGE_NONE || sb == LINEAGE_NONE) return 0;
+    // Lift the deeper node to the same generation, then climb together
+    while (nodes_[sa].generation > nodes_[sb].generation) sa = nodes_[sa].parent;
+    while (nodes_[sb].generation > nodes_[sa].generation) sb = nodes_[sb].parent;
+    while (sa != sb) {
+        sa = nodes_[sa].parent;
+        sb = nodes_[sb].parent;
+        if (sa == LINEAGE_NONE || sb == LINEAGE_NONE) return 0;
+    }
+    return nodes_[sa].id;
+}
+
+std::vector<TraitPoint> LineageTracker::trajectory(uint32_t id, int trait) const {
+    std::vector<TraitPoint> points;
+    if (trait < 0 || trait >= GENOME_VALUES) return points;
+    for (uint32_t s = slot_of(id); s != LINEAGE_NONE; s = nodes_[s].parent) {
+        points.push_back({nodes_[s].id, nodes_[s].birth_tick, static_cast<float>(nodes_[s].genome_delta[trait])});
+    }
+    // Founder first, then accumulate the deltas
+    std::reverse(points.begin(), points.end());
+    float value = 0.0f;
+    for (auto& point : points) {
+        value += point.value;
+        point.value = value / LINEAGE_GENOME_SCALE;
+    }
+    return points;
+}
+
+const LineageNode* LineageTracker::find(uint32_t id) const {
+    uint32_t slot = slot_of(id);
+    return slot == LINEAGE_NONE ? nullptr : &nodes_[slot];
+}
+
+uint32_t LineageTracker::slot_of(uint32_t id) const {
+    auto it = std::lower_bound(nodes_.begin(), nodes_.end(), id,
+        [](const LineageNode& node, uint32_t key) { return node.id < key; });
+    if (it == nodes_.end() || it->id != id) return LINEAGE_NONE;
+    return static_cast<uint32_t>(it - nodes_.begin());
+}
+
+void LineageTracker::compute_absolute_genomes() {
+    // Parents precede children, so one forward pass suffices
+    absolute_.assign(nodes_.size() * GENOME_VALUES, 0);
+    for (size_t slot = 0; slot < nodes_.size(); ++slot) {
+        const LineageNode& node = nodes_[slot];
+        for (int i = 0; i < GENOME_VALUES; ++i) {
+            int32_t base = node.parent == LINEAGE_NONE ? 0 : absolute_[node.parent * GENOME_VALUES + i];
+            absolute_[slot * GENOME_VALUES + i] = base + node.genome_delta[i];
+        }
+    }
+}
+
+void LineageTracker::write_node(uint32_t slot) {
+    const LineageNode& node = nodes_[slot];
+    stream_ << node.id << ',' << (node.parent == LINEAGE_NONE ? 0 : nodes_[node.parent].id) << ','
+            << static_cast<int>(node.species) << ',' << node.generation << ',' << node.birth_tick << ',';
+    if (node.death_tick != LINEAGE_ALIVE) stream_ << node.death_tick;
+    for (int i = 0; i < GENOME_VALUES; ++i) {
+        stream_ << ',' << absolute_[slot * GENOME_VALUES + i] / LINEAGE_GENOME_SCALE;
+    }
+    stream_ << '\n';
+}
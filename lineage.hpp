@@ -0,0 +1,85 @@
+#pragma once
+
+#include "recording.hpp"
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// LINEAGE - Ancestry of every animal in a compact append-only arena
+// ============================================================================
+
+// Genomes are stored as quantized deltas from the parent, so walking from a
+// founder down to any node reproduces its genome exactly
+const float LINEAGE_GENOME_SCALE = 4096.0f;
+
+struct LineageNode {
+    uint32_t id;
+    uint32_t parent;       // Arena slot of the parent, LINEAGE_NONE for founders
+    uint32_t birth_tick;
+    uint32_t death_tick;   // LINEAGE_ALIVE while alive
+    uint32_t refs;         // 1 while alive, plus one per child with living descendants
+    uint16_t generation;   // 0 for founders
+    uint8_t species;
+    int16_t genome_delta[GENOME_VALUES];
+};
+
+const uint32_t LINEAGE_NONE = 0xFFFFFFFFu;
+const uint32_t LINEAGE_ALIVE = 0xFFFFFFFFu;
+
+struct TraitPoint {
+    uint32_t id;
+    uint32_t birth_tick;
+    float value;
+};
+
+// Nodes are appended in id order, so lookups are a binary search and the
+// arena needs no id map. Nodes with no living descendants are extinct;
+// prune() streams them to disk and compacts the arena, so memory tracks the
+// living population and its ancestors rather than every birth ever made.
+class LineageTracker {
+public:
+    ~LineageTracker();
+
+    // Extinct nodes are appended to this CSV file when pruned (discarded if unset)
+    void open_stream(const std::string& path);
+
+    // Register a founder (no parent) or newborn; ids must be increasing
+    void add(const RecordedAnimal& animal, const RecordedAnimal* parent, uint64_t tick);
+
+    // Mark an animal dead
+    void remove(uint32_t id, uint64_t tick);
+
+    // Drop extinct nodes from the arena, streaming them out
+    void prune();
+
+    // Stream every remaining node (living ones with an empty death tick) and close
+    void finish();
+
+    // Most recent common ancestor of two animals, 0 if they share none
+    uint32_t common_ancestor(uint32_t a, uint32_t b) const;
+
+    // Value of one genome field along the line from the founder down to id
+    std::vector<TraitPoint> trajectory(uint32_t id, int trait) const;
+
+    const LineageNode* find(uint32_t id) const;
+    size_t size() const { return nodes_.size(); }
+    size_t living() const { return living_; }
+    uint64_t pruned() const { return pruned_; }
+
+private:
+    std::vector<LineageNode> nodes_;  // Sorted by id
+    size_t living_ = 0;
+    uint64_t pruned_ = 0;
+    std::ofstream stream_;
+
+    // Reused by prune()
+    std::vector<uint32_t> remap_;
+    std::vector<int32_t> absolute_;
+
+    uint32_t slot_of(uint32_t id) const;
+    void release(uint32_t slot);
+    void compute_absolute_genomes();
+    void write_node(uint32_t slot);
+};
@@ -0,0 +1,151 @@
+#include "simulation.hpp"
+#include "world_map.hpp"
+#include "recording.hpp"
+#include "event_log.hpp"
+#include "constants.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// HEXAWORLD BAKE - Writes world maps for HEXAWORLD_MAP
+// ============================================================================
+
+// hexaworld_bake OUTPUT [--seed N] [--size WIDTHxHEIGHT] [--image FILE] [--spawns]
+//
+// Generates a world exactly as the viewer would from the seed, or repaints
+// its terrain from an image, and saves it. With --spawns the generated
+// founders are saved too (with default genomes on load); otherwise the
+// initial animals are placed at random each time the map is loaded.
+
+namespace {
+
+void usage() {
+    std::cerr << "Usage: hexaworld_bake OUTPUT [--seed N] [--size WIDTHxHEIGHT] [--image FILE] [--spawns]" << std::endl;
+}
+
+float color_distance(const sf::Color& a, const sf::Color& b) {
+    float dr = float(a.r) - b.r, dg = float(a.g) - b.g, db = float(a.b) - b.b;
+    return dr * dr + dg * dg + db * db;
+}
+
+// Stretch the image over the world and give each hexagon the terrain whose
+// color is nearest to the pixel under its center (none where transparent).
+// Nutrients are drawn afresh for the new terrain, and soil ends up with a
+// plant everywhere, as generation leaves it.
+void paint_terrain(HexGrid& grid, const sf::Image& image, float world_width, float world_height) {
+    const TerrainType types[] = {SOIL, WATER, ROCK};
+    const sf::Color colors[] = {SOIL_COLOR, WATER_COLOR, ROCK_COLOR};
+    std::uniform_real_distribution<float> nutrient_var(-0.2f, 0.2f);
+    sf::Vector2u size = image.getSize();
+
+    grid.terrainTiles.clear();
+    for (const auto& [coord, pixel] : grid.hexagons) {
+        auto [q, r] = coord;
+        float u = (pixel.first + world_width / 2.0f) / world_width;
+        float v = (pixel.second + world_height / 2.0f) / world_height;
+        unsigned x = std::min(size.x - 1, static_cast<unsigned>(std::max(0.0f, u * size.x)));
+        unsigned y = std::min(size.y - 1, static_cast<unsigned>(std::max(0.0f, v * size.y)));
+        sf::Color color = image.getPixel({x, y});
+        if (color.a < 128) {
+            grid.nutrients.set(q, r, 0.0f);
+            grid.plants.erase(coord);
+            continue;
+        }
+
+        int best = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (color_distance(color, colors[i]) < color_distance(color, colors[best])) best = i;
+        }
+        TerrainType type = types[best];
+        grid.terrainTiles.insert({coord, TerrainTile(q, r, type)});
+        float nutrients = std::clamp(base_nutrients(type) + nutrient_var(gen), 0.0f, 1.0f);
+        grid.nutrients.set(q, r, nutrients);
+        if (type != SOIL) {
+            grid.plants.erase(coord);
+        } else if (Plant* plant = grid.get_plant(q, r)) {
+            plant->nutrients = nutrients;
+        } else {
+            grid.plants.insert({coord, Plant(q, r, SEED, nutrients)});
+        }
+    }
+}
+
+// Founders still standing on terrain they can live on
+template <typename Animal>
+void add_spawns(std::vector<MapSpawn>& spawns, const HexGrid& grid, const std::vector<Animal>& animals, TerrainType terrain) {
+    for (const Animal& animal : animals) {
+        if (!grid.has_hexagon(animal.q, animal.r) || grid.get_terrain_type(animal.q, animal.r) != terrain) continue;
+        MapSpawn spawn{};
+        spawn.species = record_animal(animal).species;
+        spawn.q = animal.q;
+        spawn.r = animal.r;
+        spawns.push_back(spawn);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argv[1][0] == '-') {
+        usage();
+        return 1;
+    }
+    std::string output = argv[1];
+    unsigned int seed = RANDOM_SEED;
+    float width = 1280.0f, height = 1024.0f;  // The viewer's window at world scale 1
+    std::string image_file;
+    bool with_spawns = false;
+    for (int i = 2; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--seed" && has_value) {
+            seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--size" && has_value && std::sscanf(argv[++i], "%fx%f", &width, &height) == 2 && width > 0 && height > 0) {
+            continue;
+        } else if (arg == "--image" && has_value) {
+            image_file = argv[++i];
+        } else if (arg == "--spawns") {
+            with_spawns = true;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    try {
+        event_log.set_level(LOG_OFF);
+        gen.seed(seed);
+        Simulation sim(HEX_SIZE);
+        sim.generate(width, height);
+
+        if (!image_file.empty()) {
+            sf::Image image;
+            if (!image.loadFromFile(image_file)) {
+                std::cerr << "ERROR: Failed to load image " << image_file << std::endl;
+                return 1;
+            }
+            paint_terrain(sim.grid, image, width, height);
+        }
+
+        std::vector<MapSpawn> spawns;
+        if (with_spawns) {
+            add_spawns(spawns, sim.grid, sim.hares, SOIL);
+            add_spawns(spawns, sim.grid, sim.foxes, SOIL);
+            add_spawns(spawns, sim.grid, sim.wolves, SOIL);
+            add_spawns(spawns, sim.grid, sim.salmons, WATER);
+        }
+
+        save_world_map(sim.grid, width, height, spawns, output);
+        std::cout << "Baked " << sim.grid.hexagons.size() << " hexagons (radius " << sim.grid.max_grid_distance << "), "
+                  << sim.grid.plants.size() << " plants and " << spawns.size() << " founders to " << output << std::endl;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return 1;
+    }
+}
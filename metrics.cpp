@@ -0,0 +1,274 @@
+#include "metrics.hpp"
+#include "constants.hpp"
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static_assert(std::atomic<double>::is_always_lock_free, "Metrics need lock-free doubles");
+
+// ============================================================================
+// METRICS IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const char* SPECIES_LABELS[] = {"none", "hare", "fox", "wolf", "salmon"};
+const char* PHASE_LABELS[] = {"plants", "fires", "animals", "births", "bookkeeping"};
+static_assert(sizeof(PHASE_LABELS) / sizeof(PHASE_LABELS[0]) == TICK_PHASE_COUNT, "One label per tick phase");
+
+// The only writer adds to a value, so a load and a store do without a locked instruction
+template <typename T, typename U>
+void add(std::atomic<T>& value, U amount) {
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+template <typename T>
+void set(std::atomic<T>& value, T to) {
+    value.store(to, std::memory_order_relaxed);
+}
+
+template <typename T>
+T get(const std::atomic<T>& value) {
+    return value.load(std::memory_order_relaxed);
+}
+
+void header(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << " " << help << "\n# TYPE " << name << " " << type << "\n";
+}
+
+// One sample per species, skipping SPECIES_NONE
+void per_species(std::ostream& out, const char* name, const std::atomic<uint64_t>* values) {
+    for (int s = SPECIES_HARE; s < Metrics::SPECIES_COUNT; ++s) {
+        out << name << "{species=\"" << SPECIES_LABELS[s] << "\"} " << get(values[s]) << "\n";
+    }
+}
+
+} // namespace
+
+void Metrics::record_tick(const Simulation& sim, float seconds, float budget) {
+    int bucket = 0;
+    while (bucket < TICK_BUCKET_COUNT - 1 && seconds > TICK_BUCKETS[bucket]) bucket++;
+    add(tick_buckets_[bucket], 1);
+    add(tick_seconds_, static_cast<double>(seconds));
+    if (budget > 0.0f && seconds > budget) add(overruns_, 1);
+    set(budget_, budget);
+    set(time_slices_, sim.time_slices);
+    for (int p = 0; p < TICK_PHASE_COUNT; ++p) set(phase_seconds_[p], sim.phase_seconds[p]);
+    set(sim_seconds_, static_cast<double>(sim.sim_time));
+
+    set(population_[SPECIES_HARE], static_cast<uint64_t>(sim.hares.size()));
+    set(population_[SPECIES_FOX], static_cast<uint64_t>(sim.foxes.size()));
+    set(population_[SPECIES_WOLF], static_cast<uint64_t>(sim.wolves.size()));
+    set(population_[SPECIES_SALMON], static_cast<uint64_t>(sim.salmons.size()));
+    set(plants_, static_cast<uint64_t>(sim.grid.plants.size()));
+    set(fires_, static_cast<uint64_t>(sim.grid.fire_timers.size()));
+    for (int s = 0; s < SPECIES_COUNT; ++s) {
+        set(births_[s], sim.flows.births[s]);
+        set(deaths_[s], sim.flows.deaths[s]);
+        set(immigrants_[s], sim.flows.immigrants[s]);
+        set(emigrants_[s], sim.flows.emigrants[s]);
+    }
+    set(lineage_nodes_, static_cast<uint64_t>(sim.lineage.size()));
+}
+
+void Metrics::record_frame(float seconds) {
+    add(frames_, 1);
+    add(frame_seconds_, static_cast<double>(seconds));
+    if (seconds > 0.0f) {
+        float rate = get(frame_rate_);
+        set(frame_rate_, rate == 0.0f ? 1.0f / seconds : rate + (1.0f / seconds - rate) * METRICS_FPS_SMOOTHING);
+    }
+}
+
+std::string Metrics::format() const {
+    std::ostringstream out;
+    out.precision(9);
+
+    header(out, "hexaworld_tick_duration_seconds", "histogram", "Wall time of each simulation tick.");
+    uint64_t cumulative = 0;
+    for (int b = 0; b < TICK_BUCKET_COUNT; ++b) {
+        cumulative += get(tick_buckets_[b]);
+        out << "hexaworld_tick_duration_seconds_bucket{le=\"";
+        if (b < TICK_BUCKET_COUNT - 1) out << TICK_BUCKETS[b]; else out << "+Inf";
+        out << "\"} " << cumulative << "\n";
+    }
+    out << "hexaworld_tick_duration_seconds_sum " << get(tick_seconds_) << "\n";
+    out << "hexaworld_tick_duration_seconds_count " << cumulative << "\n";
+
+    header(out, "hexaworld_tick_phase_seconds_total", "counter", "Wall time spent in each phase of the tick.");
+    for (int p = 0; p < TICK_PHASE_COUNT; ++p) {
+        out << "hexaworld_tick_phase_seconds_total{phase=\"" << PHASE_LABELS[p] << "\"} " << get(phase_seconds_[p]) << "\n";
+    }
+    header(out, "hexaworld_tick_overruns_total", "counter", "Ticks that took longer than the tick budget.");
+    out << "hexaworld_tick_overruns_total " << get(overruns_) << "\n";
+    header(out, "hexaworld_tick_budget_seconds", "gauge", "Wall time a tick may take before work is shed (0 = unlimited).");
+    out << "hexaworld_tick_budget_seconds " << get(budget_) << "\n";
+    header(out, "hexaworld_time_slices", "gauge", "Ticks that agent decisions and bookkeeping are spread over.");
+    out << "hexaworld_time_slices " << get(time_slices_) << "\n";
+    header(out, "hexaworld_simulated_seconds", "gauge", "Simulated time since the world was built.");
+    out << "hexaworld_simulated_seconds " << get(sim_seconds_) << "\n";
+
+    header(out, "hexaworld_population", "gauge", "Living animals.");
+    per_species(out, "hexaworld_population", population_);
+    header(out, "hexaworld_plants", "gauge", "Plants, seeds and charred remains.");
+    out << "hexaworld_plants " << get(plants_) << "\n";
+    header(out, "hexaworld_fires", "gauge", "Tiles burning.");
+    out << "hexaworld_fires " << get(fires_) << "\n";
+    header(out, "hexaworld_births_total", "counter", "Animals born.");
+    per_species(out, "hexaworld_births_total", births_);
+    header(out, "hexaworld_deaths_total", "counter", "Animals starved, dehydrated, burned or eaten.");
+    per_species(out, "hexaworld_deaths_total", deaths_);
+    header(out, "hexaworld_immigrants_total", "counter", "Animals arrived from other islands.");
+    per_species(out, "hexaworld_immigrants_total", immigrants_);
+    header(out, "hexaworld_emigrants_total", "counter", "Animals sent to other islands.");
+    per_species(out, "hexaworld_emigrants_total", emigrants_);
+    header(out, "hexaworld_lineage_nodes", "gauge", "Animals held in the lineage arena.");
+    out << "hexaworld_lineage_nodes " << get(lineage_nodes_) << "\n";
+
+    header(out, "hexaworld_frames_total", "counter", "Frames rendered.");
+    out << "hexaworld_frames_total " << get(frames_) << "\n";
+    header(out, "hexaworld_frame_seconds_total", "counter", "Wall time of the rendered frames.");
+    out << "hexaworld_frame_seconds_total " << get(frame_seconds_) << "\n";
+    header(out, "hexaworld_frame_rate", "gauge", "Smoothed frames per second.");
+    out << "hexaworld_frame_rate " << get(frame_rate_) << "\n";
+
+    // Sizes in pages; read here so only the server thread pays for it
+    std::ifstream statm("/proc/self/statm");
+    uint64_t virtual_pages = 0, resident_pages = 0;
+    if (statm >> virtual_pages >> resident_pages) {
+        uint64_t page = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+        header(out, "process_resident_memory_bytes", "gauge", "Resident memory size in bytes.");
+        out << "process_resident_memory_bytes " << resident_pages * page << "\n";
+        header(out, "process_virtual_memory_bytes", "gauge", "Virtual memory size in bytes.");
+        out << "process_virtual_memory_bytes " << virtual_pages * page << "\n";
+    }
+    return out.str();
+}
+
+// ============================================================================
+// METRICS SERVER
+// ============================================================================
+
+MetricsServer::MetricsServer(const Metrics& metrics, const std::string& endpoint)
+    : metrics_(metrics), endpoint_(endpoint) {
+    if (endpoint.rfind("unix:", 0) == 0) {
+        unix_path_ = endpoint.substr(5);
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        if (unix_path_.empty() || unix_path_.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Bad metrics socket path: " + endpoint);
+        }
+        std::memcpy(address.sun_path, unix_path_.c_str(), unix_path_.size() + 1);
+        fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd_ < 0) throw std::runtime_error("Failed to create metrics socket");
+        unlink(unix_path_.c_str());  // Left behind by an earlier run
+        if (bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd_);
+            throw std::runtime_error("Failed to bind metrics socket " + unix_path_ + ": " + std::strerror(errno));
+        }
+    } else {
+        size_t colon = endpoint.rfind(':');
+        std::string host = colon == std::string::npos ? "127.0.0.1" : endpoint.substr(0, colon);
+        std::string port = colon == std::string::npos ? endpoint : endpoint.substr(colon + 1);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        char* end = nullptr;
+        unsigned long number = std::strtoul(port.c_str(), &end, 10);
+        if (port.empty() || *end != '\0' || number > 65535 || inet_pton(AF_INET, host.c_str(), &address.sin_addr) != 1) {
+            throw std::runtime_error("Metrics endpoint needs PORT, ADDRESS:PORT or unix:PATH: " + endpoint);
+        }
+        address.sin_port = htons(static_cast<unsigned short>(number));
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd_ < 0) throw std::runtime_error("Failed to create metrics socket");
+        int reuse = 1;
+        setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        if (bind(fd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            close(fd_);
+            throw std::runtime_error("Failed to bind metrics socket to " + endpoint + ": " + std::strerror(errno));
+        }
+    }
+    if (listen(fd_, 4) != 0) {
+        close(fd_);
+        throw std::runtime_error("Failed to listen on metrics socket " + endpoint);
+    }
+    thread_ = std::thread(&MetricsServer::run, this);
+}
+
+MetricsServer::~MetricsServer() {
+    running_.store(false);
+    if (thread_.joinable()) thread_.join();
+    close(fd_);
+    if (!unix_path_.empty()) unlink(unix_path_.c_str());
+}
+
+void MetricsServer::run() {
+    // Woken by connections, or every poll interval to see whether to stop
+    const int poll_ms = static_cast<int>(METRICS_POLL_INTERVAL * 1000.0f);
+    while (running_.load()) {
+        pollfd listener{fd_, POLLIN, 0};
+        if (poll(&listener, 1, poll_ms) <= 0) continue;
+        int client = accept(fd_, nullptr, nullptr);
+        if (client < 0) continue;
+        serve(client);
+        close(client);
+    }
+}
+
+void MetricsServer::serve(int client) {
+    // A stalled scraper can hold up only this thread, and only for a while
+    timeval timeout{};
+    timeout.tv_sec = static_cast<time_t>(METRICS_CLIENT_TIMEOUT);
+    timeout.tv_usec = static_cast<suseconds_t>(std::fmod(METRICS_CLIENT_TIMEOUT, 1.0f) * 1e6f);
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    // Only the request line matters; read until the end of the headers
+    std::string request;
+    char buffer[1024];
+    while (request.find("\r\n\r\n") == std::string::npos && request.find("\n\n") == std::string::npos &&
+           request.size() < 8192) {
+        ssize_t n = recv(client, buffer, sizeof(buffer), 0);
+        if (n <= 0) break;
+        request.append(buffer, static_cast<size_t>(n));
+    }
+    std::istringstream line(request.substr(0, request.find('\n')));
+    std::string method, target;
+    line >> method >> target;
+    target = target.substr(0, target.find('?'));
+
+    std::string status = "200 OK", body;
+    if (method != "GET" && method != "HEAD") {
+        status = "405 Method Not Allowed";
+        body = "Only GET is supported\n";
+    } else if (target != "/metrics" && target != "/") {
+        status = "404 Not Found";
+        body = "Metrics are at /metrics\n";
+    } else {
+        body = metrics_.format();
+        scrapes_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::string reply = "HTTP/1.0 " + status + "\r\n"
+                        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                        "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                        "Connection: close\r\n\r\n";
+    if (method != "HEAD") reply += body;
+    size_t sent = 0;
+    while (sent < reply.size()) {
+        ssize_t n = send(client, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) break;
+        sent += static_cast<size_t>(n);
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "simulation.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// ============================================================================
+// METRICS - Live counters and gauges, served as Prometheus text exposition
+// ============================================================================
+
+// Every value has a single writer, the simulation thread once per tick or
+// the render thread once per frame, which updates it with relaxed atomic
+// loads and stores. The server thread loads them while formatting a
+// scrape. Nothing is locked, so a scrape never holds up a tick. The cost
+// is that one scrape may mix values from two consecutive ticks.
+class Metrics {
+public:
+    // Upper bounds (seconds) of the tick duration histogram's buckets, before +Inf
+    static constexpr double TICK_BUCKETS[] = {0.00025, 0.0005, 0.001, 0.002, 0.004, 0.008, 0.016, 0.033, 0.066};
+    static constexpr int TICK_BUCKET_COUNT = sizeof(TICK_BUCKETS) / sizeof(TICK_BUCKETS[0]) + 1;
+    static constexpr int SPECIES_COUNT = SPECIES_SALMON + 1;  // Indexed by EventSpecies
+
+    // Simulation thread: the tick just run, its wall time and the budget it had (0 = none)
+    void record_tick(const Simulation& sim, float seconds, float budget);
+
+    // Render thread: the frame just drawn
+    void record_frame(float seconds);
+
+    // Text exposition format 0.0.4 of every metric, plus the process's memory use
+    std::string format() const;
+
+private:
+    std::atomic<uint64_t> tick_buckets_[TICK_BUCKET_COUNT] = {};  // Not cumulative; format() adds them up
+    std::atomic<double> tick_seconds_{0.0};
+    std::atomic<uint64_t> overruns_{0};
+    std::atomic<float> budget_{0.0f};
+    std::atomic<unsigned int> time_slices_{1};
+    std::atomic<double> phase_seconds_[TICK_PHASE_COUNT] = {};
+    std::atomic<double> sim_seconds_{0.0};
+
+    std::atomic<uint64_t> population_[SPECIES_COUNT] = {};
+    std::atomic<uint64_t> plants_{0};
+    std::atomic<uint64_t> fires_{0};
+    std::atomic<uint64_t> births_[SPECIES_COUNT] = {};
+    std::atomic<uint64_t> deaths_[SPECIES_COUNT] = {};
+    std::atomic<uint64_t> immigrants_[SPECIES_COUNT] = {};
+    std::atomic<uint64_t> emigrants_[SPECIES_COUNT] = {};
+    std::atomic<uint64_t> lineage_nodes_{0};
+
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<double> frame_seconds_{0.0};
+    std::atomic<float> frame_rate_{0.0f};  // Smoothed
+};
+
+// Minimal HTTP/1.0 server for Metrics::format(), on a thread of its own.
+// It answers GET /metrics (or /), one connection at a time, and closes
+// each connection after the reply.
+class MetricsServer {
+public:
+    // endpoint: PORT or ADDRESS:PORT (IPv4, 127.0.0.1 if no address), or
+    // unix:PATH for a Unix domain socket (replaced if it exists).
+    // Throws std::runtime_error if it cannot listen there.
+    MetricsServer(const Metrics& metrics, const std::string& endpoint);
+    ~MetricsServer();
+
+    const std::string& endpoint() const { return endpoint_; }
+    uint64_t scrapes() const { return scrapes_.load(std::memory_order_relaxed); }
+
+private:
+    const Metrics& metrics_;
+    std::string endpoint_;
+    std::string unix_path_;  // Removed again on shutdown
+    int fd_ = -1;
+    std::atomic<bool> running_{true};
+    std::atomic<uint64_t> scrapes_{0};
+    std::thread thread_;
+
+    void run();
+    void serve(int client);
+};
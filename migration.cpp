@@ -0,0 +1,304 @@
+#include "migration.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+// MIGRATION IMPLEMENTATION
+// ============================================================================
+
+bool migration_topology_from_name(const std::string& name, MigrationTopology& topology) {
+    if (name == "ring") topology = TOPOLOGY_RING;
+    else if (name == "all") topology = TOPOLOGY_ALL;
+    else return false;
+    return true;
+}
+
+bool migration_transport_from_name(const std::string& name, MigrationTransportKind& kind) {
+    if (name == "shm") kind = TRANSPORT_SHM;
+    else if (name == "socket") kind = TRANSPORT_SOCKET;
+    else return false;
+    return true;
+}
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Shared memory: every island owns an inbox segment holding one ring per
+// sender, so each ring has a single producer and a single consumer and
+// needs nothing but two counters. Records are a 32-bit length and the
+// message, padded to 8 bytes, and may wrap around the end of the ring.
+// ----------------------------------------------------------------------------
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring counters are shared between processes");
+static_assert((MIGRATION_RING_BYTES & (MIGRATION_RING_BYTES - 1)) == 0, "ring size must be a power of two");
+
+struct ShmRing {
+    alignas(64) std::atomic<uint64_t> head;  // Bytes ever written, advanced by the sender
+    alignas(64) std::atomic<uint64_t> tail;  // Bytes ever read, advanced by the owner
+    alignas(64) uint8_t data[MIGRATION_RING_BYTES];
+};
+
+size_t record_bytes(size_t size) {
+    return (sizeof(uint32_t) + size + 7) & ~size_t(7);
+}
+
+void ring_write(ShmRing& ring, uint64_t pos, const void* src, size_t size) {
+    size_t offset = pos & (MIGRATION_RING_BYTES - 1);
+    size_t first = std::min(size, MIGRATION_RING_BYTES - offset);
+    std::memcpy(ring.data + offset, src, first);
+    std::memcpy(ring.data, static_cast<const uint8_t*>(src) + first, size - first);
+}
+
+void ring_read(const ShmRing& ring, uint64_t pos, void* dst, size_t size) {
+    size_t offset = pos & (MIGRATION_RING_BYTES - 1);
+    size_t first = std::min(size, MIGRATION_RING_BYTES - offset);
+    std::memcpy(dst, ring.data + offset, first);
+    std::memcpy(static_cast<uint8_t*>(dst) + first, ring.data, size - first);
+}
+
+class ShmTransport : public MigrationTransport {
+public:
+    explicit ShmTransport(const MigrationConfig& config)
+        : config_(config), inboxes_(config.islands, nullptr) {
+        // Our own inbox is created if need be; whatever a previous run left in it is dropped
+        inboxes_[config.island] = map(config.island, true);
+        if (!inboxes_[config.island]) {
+            throw std::runtime_error("Failed to create migration segment " + name(config.island) +
+                                     " (a stale one from a run with another island count can be removed from /dev/shm)");
+        }
+        for (unsigned int i = 0; i < config.islands; ++i) {
+            ShmRing& ring = inboxes_[config.island][i];
+            ring.tail.store(ring.head.load(std::memory_order_acquire), std::memory_order_release);
+        }
+    }
+
+    ~ShmTransport() override {
+        for (ShmRing* inbox : inboxes_) {
+            if (inbox) munmap(inbox, segment_bytes());
+        }
+        shm_unlink(name(config_.island).c_str());
+    }
+
+    bool send(unsigned int to, const uint8_t* data, size_t size) override {
+        // Islands that have not started yet have no inbox; try again next time
+        if (!inboxes_[to]) inboxes_[to] = map(to, false);
+        if (!inboxes_[to]) return false;
+
+        ShmRing& ring = inboxes_[to][config_.island];
+        uint64_t head = ring.head.load(std::memory_order_relaxed);
+        uint64_t tail = ring.tail.load(std::memory_order_acquire);
+        if (record_bytes(size) > MIGRATION_RING_BYTES - (head - tail)) return false;  // Full
+
+        uint32_t length = static_cast<uint32_t>(size);
+        ring_write(ring, head, &length, sizeof(length));
+        ring_write(ring, head + sizeof(length), data, size);
+        ring.head.store(head + record_bytes(size), std::memory_order_release);
+        return true;
+    }
+
+    bool receive(std::vector<uint8_t>& message) override {
+        // Round-robin over the senders so a busy one cannot starve the rest
+        for (unsigned int n = 0; n < config_.islands; ++n) {
+            unsigned int from = (next_sender_ + n) % config_.islands;
+            ShmRing& ring = inboxes_[config_.island][from];
+            uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+            uint64_t head = ring.head.load(std::memory_order_acquire);
+            if (head == tail) continue;
+
+            uint32_t length;
+            ring_read(ring, tail, &length, sizeof(length));
+            if (record_bytes(length) > head - tail) {
+                // Corrupt ring (say, two processes claiming one island): drop its contents
+                ring.tail.store(head, std::memory_order_release);
+                continue;
+            }
+            message.resize(length);
+            ring_read(ring, tail + sizeof(length), message.data(), length);
+            ring.tail.store(tail + record_bytes(length), std::memory_order_release);
+            next_sender_ = from + 1;
+            return true;
+        }
+        return false;
+    }
+
+private:
+    MigrationConfig config_;
+    std::vector<ShmRing*> inboxes_;  // Mapped lazily, ours always
+    unsigned int next_sender_ = 0;
+
+    std::string name(unsigned int island) const {
+        return "/" + config_.group + "-" + std::to_string(island);
+    }
+
+    size_t segment_bytes() const {
+        return sizeof(ShmRing) * config_.islands;
+    }
+
+    // A fresh segment is sized here and reads as empty rings, since new
+    // shared memory is zero-filled. A sender finding an unsized segment
+    // (its owner is still starting) tries again at the next exchange.
+    ShmRing* map(unsigned int island, bool create) const {
+        int fd = shm_open(name(island).c_str(), O_RDWR | (create ? O_CREAT : 0), 0600);
+        if (fd < 0) return nullptr;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (create && st.st_size == 0 && ftruncate(fd, segment_bytes()) != 0)) {
+            close(fd);
+            return nullptr;
+        }
+        if (!create && st.st_size == 0) {
+            close(fd);
+            return nullptr;
+        }
+        if (st.st_size != 0 && static_cast<size_t>(st.st_size) != segment_bytes()) {
+            close(fd);
+            std::cerr << "Warning: Migration segment " << name(island) << " was made for a different number of islands" << std::endl;
+            return nullptr;
+        }
+        void* memory = mmap(nullptr, segment_bytes(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        return memory == MAP_FAILED ? nullptr : static_cast<ShmRing*>(memory);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Sockets: one non-blocking UDP socket per island, a batch per datagram.
+// UDP cannot tell whether anyone is listening, so batches sent to an island
+// that is down are lost. Each island listens only on the address of its own
+// peer entry (loopback by default) and drops datagrams from anyone but its peers.
+// ----------------------------------------------------------------------------
+
+const size_t MAX_DATAGRAM = 65507;
+
+class SocketTransport : public MigrationTransport {
+public:
+    explicit SocketTransport(const MigrationConfig& config) : peers_(config.islands) {
+        for (unsigned int i = 0; i < config.islands; ++i) {
+            std::string peer = config.peers.empty() ? "127.0.0.1:" + std::to_string(MIGRATION_BASE_PORT + i) : config.peers[i];
+            peers_[i] = resolve(peer);
+        }
+
+        fd_ = socket(AF_INET, SOCK_DGRAM, 0);
+        if (fd_ < 0) throw std::runtime_error("Failed to create migration socket");
+        const sockaddr_in& local = peers_[config.island];
+        if (bind(fd_, reinterpret_cast<const sockaddr*>(&local), sizeof(local)) != 0) {
+            close(fd_);
+            throw std::runtime_error("Failed to bind migration socket to " + (config.peers.empty() ?
+                                     "port " + std::to_string(ntohs(local.sin_port)) : config.peers[config.island]));
+        }
+        fcntl(fd_, F_SETFL, fcntl(fd_, F_GETFL) | O_NONBLOCK);
+        buffer_.resize(MAX_DATAGRAM);
+    }
+
+    ~SocketTransport() override {
+        close(fd_);
+    }
+
+    bool send(unsigned int to, const uint8_t* data, size_t size) override {
+        if (size > MAX_DATAGRAM) return false;
+        return sendto(fd_, data, size, 0, reinterpret_cast<const sockaddr*>(&peers_[to]), sizeof(sockaddr_in)) ==
+               static_cast<ssize_t>(size);
+    }
+
+    bool receive(std::vector<uint8_t>& message) override {
+        while (true) {
+            sockaddr_in source{};
+            socklen_t source_size = sizeof(source);
+            ssize_t n = recvfrom(fd_, buffer_.data(), buffer_.size(), 0, reinterpret_cast<sockaddr*>(&source), &source_size);
+            if (n < 0) return false;
+            if (!is_peer(source)) {
+                std::cerr << "Warning: Dropped a migration datagram from a host that is not an island" << std::endl;
+                continue;
+            }
+            message.assign(buffer_.begin(), buffer_.begin() + n);
+            return true;
+        }
+    }
+
+private:
+    int fd_ = -1;
+    std::vector<sockaddr_in> peers_;
+    std::vector<uint8_t> buffer_;
+
+    // Islands send from the socket they listen on, so a peer's datagrams come from its own address and port
+    bool is_peer(const sockaddr_in& source) const {
+        for (const sockaddr_in& peer : peers_) {
+            if (peer.sin_addr.s_addr == source.sin_addr.s_addr && peer.sin_port == source.sin_port) return true;
+        }
+        return false;
+    }
+
+    static sockaddr_in resolve(const std::string& peer) {
+        size_t colon = peer.rfind(':');
+        if (colon == std::string::npos) throw std::runtime_error("Migration peer needs host:port: " + peer);
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_DGRAM;
+        addrinfo* found = nullptr;
+        if (getaddrinfo(peer.substr(0, colon).c_str(), peer.substr(colon + 1).c_str(), &hints, &found) != 0 || !found) {
+            throw std::runtime_error("Failed to resolve migration peer " + peer);
+        }
+        sockaddr_in address;
+        std::memcpy(&address, found->ai_addr, sizeof(address));
+        freeaddrinfo(found);
+        return address;
+    }
+};
+
+} // namespace
+
+std::unique_ptr<MigrationTransport> make_shm_transport(const MigrationConfig& config) {
+    return std::make_unique<ShmTransport>(config);
+}
+
+std::unique_ptr<MigrationTransport> make_socket_transport(const MigrationConfig& config) {
+    return std::make_unique<SocketTransport>(config);
+}
+
+// ============================================================================
+// MIGRATION
+// ============================================================================
+
+Migration::Migration(const MigrationConfig& config) : config_(config) {
+    if (config_.islands < 2 || config_.island >= config_.islands) {
+        throw std::runtime_error("Island " + std::to_string(config_.island) + " is not one of " +
+                                 std::to_string(config_.islands) + " islands");
+    }
+    if (!config_.peers.empty() && config_.peers.size() != config_.islands) {
+        throw std::runtime_error("Expected " + std::to_string(config_.islands) + " migration peers, got " +
+                                 std::to_string(config_.peers.size()));
+    }
+    config_.migrants = std::min(config_.migrants, MIGRATION_MAX_MIGRANTS);
+    interval_ticks_ = std::max<uint64_t>(1, static_cast<uint64_t>(std::lround(config_.interval / SIM_DT)));
+    transport_ = config_.transport == TRANSPORT_SOCKET ? make_socket_transport(config_) : make_shm_transport(config_);
+}
+
+unsigned int Migration::destination(std::mt19937& rng) const {
+    if (config_.topology == TOPOLOGY_RING) return (config_.island + 1) % config_.islands;
+    std::uniform_int_distribution<unsigned int> dis(0, config_.islands - 2);
+    unsigned int to = dis(rng);
+    return to >= config_.island ? to + 1 : to;  // Anyone but ourselves
+}
+
+bool Migration::receive(MigrantHeader& header) {
+    while (transport_->receive(inbound_)) {
+        if (inbound_.size() >= sizeof(header)) {
+            std::memcpy(&header, inbound_.data(), sizeof(header));
+            if (header.magic == MIGRATION_MAGIC && header.from < config_.islands && header.count <= MIGRATION_MAX_MIGRANTS &&
+                inbound_.size() == sizeof(header) + size_t(header.count) * header.genome_bytes) {
+                return true;
+            }
+        }
+        std::cerr << "Warning: Dropped a malformed migrant batch (" << inbound_.size() << " bytes)" << std::endl;
+    }
+    return false;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "ga.hpp"
+#include "constants.hpp"
+#include "event_log.hpp"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// ============================================================================
+// MIGRATION - Genome exchange between simulations running as islands
+// ============================================================================
+
+// Several HexaWorld processes form an archipelago: each ticks its own world
+// and every so often sends a few genomes of each species to a neighbouring
+// island, which releases them as founders of its own. Ticks never wait on
+// the network; whatever has arrived is picked up at the next exchange.
+
+enum MigrationTopology {
+    TOPOLOGY_RING,  // Island i sends to island i + 1
+    TOPOLOGY_ALL    // Each exchange goes to a random other island
+};
+
+enum MigrationTransportKind {
+    TRANSPORT_SHM,    // Shared-memory rings, islands on one machine
+    TRANSPORT_SOCKET  // UDP datagrams, islands on any reachable host
+};
+
+bool migration_topology_from_name(const std::string& name, MigrationTopology& topology);
+bool migration_transport_from_name(const std::string& name, MigrationTransportKind& kind);
+
+struct MigrationConfig {
+    std::string group = "hexaworld";  // Names the shared-memory segments; islands of one run share it
+    unsigned int island = 0;          // This process, 0 .. islands - 1
+    unsigned int islands = 1;         // 1 = no migration
+    MigrationTopology topology = TOPOLOGY_RING;
+    MigrationTransportKind transport = TRANSPORT_SHM;
+    std::vector<std::string> peers;   // host:port of every island (socket transport), localhost ports if empty
+    float interval = MIGRATION_INTERVAL;       // Simulated seconds between exchanges
+    unsigned int migrants = MIGRATION_MIGRANTS; // Genomes sent per species and exchange
+};
+
+// Unreliable, unordered message delivery between islands. send() returning
+// false means the message was dropped (receiver absent or full); receive()
+// never blocks.
+class MigrationTransport {
+public:
+    virtual ~MigrationTransport() = default;
+    virtual bool send(unsigned int to, const uint8_t* data, size_t size) = 0;
+    virtual bool receive(std::vector<uint8_t>& message) = 0;
+};
+
+// Both throw std::runtime_error when the endpoints cannot be set up
+std::unique_ptr<MigrationTransport> make_shm_transport(const MigrationConfig& config);
+std::unique_ptr<MigrationTransport> make_socket_transport(const MigrationConfig& config);
+
+const uint32_t MIGRATION_MAGIC = 0x4D475748;  // "HWGM"
+
+// Wire format: this header, then count raw genomes. Islands must run the
+// same build, which genome_bytes and the magic are there to catch.
+struct MigrantHeader {
+    uint32_t magic;
+    uint32_t from;
+    uint32_t genome_bytes;
+    uint32_t count;
+    uint8_t species;  // EventSpecies
+    uint8_t reserved[7];
+};
+
+class Migration {
+public:
+    // Throws std::runtime_error if the config is invalid or the transport fails
+    explicit Migration(const MigrationConfig& config);
+
+    const MigrationConfig& config() const { return config_; }
+
+    // Ticks between exchanges
+    uint64_t interval_ticks() const { return interval_ticks_; }
+
+    // Island the next batch goes to
+    unsigned int destination(std::mt19937& rng) const;
+
+    template <typename Genome>
+    bool send(unsigned int to, EventSpecies species, const std::vector<Genome>& genomes) {
+        static_assert(std::is_trivially_copyable_v<Genome>, "genomes travel as raw bytes");
+        MigrantHeader header{MIGRATION_MAGIC, config_.island, sizeof(Genome),
+                             static_cast<uint32_t>(genomes.size()), species, {}};
+        outbound_.resize(sizeof(header) + genomes.size() * sizeof(Genome));
+        std::memcpy(outbound_.data(), &header, sizeof(header));
+        if (!genomes.empty()) std::memcpy(outbound_.data() + sizeof(header), genomes.data(), genomes.size() * sizeof(Genome));
+        return transport_->send(to, outbound_.data(), outbound_.size());
+    }
+
+    // Next well-formed batch that has arrived; false when none is waiting.
+    // Malformed messages are dropped with a warning.
+    bool receive(MigrantHeader& header);
+
+    // Genomes of the batch last returned by receive(), false if they are
+    // not of this type. The bytes came off the wire, so every genome is
+    // sanitized before it is handed out.
+    template <typename Genome>
+    bool genomes(std::vector<Genome>& out) const {
+        MigrantHeader header;
+        std::memcpy(&header, inbound_.data(), sizeof(header));
+        if (header.genome_bytes != sizeof(Genome)) return false;
+        out.resize(header.count);
+        if (header.count > 0) std::memcpy(out.data(), inbound_.data() + sizeof(header), header.count * sizeof(Genome));
+        for (Genome& genome : out) sanitize_genome(genome);
+        return true;
+    }
+
+private:
+    MigrationConfig config_;
+    uint64_t interval_ticks_;
+    std::unique_ptr<MigrationTransport> transport_;
+    std::vector<uint8_t> outbound_, inbound_;
+};
@@ -0,0 +1,198 @@
+#include "plant_layer.hpp"
+#include "hex_grid_new.hpp"
+#include "constants.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+// ============================================================================
+// PLANT LAYER IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+// Sprites reach this far from their hex center (flames rise a whole hex)
+const float SPRITE_MARGIN = HEX_SIZE + 2.0f;
+
+uint64_t chunk_key(int cx, int cy) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cx)) << 32) | static_cast<uint32_t>(cy);
+}
+
+int chunk_of(float world) {
+    return static_cast<int>(std::floor(world / PLANT_CHUNK_SIZE));
+}
+
+} // namespace
+
+void PlantLayer::mark_dirty(int q, int r) {
+    auto [x, y] = grid_.axial_to_pixel(q, r);
+    for (int cx = chunk_of(x - SPRITE_MARGIN); cx <= chunk_of(x + SPRITE_MARGIN); ++cx) {
+        for (int cy = chunk_of(y - SPRITE_MARGIN); cy <= chunk_of(y + SPRITE_MARGIN); ++cy) {
+            auto it = chunks_.find(chunk_key(cx, cy));
+            if (it != chunks_.end()) it->second.dirty = true;
+        }
+    }
+}
+
+void PlantLayer::sync(const RenderSnapshot& snapshot) {
+    if (snapshot.publish == synced_) return;
+    if (snapshot.publish > synced_ && snapshot.publish - synced_ <= TILE_CHANGE_WINDOW) {
+        for (const TileChange& change : snapshot.tile_changes) {
+            if (change.publish > synced_) mark_dirty(change.q, change.r);
+        }
+    } else {
+        // Too far behind for the log to say what changed
+        for (auto& [key, chunk] : chunks_) chunk.dirty = true;
+    }
+    synced_ = snapshot.publish;
+}
+
+void PlantLayer::draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, const ViewRect& view,
+                      float zoom, float offset_x, float offset_y) {
+    // A new resolution starts the cache over
+    float scale = std::exp2(std::ceil(std::log2(std::max(1.0f, zoom))));
+    if (scale != scale_) {
+        chunks_.clear();
+        texels_ = 0;
+        scale_ = scale;
+    }
+    frame_++;
+
+    for (int cx = chunk_of(view.left); cx <= chunk_of(view.right); ++cx) {
+        for (int cy = chunk_of(view.top); cy <= chunk_of(view.bottom); ++cy) {
+            Chunk& chunk = chunks_[chunk_key(cx, cy)];
+            if (!chunk.texture) {
+                unsigned size = static_cast<unsigned>(PLANT_CHUNK_SIZE * scale_);
+                chunk.texture = std::make_unique<sf::RenderTexture>();
+                if (!chunk.texture->resize(sf::Vector2u(size, size))) {
+                    std::cerr << "Warning: Could not create plant layer texture" << std::endl;
+                    chunks_.erase(chunk_key(cx, cy));
+                    continue;
+                }
+                chunk.texture->setSmooth(true);
+                chunk.sprite = std::make_unique<sf::Sprite>(chunk.texture->getTexture());
+                chunk.sprite->setScale(sf::Vector2f(1.0f / scale_, 1.0f / scale_));
+                chunk.dirty = true;
+                texels_ += size_t(size) * size;
+            }
+            if (chunk.dirty) {
+                rasterize(chunk, cx, cy, snapshot);
+            }
+            chunk.last_drawn = frame_;
+            chunk.sprite->setPosition(sf::Vector2f(cx * PLANT_CHUNK_SIZE + offset_x, cy * PLANT_CHUNK_SIZE + offset_y));
+            target.draw(*chunk.sprite);
+        }
+    }
+    evict();
+}
+
+void PlantLayer::rasterize(Chunk& chunk, int cx, int cy, const RenderSnapshot& snapshot) {
+    sf::RenderTexture& texture = *chunk.texture;
+    ViewRect area{cx * PLANT_CHUNK_SIZE, cy * PLANT_CHUNK_SIZE, (cx + 1) * PLANT_CHUNK_SIZE, (cy + 1) * PLANT_CHUNK_SIZE};
+    texture.clear(sf::Color::Transparent);
+    texture.setView(sf::View(sf::FloatRect(sf::Vector2f(area.left, area.top), sf::Vector2f(PLANT_CHUNK_SIZE, PLANT_CHUNK_SIZE))));
+
+    // Neighbors' sprites overhang into the chunk, so those are drawn too;
+    // fires go over every plant, as they did when drawn straight to the window
+    ViewRect reach = area.expanded(SPRITE_MARGIN);
+    grid_.for_each_in_rect(reach, [&](int q, int r, float x, float y) {
+        if (const PlantSprite* plant = snapshot.plant_at(q, r)) draw_bush(texture, *plant, x, y);
+    });
+    grid_.for_each_in_rect(reach, [&](int q, int r, float x, float y) {
+        if (const FireSprite* fire = snapshot.fire_at(q, r)) draw_fire(texture, fire_frame(fire->timer), x, y);
+    });
+    texture.display();
+    chunk.dirty = false;
+}
+
+// Drop the longest unseen chunks once the textures outgrow their budget,
+// never one drawn this frame
+void PlantLayer::evict() {
+    while (texels_ > PLANT_LAYER_TEXELS) {
+        auto oldest = chunks_.end();
+        for (auto it = chunks_.begin(); it != chunks_.end(); ++it) {
+            if (it->second.last_drawn == frame_) continue;
+            if (oldest == chunks_.end() || it->second.last_drawn < oldest->second.last_drawn) oldest = it;
+        }
+        if (oldest == chunks_.end()) return;
+        unsigned size = static_cast<unsigned>(PLANT_CHUNK_SIZE * scale_);
+        texels_ -= size_t(size) * size;
+        chunks_.erase(oldest);
+    }
+}
+
+// Overlapping circles in a shape fixed by the tile, so redraws match
+void PlantLayer::draw_bush(sf::RenderTarget& target, const PlantSprite& plant, float x, float y) {
+    uint8_t base_r, base_g, base_b;
+    int num_circles = 1;
+    float base_radius = 2.0f;
+
+    switch (plant.stage) {
+        case SEED:
+            base_r = 139; base_g = 69; base_b = 19; // Brown seed
+            num_circles = 2;
+            base_radius = 2.0f;
+            break;
+        case SPROUT:
+            base_r = 34; base_g = 139; base_b = 34; // Forest green sprout
+            num_circles = 4;
+            base_radius = 3.0f;
+            break;
+        case PLANT:
+            base_r = 0; base_g = 100; base_b = 0; // Dark green plant
+            num_circles = 7;
+            base_radius = 4.0f;
+            break;
+        case CHARRED:
+            base_r = 40; base_g = 40; base_b = 40; // Dark grey charred remains
+            num_circles = 5;
+            base_radius = 3.0f;
+            break;
+    }
+
+    std::mt19937 bush_gen(plant.q * 1000 + plant.r);
+    std::uniform_real_distribution<float> offset_dist(-base_radius * 0.6f, base_radius * 0.6f);
+    std::uniform_real_distribution<float> size_dist(0.7f, 1.3f);
+
+    for (int i = 0; i < num_circles; ++i) {
+        float offset_x = offset_dist(bush_gen);
+        float offset_y = offset_dist(bush_gen);
+        float radius = base_radius * size_dist(bush_gen);
+
+        // Vary color slightly for depth
+        int color_var = (bush_gen() % 40) - 20;
+        uint8_t r = std::clamp(base_r + color_var, 0, 255);
+        uint8_t g = std::clamp(base_g + color_var, 0, 255);
+        uint8_t b = std::clamp(base_b + color_var, 0, 255);
+
+        circle_.setRadius(radius);
+        circle_.setPosition(sf::Vector2f(x + offset_x - radius, y + offset_y - radius));
+        circle_.setFillColor(sf::Color(r, g, b));
+        target.draw(circle_);
+    }
+}
+
+// Red ember under an orange and a yellow flame that grow as the tile burns out
+void PlantLayer::draw_fire(sf::RenderTarget& target, int frame, float x, float y) {
+    float timer = frame * FIRE_FRAME_TIME;
+    float scale = 0.5f + 0.5f * ((5.0f - timer) / 5.0f);
+
+    float radius = 3.0f * scale;
+    circle_.setRadius(radius);
+    circle_.setPosition(sf::Vector2f(x - radius, y - HEX_SIZE / 2 + 3 * scale - radius));
+    circle_.setFillColor(sf::Color(255, 50, 0));
+    target.draw(circle_);
+
+    flame_.setPoint(0, sf::Vector2f(x, y - HEX_SIZE / 2));
+    flame_.setPoint(1, sf::Vector2f(x - 6 * scale, y - HEX_SIZE * scale));
+    flame_.setPoint(2, sf::Vector2f(x + 6 * scale, y - HEX_SIZE * scale));
+    flame_.setFillColor(sf::Color(255, 100, 0));
+    target.draw(flame_);
+
+    flame_.setPoint(0, sf::Vector2f(x, y - HEX_SIZE / 2 + 2 * scale));
+    flame_.setPoint(1, sf::Vector2f(x - 3 * scale, y - HEX_SIZE * 0.8f * scale));
+    flame_.setPoint(2, sf::Vector2f(x + 3 * scale, y - HEX_SIZE * 0.8f * scale));
+    flame_.setFillColor(sf::Color(255, 200, 0));
+    target.draw(flame_);
+}
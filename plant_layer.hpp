@@ -0,0 +1,60 @@
+#pragma once
+
+#include "render_snapshot.hpp"
+#include "camera.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class HexGrid;
+
+// ============================================================================
+// PLANT LAYER - Plants and fires cached in world chunks, redrawn when they change
+// ============================================================================
+
+// The world is cut into PLANT_CHUNK_SIZE squares, each rasterized into its
+// own texture when first seen. When a new snapshot arrives, the chunks
+// holding the tiles it lists as changed since the last one seen (new,
+// removed, new stage or flame size) are marked for redrawing; the rest are
+// one sprite draw each. Flames grow in FIRE_FRAME_TIME steps so a burning
+// tile dirties its chunk a few times a second rather than every frame.
+class PlantLayer {
+public:
+    explicit PlantLayer(const HexGrid& grid) : grid_(grid) {}
+
+    // Mark the chunks of the tiles the snapshot lists as changed since the
+    // last sync; nothing to do if it is the same snapshot
+    void sync(const RenderSnapshot& snapshot);
+
+    // Draw the chunks intersecting the view (world pixels), redrawing dirty
+    // ones first; (offset_x, offset_y) is where the world origin is drawn.
+    // Textures hold zoom rounded up to a power of two pixels per world pixel.
+    void draw(sf::RenderTarget& target, const RenderSnapshot& snapshot, const ViewRect& view,
+              float zoom, float offset_x, float offset_y);
+
+private:
+    struct Chunk {
+        std::unique_ptr<sf::RenderTexture> texture;
+        std::unique_ptr<sf::Sprite> sprite;
+        bool dirty = true;
+        uint64_t last_drawn = 0;  // Frame number, for eviction
+    };
+
+    const HexGrid& grid_;
+    std::unordered_map<uint64_t, Chunk> chunks_;  // By packed chunk coordinates
+    uint64_t synced_ = 0;  // Publish of the last snapshot synced
+    float scale_ = 0.0f;   // Texture pixels per world pixel of every cached chunk
+    uint64_t frame_ = 0;
+    size_t texels_ = 0;    // Held by all chunk textures
+    sf::CircleShape circle_;
+    sf::ConvexShape flame_{3};
+
+    void mark_dirty(int q, int r);
+    void rasterize(Chunk& chunk, int cx, int cy, const RenderSnapshot& snapshot);
+    void evict();
+    void draw_bush(sf::RenderTarget& target, const PlantSprite& plant, float x, float y);
+    void draw_fire(sf::RenderTarget& target, int frame, float x, float y);
+};
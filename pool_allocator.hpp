@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// ============================================================================
+// POOL ALLOCATOR - Recycled nodes for maps and sets on the tick path
+// ============================================================================
+
+// Single-object allocations go back to a per-thread free list instead of the
+// heap, so a node-based container stops allocating once it has reached its
+// peak size and only recycles nodes from then on. Free nodes are kept until
+// their thread exits.
+template <typename T>
+struct PoolAllocator {
+    using value_type = T;
+
+    PoolAllocator() = default;
+    template <typename U> PoolAllocator(const PoolAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        if (n != 1) return static_cast<T*>(::operator new(n * sizeof(T)));
+        if (free_list().head) return static_cast<T*>(free_list().pop());
+        return static_cast<T*>(::operator new(sizeof(Slot)));
+    }
+
+    void deallocate(T* p, std::size_t n) {
+        if (n == 1) {
+            free_list().push(p);
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    template <typename U> bool operator==(const PoolAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const PoolAllocator<U>&) const { return false; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct FreeList {
+        Slot* head = nullptr;
+
+        void push(void* p) {
+            Slot* slot = static_cast<Slot*>(p);
+            slot->next = head;
+            head = slot;
+        }
+        void* pop() {
+            Slot* slot = head;
+            head = slot->next;
+            return slot;
+        }
+        ~FreeList() {
+            while (head) ::operator delete(pop());
+        }
+    };
+
+    static FreeList& free_list() {
+        thread_local FreeList list;
+        return list;
+    }
+};
@@ -0,0 +1,98 @@
+#include "population_graph.hpp"
+#include <algorithm>
+#include <cmath>
+
+// ============================================================================
+// POPULATION GRAPH IMPLEMENTATION
+// ============================================================================
+
+size_t PopulationGraph::add_series(sf::Color color, bool log_scale) {
+    series_.push_back({color, log_scale, {}});
+    series_.back().strip.reserve(capacity_ * 2);
+    clear();  // Existing samples have no value for the new series
+    return series_.size() - 1;
+}
+
+void PopulationGraph::push(const int* values) {
+    int sample_max = 0;
+    float x = static_cast<float>(end_ - base_);
+    for (size_t i = 0; i < series_.size(); ++i) {
+        Series& s = series_[i];
+        float y = s.log_scale ? std::log(values[i] + 1.0f) : static_cast<float>(values[i]);
+        s.strip.push_back(sf::Vertex{sf::Vector2f(x, -y), s.color});
+        sample_max = std::max(sample_max, values[i]);
+    }
+
+    while (!max_queue_.empty() && max_queue_.back().second <= sample_max) max_queue_.pop_back();
+    max_queue_.emplace_back(end_, sample_max);
+    ++end_;
+
+    if (end_ - first_ > capacity_) {
+        ++first_;
+        while (!max_queue_.empty() && max_queue_.front().first < first_) max_queue_.pop_front();
+        if (first_ - base_ >= capacity_) compact();
+    }
+}
+
+void PopulationGraph::compact() {
+    // Runs once every capacity_ samples, so scrolling stays O(1) amortized
+    size_t dropped = static_cast<size_t>(first_ - base_);
+    for (Series& s : series_) {
+        s.strip.erase(s.strip.begin(), s.strip.begin() + dropped);
+        for (sf::Vertex& v : s.strip) v.position.x -= static_cast<float>(dropped);
+    }
+    base_ = first_;
+}
+
+void PopulationGraph::clear() {
+    for (Series& s : series_) s.strip.clear();
+    max_queue_.clear();
+    base_ = first_ = end_ = 0;
+}
+
+void PopulationGraph::sync(const RenderSnapshot& snapshot) {
+    // Series are the five populations, in snapshot order
+    const std::vector<int>* histories[5] = {&snapshot.hare_history, &snapshot.plant_history, &snapshot.salmon_history,
+                                            &snapshot.fox_history, &snapshot.wolf_history};
+    if (series_.size() != 5) return;
+
+    uint64_t count = snapshot.sample_count;
+    size_t available = snapshot.hare_history.size();
+    if (count == end_) return;
+
+    size_t from;
+    if (count < end_ || count - end_ > available) {
+        clear();
+        base_ = first_ = end_ = count - available;
+        from = 0;
+    } else {
+        from = available - static_cast<size_t>(count - end_);
+    }
+
+    int values[5];
+    for (size_t j = from; j < available; ++j) {
+        for (int i = 0; i < 5; ++i) values[i] = (*histories[i])[j];
+        push(values);
+    }
+}
+
+void PopulationGraph::draw(sf::RenderTarget& target, float x, float y, float width, float height) const {
+    size_t count = static_cast<size_t>(end_ - first_);
+    if (count < 2) return;
+
+    int max_count = std::max(max_queue_.front().second, 1);
+    float x_scale = width / (count - 1);
+    float x_offset = x - (first_ - base_) * x_scale;
+    size_t offset = static_cast<size_t>(first_ - base_);
+
+    for (const Series& s : series_) {
+        float y_max = s.log_scale ? std::log(max_count + 1.0f) : static_cast<float>(max_count);
+        // Drawn twice a pixel apart for a 2 px line
+        for (float nudge : {0.0f, 1.0f}) {
+            sf::Transform transform;
+            transform.translate(sf::Vector2f(x_offset, y + height - nudge));
+            transform.scale(sf::Vector2f(x_scale, height / y_max));
+            target.draw(s.strip.data() + offset, count, sf::PrimitiveType::LineStrip, sf::RenderStates(transform));
+        }
+    }
+}
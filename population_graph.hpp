@@ -0,0 +1,55 @@
+#pragma once
+
+#include "render_snapshot.hpp"
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// POPULATION GRAPH - Scrolling line plot appended one sample at a time
+// ============================================================================
+
+// Each series keeps a line strip in sample space (x = sample index, y = the
+// plotted value), so a new sample appends one vertex per series. Scrolling
+// and rescaling to the window's maximum are a render transform; nothing is
+// rebuilt per frame. The largest raw value in the window is tracked with a
+// monotonic queue instead of rescanning the history.
+class PopulationGraph {
+public:
+    explicit PopulationGraph(size_t capacity) : capacity_(capacity) {}
+
+    // Add a series; log-scaled series plot log(v + 1) against log(max + 1)
+    size_t add_series(sf::Color color, bool log_scale);
+
+    // Append one sample, one value per series in add_series order
+    void push(const int* values);
+
+    // Drop every sample (series are kept)
+    void clear();
+
+    // Bring the plot up to date with the snapshot's histories, appending only
+    // samples it has not seen; replay seeks and gaps rebuild from the snapshot
+    void sync(const RenderSnapshot& snapshot);
+
+    // Plot the visible window into the given screen rectangle
+    void draw(sf::RenderTarget& target, float x, float y, float width, float height) const;
+
+private:
+    struct Series {
+        sf::Color color;
+        bool log_scale;
+        std::vector<sf::Vertex> strip;  // Starts at sample base_
+    };
+
+    size_t capacity_;                   // Samples in the visible window
+    std::vector<Series> series_;
+    uint64_t base_ = 0;                 // Sample index of each strip's first vertex
+    uint64_t first_ = 0;                // First visible sample
+    uint64_t end_ = 0;                  // One past the newest sample
+    std::deque<std::pair<uint64_t, int>> max_queue_;  // (sample, max value), values decreasing
+
+    void compact();
+};
@@ -0,0 +1,573 @@
+#include "recording.hpp"
+#include "simulation.hpp"
+#include "constants.hpp"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+// ============================================================================
+// RECORDING IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+constexpr char RECORDING_MAGIC[8] = {'H', 'X', 'R', 'E', 'C', '0', '0', '1'};
+constexpr uint8_t TILE_NO_TERRAIN = 0xFF;
+
+} // namespace
+
+// ============================================================================
+// ENCODING
+// ============================================================================
+
+void RecordWriter::varint(uint64_t v) {
+    while (v >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(v) | 0x80);
+        v >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(v));
+}
+
+void RecordWriter::f32(float v) {
+    uint8_t raw[sizeof(float)];
+    std::memcpy(raw, &v, sizeof(float));
+    bytes.insert(bytes.end(), raw, raw + sizeof(float));
+}
+
+void RecordWriter::animal(const RecordedAnimal& a) {
+    u8(a.species);
+    varint(a.id);
+    varint(a.parent_id);
+    svarint(a.q);
+    svarint(a.r);
+    for (float g : a.genome) f32(g);
+}
+
+uint8_t RecordReader::u8() {
+    if (pos_ >= size_) throw std::runtime_error("Recording truncated");
+    return data_[pos_++];
+}
+
+uint64_t RecordReader::varint() {
+    uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        uint8_t byte = u8();
+        v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return v;
+    }
+    throw std::runtime_error("Recording has a malformed varint");
+}
+
+float RecordReader::f32() {
+    if (pos_ > size_ || size_ - pos_ < sizeof(float)) throw std::runtime_error("Recording truncated");
+    float v;
+    std::memcpy(&v, data_ + pos_, sizeof(float));
+    pos_ += sizeof(float);
+    return v;
+}
+
+RecordedAnimal RecordReader::animal() {
+    RecordedAnimal a;
+    a.species = static_cast<EventSpecies>(u8());
+    a.id = static_cast<uint32_t>(varint());
+    a.parent_id = static_cast<uint32_t>(varint());
+    a.q = static_cast<int>(svarint());
+    a.r = static_cast<int>(svarint());
+    for (float& g : a.genome) g = f32();
+    return a;
+}
+
+void RecordReader::keyframe(RecordedKeyframe& keyframe) {
+    keyframe.tick = varint();
+    keyframe.animals.resize(varint());
+    for (auto& a : keyframe.animals) a = animal();
+    keyframe.plants.resize(varint());
+    for (auto& [coord, stage] : keyframe.plants) {
+        coord.first = static_cast<int>(svarint());
+        coord.second = static_cast<int>(svarint());
+        stage = static_cast<PlantStage>(u8());
+    }
+    keyframe.fires.resize(varint());
+    for (auto& [coord, timer] : keyframe.fires) {
+        coord.first = static_cast<int>(svarint());
+        coord.second = static_cast<int>(svarint());
+        timer = f32();
+    }
+}
+
+void decode_record(RecordReader& in, RecordVisitor& visitor) {
+    uint8_t op = in.u8();
+    switch (op) {
+        case OP_TICK:
+            visitor.on_tick();
+            break;
+        case OP_MOVE_DIR: {
+            uint32_t id = static_cast<uint32_t>(in.varint());
+            int dir = in.u8();
+            visitor.on_move_dir(id, dir % 6);
+            break;
+        }
+        case OP_MOVE_TO: {
+            uint32_t id = static_cast<uint32_t>(in.varint());
+            int q = static_cast<int>(in.svarint());
+            int r = static_cast<int>(in.svarint());
+            visitor.on_move_to(id, q, r);
+            break;
+        }
+        case OP_BIRTH:
+            visitor.on_birth(in.animal());
+            break;
+        case OP_DEATH: {
+            uint32_t id = static_cast<uint32_t>(in.varint());
+            visitor.on_death(id, static_cast<DeathCause>(in.u8()));
+            break;
+        }
+        case OP_PLANT: {
+            int q = static_cast<int>(in.svarint());
+            int r = static_cast<int>(in.svarint());
+            visitor.on_plant(q, r, static_cast<PlantStage>(in.u8()));
+            break;
+        }
+        case OP_PLANT_REMOVED: {
+            int q = static_cast<int>(in.svarint());
+            int r = static_cast<int>(in.svarint());
+            visitor.on_plant_removed(q, r);
+            break;
+        }
+        case OP_FIRE: {
+            int q = static_cast<int>(in.svarint());
+            int r = static_cast<int>(in.svarint());
+            visitor.on_fire(q, r, in.f32());
+            break;
+        }
+        case OP_FIRE_OUT: {
+            int q = static_cast<int>(in.svarint());
+            int r = static_cast<int>(in.svarint());
+            visitor.on_fire_out(q, r);
+            break;
+        }
+        case OP_SAMPLE: {
+            int counts[5];
+            for (int& c : counts) c = static_cast<int>(in.varint());
+            visitor.on_sample(counts);
+            break;
+        }
+        case OP_KEYFRAME: {
+            RecordedKeyframe keyframe;
+            in.keyframe(keyframe);
+            visitor.on_keyframe(keyframe);
+            break;
+        }
+        default:
+            throw std::runtime_error("Recording has an unknown record type " + std::to_string(op));
+    }
+}
+
+// ============================================================================
+// GENOME PACKING
+// ============================================================================
+
+RecordedAnimal record_animal(const Hare& hare) {
+    RecordedAnimal a;
+    a.id = hare.id;
+    a.parent_id = hare.parent_id;
+    a.species = SPECIES_HARE;
+    a.q = hare.q;
+    a.r = hare.r;
+    const HareGenome& g = hare.genome;
+    float values[GENOME_VALUES] = {g.reproduction_threshold, g.movement_aggression, g.weight,
+                                   g.fear, g.movement_efficiency, g.can_burrow ? 1.0f : 0.0f};
+    std::copy(std::begin(values), std::end(values), a.genome);
+    return a;
+}
+
+RecordedAnimal record_animal(const Fox& fox) {
+    RecordedAnimal a;
+    a.id = fox.id;
+    a.parent_id = fox.parent_id;
+    a.species = SPECIES_FOX;
+    a.q = fox.q;
+    a.r = fox.r;
+    const FoxGenome& g = fox.genome;
+    float values[] = {g.reproduction_threshold, g.hunting_aggression, g.weight, g.movement_efficiency};
+    std::copy(std::begin(values), std::end(values), a.genome);
+    return a;
+}
+
+RecordedAnimal record_animal(const Wolf& wolf) {
+    RecordedAnimal a;
+    a.id = wolf.id;
+    a.parent_id = wolf.parent_id;
+    a.species = SPECIES_WOLF;
+    a.q = wolf.q;
+    a.r = wolf.r;
+    const WolfGenome& g = wolf.genome;
+    float values[] = {g.reproduction_threshold, g.hunting_aggression, g.weight, g.movement_efficiency};
+    std::copy(std::begin(values), std::end(values), a.genome);
+    return a;
+}
+
+RecordedAnimal record_animal(const Salmon& salmon) {
+    RecordedAnimal a;
+    a.id = salmon.id;
+    a.parent_id = salmon.parent_id;
+    a.species = SPECIES_SALMON;
+    a.q = salmon.q;
+    a.r = salmon.r;
+    a.genome[0] = salmon.reproduction_threshold;
+    return a;
+}
+
+sf::Color recorded_animal_color(const RecordedAnimal& animal) {
+    switch (animal.species) {
+        case SPECIES_HARE: {
+            // Same genome-based shading as the live hare
+            Hare hare(animal.q, animal.r);
+            hare.genome.fear = animal.genome[3];
+            hare.genome.weight = animal.genome[2];
+            return hare.getColor();
+        }
+        case SPECIES_FOX: return Fox(0, 0).getColor();
+        case SPECIES_WOLF: return Wolf(0, 0).getColor();
+        case SPECIES_SALMON: return Salmon(0, 0).getColor();
+        default: return sf::Color::White;
+    }
+}
+
+// ============================================================================
+// RECORDER
+// ============================================================================
+
+Recorder::Recorder(const std::string& path) {
+    file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file_) {
+        throw std::runtime_error("Failed to create recording file: " + path);
+    }
+}
+
+Recorder::~Recorder() {
+    finish();
+}
+
+void Recorder::begin(const Simulation& sim, float world_width, float world_height) {
+    const HexGrid& grid = sim.grid;
+
+    // World header: everything the replay needs to draw terrain
+    out_.bytes.insert(out_.bytes.end(), std::begin(RECORDING_MAGIC), std::end(RECORDING_MAGIC));
+    out_.f32(grid.hex_size);
+    out_.f32(world_width);
+    out_.f32(world_height);
+    out_.svarint(grid.max_grid_distance);
+    out_.varint(grid.hexagons.size());
+    for (const auto& [coord, pixel] : grid.hexagons) {
+        out_.svarint(coord.first);
+        out_.svarint(coord.second);
+        auto tile = grid.terrainTiles.find(coord);
+        if (tile == grid.terrainTiles.end()) {
+            out_.u8(TILE_NO_TERRAIN);
+            out_.f32(0.0f);
+        } else {
+            out_.u8(tile->second.type);
+            out_.f32(grid.nutrients.get(coord.first, coord.second));
+        }
+    }
+
+    // Start diffing from the current state
+    tick_ = sim.tick_count;
+    last_sample_count_ = sim.sample_count;
+    animals_.clear();
+    auto track = [&](const auto& animals) {
+        for (const auto& a : animals) {
+            if (!a.is_dead) animals_[a.id] = {a.q, a.r, tick_};
+        }
+    };
+    track(sim.hares);
+    track(sim.salmons);
+    track(sim.foxes);
+    track(sim.wolves);
+    plants_.clear();
+    for (const auto& [coord, plant] : grid.plants) {
+        plants_.push_back({coord, plant.stage});
+    }
+    fires_ = grid.fire_timers;
+
+    write_keyframe(sim);
+    flush_if_large();
+}
+
+void Recorder::capture(const Simulation& sim) {
+    out_.u8(OP_TICK);
+    tick_++;
+
+    capture_species(sim.hares);
+    capture_species(sim.salmons);
+    capture_species(sim.foxes);
+    capture_species(sim.wolves);
+
+    // Anything we tracked that is gone without dying was eaten by a hunter
+    for (auto it = animals_.begin(); it != animals_.end(); ) {
+        if (it->second.seen_tick != tick_) {
+            out_.u8(OP_DEATH);
+            out_.varint(it->first);
+            out_.u8(CAUSE_EATEN);
+            it = animals_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    capture_plants(sim.grid);
+    capture_fires(sim.grid);
+
+    if (sim.sample_count != last_sample_count_ && !sim.hare_history.empty()) {
+        out_.u8(OP_SAMPLE);
+        out_.varint(sim.hare_history.back());
+        out_.varint(sim.plant_history.back());
+        out_.varint(sim.salmon_history.back());
+        out_.varint(sim.fox_history.back());
+        out_.varint(sim.wolf_history.back());
+        last_sample_count_ = sim.sample_count;
+    }
+
+    if (tick_ % KEYFRAME_INTERVAL == 0) {
+        write_keyframe(sim);
+    }
+    flush_if_large();
+}
+
+template <typename Animal>
+void Recorder::capture_species(const std::vector<Animal>& animals) {
+    for (const auto& a : animals) {
+        auto it = animals_.find(a.id);
+        if (it == animals_.end()) {
+            out_.u8(OP_BIRTH);
+            out_.animal(record_animal(a));
+            if (a.is_dead) {
+                out_.u8(OP_DEATH);
+                out_.varint(a.id);
+                out_.u8(a.death_cause);
+            } else {
+                animals_[a.id] = {a.q, a.r, tick_};
+            }
+            continue;
+        }
+
+        TrackedAnimal& tracked = it->second;
+        if (a.q != tracked.q || a.r != tracked.r) {
+            int dir = hex_direction(a.q - tracked.q, a.r - tracked.r);
+            if (dir >= 0) {
+                out_.u8(OP_MOVE_DIR);
+                out_.varint(a.id);
+                out_.u8(static_cast<uint8_t>(dir));
+            } else {
+                out_.u8(OP_MOVE_TO);
+                out_.varint(a.id);
+                out_.svarint(a.q);
+                out_.svarint(a.r);
+            }
+            tracked.q = a.q;
+            tracked.r = a.r;
+        }
+        if (a.is_dead) {
+            out_.u8(OP_DEATH);
+            out_.varint(a.id);
+            out_.u8(a.death_cause);
+            animals_.erase(it);
+            continue;
+        }
+        tracked.seen_tick = tick_;
+    }
+}
+
+void Recorder::capture_plants(const HexGrid& grid) {
+    // Both sides are sorted by (q, r), so one merge pass finds every change
+    auto write_plant = [&](const std::pair<int, int>& coord, PlantStage stage) {
+        out_.u8(OP_PLANT);
+        out_.svarint(coord.first);
+        out_.svarint(coord.second);
+        out_.u8(stage);
+    };
+    auto write_removed = [&](const std::pair<int, int>& coord) {
+        out_.u8(OP_PLANT_REMOVED);
+        out_.svarint(coord.first);
+        out_.svarint(coord.second);
+    };
+
+    plants_scratch_.clear();
+    size_t i = 0;
+    for (const auto& [coord, plant] : grid.plants) {
+        while (i < plants_.size() && plants_[i].first < coord) {
+            write_removed(plants_[i++].first);
+        }
+        if (i < plants_.size() && plants_[i].first == coord) {
+            if (plants_[i].second != plant.stage) write_plant(coord, plant.stage);
+            ++i;
+        } else {
+            write_plant(coord, plant.stage);
+        }
+        plants_scratch_.push_back({coord, plant.stage});
+    }
+    while (i < plants_.size()) {
+        write_removed(plants_[i++].first);
+    }
+    plants_.swap(plants_scratch_);
+}
+
+void Recorder::capture_fires(const HexGrid& grid) {
+    for (const auto& [coord, timer] : grid.fire_timers) {
+        auto it = fires_.find(coord);
+        // A timer that went up was (re)ignited since the last tick
+        if (it == fires_.end() || timer > it->second) {
+            out_.u8(OP_FIRE);
+            out_.svarint(coord.first);
+            out_.svarint(coord.second);
+            out_.f32(timer);
+        }
+    }
+    for (const auto& [coord, timer] : fires_) {
+        if (grid.fire_timers.find(coord) == grid.fire_timers.end()) {
+            out_.u8(OP_FIRE_OUT);
+            out_.svarint(coord.first);
+            out_.svarint(coord.second);
+        }
+    }
+    fires_ = grid.fire_timers;
+}
+
+void Recorder::write_keyframe(const Simulation& sim) {
+    keyframe_.tick = tick_;
+    keyframe_.animals.clear();
+    auto add = [&](const auto& animals) {
+        for (const auto& a : animals) {
+            if (!a.is_dead) keyframe_.animals.push_back(record_animal(a));
+        }
+    };
+    add(sim.hares);
+    add(sim.salmons);
+    add(sim.foxes);
+    add(sim.wolves);
+
+    out_.u8(OP_KEYFRAME);
+    out_.varint(keyframe_.tick);
+    out_.varint(keyframe_.animals.size());
+    for (const auto& a : keyframe_.animals) out_.animal(a);
+    out_.varint(plants_.size());
+    for (const auto& [coord, stage] : plants_) {
+        out_.svarint(coord.first);
+        out_.svarint(coord.second);
+        out_.u8(stage);
+    }
+    out_.varint(fires_.size());
+    for (const auto& [coord, timer] : fires_) {
+        out_.svarint(coord.first);
+        out_.svarint(coord.second);
+        out_.f32(timer);
+    }
+}
+
+void Recorder::flush_if_large() {
+    if (out_.bytes.size() < (1u << 16)) return;
+    file_.write(reinterpret_cast<const char*>(out_.bytes.data()), out_.bytes.size());
+    bytes_written_ += out_.bytes.size();
+    out_.bytes.clear();
+}
+
+void Recorder::finish() {
+    if (!file_.is_open()) return;
+    file_.write(reinterpret_cast<const char*>(out_.bytes.data()), out_.bytes.size());
+    bytes_written_ += out_.bytes.size();
+    out_.bytes.clear();
+    file_.close();
+}
+
+// ============================================================================
+// RECORDING LOADER
+// ============================================================================
+
+namespace {
+
+// Walks the stream once to find keyframes and population samples
+class RecordingIndexer : public RecordVisitor {
+public:
+    Recording& recording;
+    uint64_t tick = 0;
+    size_t record_offset = 0;
+
+    explicit RecordingIndexer(Recording& rec) : recording(rec) {}
+
+    void on_tick() override { tick++; }
+    void on_sample(const int* counts) override {
+        PopulationSample sample{tick, {}};
+        std::copy(counts, counts + 5, sample.counts);
+        recording.samples.push_back(sample);
+    }
+    void on_keyframe(const RecordedKeyframe& keyframe) override {
+        if (recording.keyframes.empty()) {
+            tick = keyframe.tick;
+            recording.first_tick = keyframe.tick;
+        }
+        recording.keyframes.push_back({keyframe.tick, record_offset});
+    }
+};
+
+} // namespace
+
+Recording Recording::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open recording: " + path);
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(RECORDING_MAGIC) ||
+        std::memcmp(bytes.data(), RECORDING_MAGIC, sizeof(RECORDING_MAGIC)) != 0) {
+        throw std::runtime_error("Not a HexaWorld recording: " + path);
+    }
+
+    Recording recording;
+    RecordReader header(bytes.data(), bytes.size());
+    header.seek(sizeof(RECORDING_MAGIC));
+    recording.hex_size = header.f32();
+    recording.world_width = header.f32();
+    recording.world_height = header.f32();
+    recording.max_grid_distance = static_cast<int>(header.svarint());
+    recording.tiles.resize(header.varint());
+    for (auto& tile : recording.tiles) {
+        tile.q = static_cast<int>(header.svarint());
+        tile.r = static_cast<int>(header.svarint());
+        uint8_t type = header.u8();
+        tile.has_terrain = type != TILE_NO_TERRAIN;
+        tile.type = tile.has_terrain ? static_cast<TerrainType>(type) : SOIL;
+        tile.nutrients = header.f32();
+    }
+    recording.data.assign(bytes.begin() + header.position(), bytes.end());
+
+    // Index the stream; a recording cut short by a crash keeps its complete records
+    RecordReader in(recording.data.data(), recording.data.size());
+    RecordingIndexer indexer(recording);
+    size_t good_end = 0;
+    uint64_t good_tick = 0;
+    try {
+        while (!in.at_end()) {
+            indexer.record_offset = in.position();
+            decode_record(in, indexer);
+            good_end = in.position();
+            good_tick = indexer.tick;
+        }
+    } catch (const std::runtime_error& e) {
+        std::cerr << "Warning: " << e.what() << " in " << path << ", replaying the first "
+                  << good_tick << " ticks" << std::endl;
+        recording.data.resize(good_end);
+        while (!recording.samples.empty() && recording.samples.back().tick > good_tick) {
+            recording.samples.pop_back();
+        }
+        while (!recording.keyframes.empty() && recording.keyframes.back().offset >= good_end) {
+            recording.keyframes.pop_back();
+        }
+    }
+    if (recording.keyframes.empty()) {
+        throw std::runtime_error("Recording has no keyframe: " + path);
+    }
+    recording.last_tick = good_tick;
+    return recording;
+}
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "hex_grid_new.hpp"
+#include "event_log.hpp"
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class Simulation;
+struct Hare;
+struct Fox;
+struct Wolf;
+struct Salmon;
+
+// ============================================================================
+// RECORDING - Compact per-tick delta stream with periodic keyframes
+// ============================================================================
+//
+// File layout: magic, world header (size, terrain), then a stream of records.
+// Every simulated tick is an OP_TICK followed by that tick's deltas. Every
+// KEYFRAME_INTERVAL ticks an OP_KEYFRAME holds the full state, so a reader
+// can seek by decoding from the nearest keyframe instead of the start.
+// Integers are LEB128 varints (signed ones zigzag encoded), floats raw.
+
+enum RecordOp : uint8_t {
+    OP_TICK,           // Start of the next tick
+    OP_MOVE_DIR,       // id, direction: stepped to a neighbouring hex
+    OP_MOVE_TO,        // id, q, r: moved anywhere else
+    OP_BIRTH,          // species, id, parent, q, r, genome
+    OP_DEATH,          // id, cause
+    OP_PLANT,          // q, r, stage: plant appeared or changed stage
+    OP_PLANT_REMOVED,  // q, r
+    OP_FIRE,           // q, r, timer: hex ignited (or re-ignited)
+    OP_FIRE_OUT,       // q, r
+    OP_SAMPLE,         // hares, plants, salmons, foxes, wolves: population graph sample
+    OP_KEYFRAME        // tick, animals, plants, fires
+};
+
+const int GENOME_VALUES = 6;  // Enough for the largest genome (HareGenome)
+
+// Animal as stored in keyframes and births
+struct RecordedAnimal {
+    uint32_t id = 0;
+    uint32_t parent_id = 0;
+    EventSpecies species = SPECIES_NONE;
+    int q = 0, r = 0;
+    float genome[GENOME_VALUES] = {};  // Genome fields in declaration order
+};
+
+// Hexagon of the recorded world (some hexagons have no terrain tile)
+struct RecordedTile {
+    int q, r;
+    bool has_terrain;
+    TerrainType type;
+    float nutrients;
+};
+
+struct RecordedKeyframe {
+    uint64_t tick = 0;
+    std::vector<RecordedAnimal> animals;
+    std::vector<std::pair<std::pair<int, int>, PlantStage>> plants;
+    std::vector<std::pair<std::pair<int, int>, float>> fires;  // (q, r) -> time left burning
+};
+
+struct PopulationSample {
+    uint64_t tick;
+    int counts[5];  // hares, plants, salmons, foxes, wolves
+};
+
+// Appends records to a byte buffer
+class RecordWriter {
+public:
+    std::vector<uint8_t> bytes;
+
+    void u8(uint8_t v) { bytes.push_back(v); }
+    void varint(uint64_t v);
+    void svarint(int64_t v) { varint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63)); }
+    void f32(float v);
+    void animal(const RecordedAnimal& a);
+};
+
+// Receives decoded records; override what you need
+class RecordVisitor {
+public:
+    virtual ~RecordVisitor() = default;
+    virtual void on_tick() {}
+    virtual void on_move_dir(uint32_t /*id*/, int /*direction*/) {}
+    virtual void on_move_to(uint32_t /*id*/, int /*q*/, int /*r*/) {}
+    virtual void on_birth(const RecordedAnimal& /*animal*/) {}
+    virtual void on_death(uint32_t /*id*/, DeathCause /*cause*/) {}
+    virtual void on_plant(int /*q*/, int /*r*/, PlantStage /*stage*/) {}
+    virtual void on_plant_removed(int /*q*/, int /*r*/) {}
+    virtual void on_fire(int /*q*/, int /*r*/, float /*timer*/) {}
+    virtual void on_fire_out(int /*q*/, int /*r*/) {}
+    virtual void on_sample(const int* /*counts*/) {}
+    virtual void on_keyframe(const RecordedKeyframe& /*keyframe*/) {}
+};
+
+// Decodes records; throws std::runtime_error when reading past the end
+class RecordReader {
+public:
+    RecordReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+    bool at_end() const { return pos_ >= size_; }
+    uint8_t peek() const { return at_end() ? 0xFF : data_[pos_]; }
+    size_t position() const { return pos_; }
+    void seek(size_t pos) { pos_ = pos; }
+
+    uint8_t u8();
+    uint64_t varint();
+    int64_t svarint() { uint64_t v = varint(); return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1); }
+    float f32();
+    RecordedAnimal animal();
+    void keyframe(RecordedKeyframe& keyframe);
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    size_t pos_ = 0;
+};
+
+// Decode the next record and pass it to the visitor
+void decode_record(RecordReader& in, RecordVisitor& visitor);
+
+// Captures a running simulation into a recording file
+class Recorder {
+public:
+    explicit Recorder(const std::string& path);  // Throws if the file cannot be created
+    ~Recorder();
+
+    // Write the header and the initial keyframe
+    void begin(const Simulation& sim, float world_width, float world_height);
+
+    // Record one tick's deltas; called by Simulation::tick before dead animals are removed
+    void capture(const Simulation& sim);
+
+    // Flush everything to disk
+    void finish();
+
+    uint64_t bytes_written() const { return bytes_written_ + out_.bytes.size(); }
+
+private:
+    struct TrackedAnimal {
+        int q, r;
+        uint64_t seen_tick;
+    };
+
+    std::ofstream file_;
+    RecordWriter out_;
+    uint64_t bytes_written_ = 0;
+    uint64_t tick_ = 0;              // Completed ticks recorded
+    uint64_t last_sample_count_ = 0;
+
+    // Last recorded state, diffed against the simulation every tick
+    std::unordered_map<uint32_t, TrackedAnimal, std::hash<uint32_t>, std::equal_to<uint32_t>,
+                       PoolAllocator<std::pair<const uint32_t, TrackedAnimal>>> animals_;
+    std::vector<std::pair<std::pair<int, int>, PlantStage>> plants_;  // Sorted by (q, r)
+    CoordMap<float> fires_;
+
+    std::vector<std::pair<std::pair<int, int>, PlantStage>> plants_scratch_;
+    RecordedKeyframe keyframe_;  // Reused for every keyframe
+
+    template <typename Animal>
+    void capture_species(const std::vector<Animal>& animals);
+    void capture_plants(const HexGrid& grid);
+    void capture_fires(const HexGrid& grid);
+    void write_keyframe(const Simulation& sim);
+    void flush_if_large();
+};
+
+// A whole recording loaded into memory, with its keyframes and samples indexed
+class Recording {
+public:
+    struct Keyframe {
+        uint64_t tick;
+        size_t offset;  // Start of the OP_KEYFRAME record
+    };
+
+    float hex_size = HEX_SIZE;
+    float world_width = 0.0f, world_height = 0.0f;
+    int max_grid_distance = 0;
+    std::vector<RecordedTile> tiles;
+    std::vector<uint8_t> data;             // Record stream after the header
+    uint64_t first_tick = 0;
+    std::vector<Keyframe> keyframes;       // Sorted by tick
+    std::vector<PopulationSample> samples; // Sorted by tick
+    uint64_t last_tick = 0;
+
+    // Throws std::runtime_error on a missing or malformed file
+    static Recording load(const std::string& path);
+};
+
+// Genome packing shared by the recorder and the replay
+RecordedAnimal record_animal(const Hare& hare);
+RecordedAnimal record_animal(const Fox& fox);
+RecordedAnimal record_animal(const Wolf& wolf);
+RecordedAnimal record_animal(const Salmon& salmon);
+
+// Display color of a recorded animal, from its genome where the species has one
+sf::Color recorded_animal_color(const RecordedAnimal& animal);
@@ -0,0 +1,248 @@
+#pragma once
+
+#include "constants.hpp"
+#include "hex_grid_new.hpp"
+#include "hex_math.hpp"
+#include "spatial_index.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// RENDER SNAPSHOT - Immutable view of one simulation tick for the renderer
+// ============================================================================
+
+struct AnimalSprite {
+    uint32_t id;
+    int q, r;
+    float x, y;       // Eased world pixel position, filled in by SpriteEasing
+    sf::Color color;
+    float scale;      // Energy-based size factor
+};
+
+struct PlantSprite {
+    int q, r;
+    PlantStage stage;
+};
+
+struct FireSprite {
+    int q, r;
+    float timer;      // Seconds left burning
+};
+
+// Flame size step a fire is drawn at, so its look changes only a few times a second
+inline int fire_frame(float timer) {
+    return static_cast<int>(timer / FIRE_FRAME_TIME);
+}
+
+// Tile whose plant or fire looked different after the given publish
+struct TileChange {
+    uint64_t publish;
+    int q, r;
+};
+
+struct RenderSnapshot {
+    uint64_t tick = 0;
+    float sim_time = 0.0f;
+    unsigned int time_slices = 1;  // Tick governor load shedding, 1 = none
+
+    std::vector<AnimalSprite> hares;
+    std::vector<AnimalSprite> salmons;
+    std::vector<AnimalSprite> foxes;
+    std::vector<AnimalSprite> wolves;
+    std::vector<PlantSprite> plants;
+    std::vector<FireSprite> fires;
+
+    // Publish number and the tiles that changed look over the last
+    // TILE_CHANGE_WINDOW publishes, oldest first (see TileChangeLog)
+    uint64_t publish = 0;
+    std::vector<TileChange> tile_changes;
+
+    // Sprites bucketed by their hex center, built by whoever fills the
+    // snapshot, so the render thread only visits the cells under the view
+    SpatialIndex hare_index, salmon_index, fox_index, wolf_index;
+
+    // Map brightness follows the animals
+    float brightness_center_q = 0.0f;
+    float brightness_center_r = 0.0f;
+    bool has_alive_animals = false;
+
+    // Population graph, one sample per GRAPH_UPDATE_INTERVAL; the histories
+    // end with sample number sample_count - 1
+    uint64_t sample_count = 0;
+    std::vector<int> hare_history;
+    std::vector<int> plant_history;
+    std::vector<int> salmon_history;
+    std::vector<int> fox_history;
+    std::vector<int> wolf_history;
+
+    // Plant on a tile, or nullptr (plants are sorted by (q, r))
+    const PlantSprite* plant_at(int q, int r) const {
+        auto it = std::lower_bound(plants.begin(), plants.end(), std::make_pair(q, r),
+            [](const PlantSprite& p, const std::pair<int, int>& key) {
+                return std::make_pair(p.q, p.r) < key;
+            });
+        if (it != plants.end() && it->q == q && it->r == r) return &*it;
+        return nullptr;
+    }
+
+    // Rebuild the sprite indices; call once the animal lists are filled
+    void index_animals(float hex_size) {
+        auto center = [hex_size](const AnimalSprite& a) {
+            auto [x, y] = hex_to_pixel(a.q, a.r, hex_size);
+            return sf::Vector2f(x, y);
+        };
+        ViewRect bounds;
+        bool empty = true;
+        for (const auto* sprites : {&hares, &salmons, &foxes, &wolves}) {
+            for (const AnimalSprite& a : *sprites) {
+                sf::Vector2f p = center(a);
+                bounds = empty ? ViewRect{p.x, p.y, p.x, p.y}
+                               : ViewRect{std::min(bounds.left, p.x), std::min(bounds.top, p.y),
+                                          std::max(bounds.right, p.x), std::max(bounds.bottom, p.y)};
+                empty = false;
+            }
+        }
+        hare_index.build(hares, bounds, center);
+        salmon_index.build(salmons, bounds, center);
+        fox_index.build(foxes, bounds, center);
+        wolf_index.build(wolves, bounds, center);
+    }
+
+    // Call fn(fire) for every fire in the axial range covering view, one
+    // binary search per column of the range
+    template <typename Fn>
+    void for_each_fire_in(const HexGrid& grid, const ViewRect& view, Fn fn) const {
+        grid.for_each_column_in_rect(view, [&](int q, int r_min, int r_max) {
+            auto it = std::lower_bound(fires.begin(), fires.end(), std::make_pair(q, r_min),
+                [](const FireSprite& f, const std::pair<int, int>& key) {
+                    return std::make_pair(f.q, f.r) < key;
+                });
+            for (; it != fires.end() && it->q == q && it->r <= r_max; ++it) fn(*it);
+        });
+    }
+
+    // Fire on a tile, or nullptr (fires are sorted by (q, r) too)
+    const FireSprite* fire_at(int q, int r) const {
+        auto it = std::lower_bound(fires.begin(), fires.end(), std::make_pair(q, r),
+            [](const FireSprite& f, const std::pair<int, int>& key) {
+                return std::make_pair(f.q, f.r) < key;
+            });
+        if (it != fires.end() && it->q == q && it->r == r) return &*it;
+        return nullptr;
+    }
+};
+
+// ============================================================================
+// TILE CHANGE LOG - Plant and fire tiles that changed look, per publish
+// ============================================================================
+
+// Kept by whoever fills the snapshots. Each publish compares the snapshot's
+// sorted plant and fire lists with the previous publish's and logs every
+// tile that appeared, vanished, changed stage or moved to the next flame
+// size. The entries of the last TILE_CHANGE_WINDOW publishes go out with
+// the snapshot, so a renderer that skipped a few publishes still sees every
+// change without walking the lists itself.
+class TileChangeLog {
+public:
+    void publish(RenderSnapshot& snapshot) {
+        publish_++;
+        auto changed = [&](int q, int r) { log_.push_back({publish_, q, r}); };
+        compare_sorted(plants_, snapshot.plants,
+                       [](const PlantSprite& a, const PlantSprite& b) { return a.stage == b.stage; }, changed);
+        plants_.assign(snapshot.plants.begin(), snapshot.plants.end());
+
+        fire_scratch_.clear();
+        for (const FireSprite& fire : snapshot.fires) {
+            fire_scratch_.push_back({fire.q, fire.r, fire_frame(fire.timer)});
+        }
+        compare_sorted(fires_, fire_scratch_,
+                       [](const FireLook& a, const FireLook& b) { return a.frame == b.frame; }, changed);
+        fires_.swap(fire_scratch_);
+
+        // Forget the publishes that left the window
+        size_t expired = 0;
+        while (expired < log_.size() && log_[expired].publish + TILE_CHANGE_WINDOW <= publish_) expired++;
+        log_.erase(log_.begin(), log_.begin() + expired);
+
+        snapshot.publish = publish_;
+        snapshot.tile_changes.assign(log_.begin(), log_.end());
+    }
+
+private:
+    // A fire as drawn: its flame size step instead of the exact timer
+    struct FireLook {
+        int q, r;
+        int frame;
+    };
+
+    uint64_t publish_ = 0;
+    std::vector<TileChange> log_;      // Oldest publish first
+    std::vector<PlantSprite> plants_;  // As of the last publish, sorted by (q, r)
+    std::vector<FireLook> fires_;      // Likewise
+    std::vector<FireLook> fire_scratch_;
+
+    // Walk two lists sorted by (q, r) and call changed(q, r) for every tile
+    // that is in only one of them or looks different in each
+    template <typename T, typename Same, typename Changed>
+    static void compare_sorted(const std::vector<T>& before, const std::vector<T>& after, Same same, Changed changed) {
+        size_t i = 0, j = 0;
+        while (i < before.size() || j < after.size()) {
+            bool take_before = j == after.size() ||
+                (i < before.size() && std::make_pair(before[i].q, before[i].r) < std::make_pair(after[j].q, after[j].r));
+            bool take_after = !take_before && (i == before.size() ||
+                std::make_pair(after[j].q, after[j].r) < std::make_pair(before[i].q, before[i].r));
+            if (take_before) {
+                changed(before[i].q, before[i].r);
+                i++;
+            } else if (take_after) {
+                changed(after[j].q, after[j].r);
+                j++;
+            } else {
+                if (!same(before[i], after[j])) changed(after[j].q, after[j].r);
+                i++;
+                j++;
+            }
+        }
+    }
+};
+
+// ============================================================================
+// TRIPLE BUFFER - Lock-free single producer / single consumer handoff
+// ============================================================================
+
+// The producer always has a private buffer to write, the consumer always has a
+// private buffer to read, and the third slot is swapped atomically between
+// them. Neither side ever blocks; the consumer just sees the latest publish.
+template <typename T>
+class TripleBuffer {
+public:
+    // Producer side
+    T& write_buffer() { return buffers_[write_]; }
+    void publish() {
+        int previous = middle_.exchange(write_ | FRESH, std::memory_order_acq_rel);
+        write_ = previous & INDEX_MASK;
+    }
+
+    // Consumer side: returns true if a newer buffer was picked up
+    bool acquire() {
+        if (!(middle_.load(std::memory_order_acquire) & FRESH)) return false;
+        int previous = middle_.exchange(read_, std::memory_order_acq_rel);
+        read_ = previous & INDEX_MASK;
+        return true;
+    }
+    T& read_buffer() { return buffers_[read_]; }
+    const T& read_buffer() const { return buffers_[read_]; }
+
+private:
+    static constexpr int INDEX_MASK = 0x3;
+    static constexpr int FRESH = 0x4;  // Middle slot holds an unread publish
+
+    T buffers_[3];
+    std::atomic<int> middle_{1};
+    int write_ = 0;  // Owned by the producer
+    int read_ = 2;   // Owned by the consumer
+};
@@ -0,0 +1,174 @@
+#include "replay.hpp"
+#include "constants.hpp"
+#include <algorithm>
+
+// ============================================================================
+// REPLAY IMPLEMENTATION
+// ============================================================================
+
+ReplayPlayer::ReplayPlayer(Recording recording)
+    : recording_(std::move(recording)),
+      grid_(recording_.hex_size),
+      in_(recording_.data.data(), recording_.data.size()) {
+    grid_.max_grid_distance = recording_.max_grid_distance;
+    grid_.nutrients.resize(grid_.max_grid_distance);
+    for (const auto& tile : recording_.tiles) {
+        grid_.hexagons[{tile.q, tile.r}] = grid_.axial_to_pixel(tile.q, tile.r);
+        if (tile.has_terrain) {
+            grid_.terrainTiles.insert({{tile.q, tile.r}, TerrainTile(tile.q, tile.r, tile.type)});
+            grid_.nutrients.set(tile.q, tile.r, tile.nutrients);
+        }
+    }
+    seek(recording_.first_tick);
+}
+
+void ReplayPlayer::seek(uint64_t tick) {
+    tick = std::clamp(tick, first_tick(), last_tick());
+
+    // Latest keyframe at or before the target, then decode forward
+    auto keyframe = std::upper_bound(recording_.keyframes.begin(), recording_.keyframes.end(), tick,
+        [](uint64_t t, const Recording::Keyframe& k) { return t < k.tick; });
+    if (keyframe != recording_.keyframes.begin()) --keyframe;
+    in_.seek(keyframe->offset);
+    loading_keyframe_ = true;
+    decode_record(in_, *this);
+    loading_keyframe_ = false;
+
+    while (tick_ < tick && step()) {}
+    accumulator_ = 0.0f;
+    fill_snapshot();
+}
+
+RenderSnapshot& ReplayPlayer::advance(float real_dt) {
+    if (paused) return snapshot_;
+
+    accumulator_ += real_dt * speed;
+    bool advanced = false;
+    while (accumulator_ >= SIM_DT) {
+        if (!step()) {
+            paused = true;  // End of the recording
+            accumulator_ = 0.0f;
+            break;
+        }
+        accumulator_ -= SIM_DT;
+        advanced = true;
+    }
+    if (advanced) fill_snapshot();
+    return snapshot_;
+}
+
+bool ReplayPlayer::step() {
+    // Keyframes only repeat the state we already have
+    while (!in_.at_end() && in_.peek() != OP_TICK) {
+        decode_record(in_, *this);
+    }
+    if (in_.at_end()) return false;
+
+    for (auto& [coord, timer] : fires_) {
+        timer = std::max(0.0f, timer - SIM_DT);
+    }
+
+    decode_record(in_, *this);  // OP_TICK
+    while (!in_.at_end() && in_.peek() != OP_TICK && in_.peek() != OP_KEYFRAME) {
+        decode_record(in_, *this);
+    }
+    return true;
+}
+
+void ReplayPlayer::fill_snapshot() {
+    RenderSnapshot& s = snapshot_;
+    s.tick = tick_;
+    s.sim_time = tick_ * SIM_DT;
+
+    s.hares.clear();
+    s.salmons.clear();
+    s.foxes.clear();
+    s.wolves.clear();
+    float brightness_center_q = 0, brightness_center_r = 0;
+    int alive_count = 0;
+    for (const auto& [id, animal] : animals_) {
+        AnimalSprite sprite{id, animal.info.q, animal.info.r, 0.0f, 0.0f, animal.color, 1.0f};  // Energy is not recorded
+        switch (animal.info.species) {
+            case SPECIES_HARE: s.hares.push_back(sprite); break;
+            case SPECIES_SALMON: s.salmons.push_back(sprite); continue;  // Salmon do not light the map
+            case SPECIES_FOX: s.foxes.push_back(sprite); break;
+            case SPECIES_WOLF: s.wolves.push_back(sprite); break;
+            default: continue;
+        }
+        brightness_center_q += animal.info.q;
+        brightness_center_r += animal.info.r;
+        alive_count++;
+    }
+    s.index_animals(grid_.hex_size);
+    s.has_alive_animals = alive_count > 0;
+    if (s.has_alive_animals) {
+        brightness_center_q /= alive_count;
+        brightness_center_r /= alive_count;
+    }
+    s.brightness_center_q = brightness_center_q;
+    s.brightness_center_r = brightness_center_r;
+
+    s.plants.clear();
+    for (const auto& [coord, stage] : plants_) {
+        s.plants.push_back({coord.first, coord.second, stage});
+    }
+    s.fires.clear();
+    for (const auto& [coord, timer] : fires_) {
+        s.fires.push_back({coord.first, coord.second, timer});
+    }
+
+    // Population graph: the last MAX_HISTORY samples up to the current tick
+    const auto& samples = recording_.samples;
+    auto end = std::upper_bound(samples.begin(), samples.end(), tick_,
+        [](uint64_t t, const PopulationSample& sample) { return t < sample.tick; });
+    auto begin = end - std::min<ptrdiff_t>(end - samples.begin(), MAX_HISTORY);
+    s.sample_count = end - samples.begin();
+    std::vector<int>* histories[5] = {&s.hare_history, &s.plant_history, &s.salmon_history, &s.fox_history, &s.wolf_history};
+    for (int i = 0; i < 5; ++i) {
+        histories[i]->clear();
+        for (auto it = begin; it != end; ++it) {
+            histories[i]->push_back(it->counts[i]);
+        }
+    }
+    tile_changes_.publish(s);
+}
+
+void ReplayPlayer::on_move_dir(uint32_t id, int direction) {
+    auto it = animals_.find(id);
+    if (it == animals_.end()) return;
+    auto [dq, dr] = HEX_DIRECTIONS[direction];
+    it->second.info.q += dq;
+    it->second.info.r += dr;
+}
+
+void ReplayPlayer::on_move_to(uint32_t id, int q, int r) {
+    auto it = animals_.find(id);
+    if (it == animals_.end()) return;
+    it->second.info.q = q;
+    it->second.info.r = r;
+}
+
+void ReplayPlayer::on_birth(const RecordedAnimal& animal) {
+    animals_[animal.id] = {animal, recorded_animal_color(animal)};
+}
+
+void ReplayPlayer::on_death(uint32_t id, DeathCause /*cause*/) {
+    animals_.erase(id);
+}
+
+void ReplayPlayer::on_keyframe(const RecordedKeyframe& keyframe) {
+    if (!loading_keyframe_) return;
+    tick_ = keyframe.tick;
+    animals_.clear();
+    for (const auto& animal : keyframe.animals) {
+        on_birth(animal);
+    }
+    plants_.clear();
+    for (const auto& [coord, stage] : keyframe.plants) {
+        plants_.emplace_hint(plants_.end(), coord, stage);
+    }
+    fires_.clear();
+    for (const auto& [coord, timer] : keyframe.fires) {
+        fires_.emplace_hint(fires_.end(), coord, timer);
+    }
+}
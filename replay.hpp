@@ -0,0 +1,70 @@
+#pragma once
+
+#include "recording.hpp"
+#include "render_snapshot.hpp"
+#include "hex_grid_new.hpp"
+#include <cstdint>
+#include <map>
+#include <utility>
+
+// ============================================================================
+// REPLAY - Plays a recording back without running the simulation
+// ============================================================================
+
+// Rebuilds render snapshots purely from the recorded deltas. Seeking decodes
+// from the nearest keyframe at or before the target tick.
+class ReplayPlayer : private RecordVisitor {
+public:
+    float speed = 1.0f;   // Simulated seconds per real second
+    bool paused = false;
+
+    explicit ReplayPlayer(Recording recording);
+
+    // Terrain of the recorded world, immutable for the whole replay
+    const HexGrid& grid() const { return grid_; }
+    const Recording& recording() const { return recording_; }
+
+    uint64_t tick() const { return tick_; }
+    uint64_t first_tick() const { return recording_.first_tick; }
+    uint64_t last_tick() const { return recording_.last_tick; }
+
+    // Jump to a tick (clamped to the recorded range)
+    void seek(uint64_t tick);
+
+    // Play forward by real_dt seconds at the current speed and return the
+    // state; the caller may ease its sprites in place until the next call
+    RenderSnapshot& advance(float real_dt);
+
+private:
+    struct ReplayAnimal {
+        RecordedAnimal info;
+        sf::Color color;
+    };
+
+    Recording recording_;
+    HexGrid grid_;
+    RecordReader in_;
+    uint64_t tick_ = 0;
+    float accumulator_ = 0.0f;
+    bool loading_keyframe_ = false;
+
+    std::map<uint32_t, ReplayAnimal> animals_;  // By id, i.e. birth order
+    std::map<std::pair<int, int>, PlantStage> plants_;
+    std::map<std::pair<int, int>, float> fires_;
+    RenderSnapshot snapshot_;
+    TileChangeLog tile_changes_;
+
+    bool step();  // Apply one recorded tick; false at the end of the recording
+    void fill_snapshot();
+
+    void on_tick() override { tick_++; }
+    void on_move_dir(uint32_t id, int direction) override;
+    void on_move_to(uint32_t id, int q, int r) override;
+    void on_birth(const RecordedAnimal& animal) override;
+    void on_death(uint32_t id, DeathCause cause) override;
+    void on_plant(int q, int r, PlantStage stage) override { plants_[{q, r}] = stage; }
+    void on_plant_removed(int q, int r) override { plants_.erase({q, r}); }
+    void on_fire(int q, int r, float timer) override { fires_[{q, r}] = timer; }
+    void on_fire_out(int q, int r) override { fires_.erase({q, r}); }
+    void on_keyframe(const RecordedKeyframe& keyframe) override;
+};
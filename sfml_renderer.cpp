@@ -5,7 +5,9 @@
 SFMLRenderer::SFMLRenderer(int width, int height, const std::string& title, bool fullscreen, bool frameless, bool maximized, int antialiasing)
     : deltaTime_(0.0f),
       lastKey_(sf::Keyboard::Key::Unknown),
-      shouldClose_(false) {
+      shouldClose_(false),
+      wheelDelta_(0.0f),
+      mousePosition_(0, 0) {
 
     try {
         sf::ContextSettings settings;
@@ -192,6 +194,12 @@ bool SFMLRenderer::pollEvent() {
                 shouldClose_ = true;
             }
         }
+        if (const auto* wheelEvent = event->getIf<sf::Event::MouseWheelScrolled>()) {
+            if (wheelEvent->wheel == sf::Mouse::Wheel::Vertical) {
+                wheelDelta_ += wheelEvent->delta;
+                mousePosition_ = wheelEvent->position;
+            }
+        }
         return true;
     }
     return false;
@@ -207,12 +215,26 @@ void SFMLRenderer::drawConvexShape(
 
     if (!window_ || points.empty()) return;
 
-    sf::ConvexShape shape(points.size());
+    convex_.setPointCount(points.size());
     for (size_t i = 0; i < points.size(); ++i) {
-        shape.setPoint(i, sf::Vector2f(points[i].first, points[i].second));
+        convex_.setPoint(i, sf::Vector2f(points[i].first, points[i].second));
+    }
+    convex_.setFillColor(sf::Color(r, g, b, a));
+    convex_.setOutlineThickness(0.0f);
+    window_->draw(convex_);
+}
+
+void SFMLRenderer::drawConvexShape(const sf::Vector2f* points, size_t count,
+                                   uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+    if (!window_ || count == 0) return;
+
+    convex_.setPointCount(count);
+    for (size_t i = 0; i < count; ++i) {
+        convex_.setPoint(i, points[i]);
     }
-    shape.setFillColor(sf::Color(r, g, b, a));
-    window_->draw(shape);
+    convex_.setFillColor(sf::Color(r, g, b, a));
+    convex_.setOutlineThickness(0.0f);
+    window_->draw(convex_);
 }
 
 void SFMLRenderer::drawConvexShapeOutline(
@@ -221,14 +243,14 @@ void SFMLRenderer::drawConvexShapeOutline(
 
     if (!window_ || points.empty()) return;
 
-    sf::ConvexShape shape(points.size());
+    convex_.setPointCount(points.size());
     for (size_t i = 0; i < points.size(); ++i) {
-        shape.setPoint(i, sf::Vector2f(points[i].first, points[i].second));
+        convex_.setPoint(i, sf::Vector2f(points[i].first, points[i].second));
     }
-    shape.setFillColor(sf::Color::Transparent);
-    shape.setOutlineColor(sf::Color(r, g, b, a));
-    shape.setOutlineThickness(thickness);
-    window_->draw(shape);
+    convex_.setFillColor(sf::Color::Transparent);
+    convex_.setOutlineColor(sf::Color(r, g, b, a));
+    convex_.setOutlineThickness(thickness);
+    window_->draw(convex_);
 }
 
 void SFMLRenderer::drawText(const std::string& text, float x, float y,
@@ -257,10 +279,10 @@ void SFMLRenderer::drawCircle(float center_x, float center_y, float radius,
                               uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
     if (!window_) return;
 
-    sf::CircleShape circle(radius);
-    circle.setPosition(sf::Vector2f(center_x - radius, center_y - radius));
-    circle.setFillColor(sf::Color(r, g, b, a));
-    window_->draw(circle);
+    circle_.setRadius(radius);
+    circle_.setPosition(sf::Vector2f(center_x - radius, center_y - radius));
+    circle_.setFillColor(sf::Color(r, g, b, a));
+    window_->draw(circle_);
 }
 
 void SFMLRenderer::drawLine(float x1, float y1, float x2, float y2,
@@ -285,10 +307,10 @@ void SFMLRenderer::drawLine(float x1, float y1, float x2, float y2,
 // HEXAGON POINT CALCULATION - DO NOT MODIFY
 // Uses 0° starting angle for flat-top hexagons (verified with FlatHexagon)
 // ============================================================================
-std::vector<sf::Vector2f> SFMLRenderer::calculateHexagonPoints(
+HexPoints SFMLRenderer::calculateHexagonPoints(
     float center_x, float center_y, float side_length) const {
 
-    std::vector<sf::Vector2f> points(6);
+    HexPoints points;
     const float angle_offset = 0.0f; // 0 degrees for flat-top hexagons
 
     for (int i = 0; i < 6; ++i) {
@@ -368,6 +390,27 @@ sf::Keyboard::Key SFMLRenderer::getLastKey() const {
     return lastKey_;
 }
 
+float SFMLRenderer::consumeWheelDelta() {
+    float delta = wheelDelta_;
+    wheelDelta_ = 0.0f;
+    return delta;
+}
+
+sf::Vector2i SFMLRenderer::getMousePosition() const {
+    return mousePosition_;
+}
+
+void SFMLRenderer::setCameraView(float center_x, float center_y, float zoom) {
+    if (!window_) return;
+    sf::Vector2f size(static_cast<float>(getWidth()) / zoom, static_cast<float>(getHeight()) / zoom);
+    window_->setView(sf::View(sf::Vector2f(center_x, center_y), size));
+}
+
+void SFMLRenderer::resetView() {
+    if (!window_) return;
+    window_->setView(window_->getDefaultView());
+}
+
 void SFMLRenderer::setFramerateLimit(unsigned int limit) {
     if (window_) {
         window_->setFramerateLimit(limit);
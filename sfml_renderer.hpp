@@ -1,11 +1,14 @@
 #pragma once
 
 #include <SFML/Graphics.hpp>
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <string>
 #include <memory>
 
+using HexPoints = std::array<sf::Vector2f, 6>;
+
 class SFMLRenderer {
 public:
     SFMLRenderer(int width, int height, const std::string& title, bool fullscreen, bool frameless = false, bool maximized = false, int antialiasing = 0);
@@ -21,6 +24,8 @@ public:
     // Drawing primitives
     void drawConvexShape(const std::vector<std::pair<float, float>>& points,
                         uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
+    void drawConvexShape(const sf::Vector2f* points, size_t count,
+                        uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255);
 
     void drawConvexShapeOutline(const std::vector<std::pair<float, float>>& points,
                                uint8_t r, uint8_t g, uint8_t b, uint8_t a = 255,
@@ -53,6 +58,12 @@ public:
     // Input handling
     bool isKeyPressed(int key) const;
     sf::Keyboard::Key getLastKey() const;
+    float consumeWheelDelta();          // Mouse wheel notches since last call
+    sf::Vector2i getMousePosition() const;
+
+    // Camera: world drawing goes through a view centered on (center_x, center_y)
+    void setCameraView(float center_x, float center_y, float zoom);
+    void resetView();                   // Back to screen space for HUD drawing
 
     // Performance
     void setFramerateLimit(unsigned int limit);
@@ -64,11 +75,14 @@ public:
 
     // Utility
     sf::RenderWindow* getWindow() const;
-    std::vector<sf::Vector2f> calculateHexagonPoints(float center_x, float center_y, float side_length) const;
+    const sf::Font& getFont() const { return *font_; }
+    HexPoints calculateHexagonPoints(float center_x, float center_y, float side_length) const;
 
     // Sprite access
     sf::Sprite& getHareSprite() { return *hare_sprite_; }
     sf::Sprite& getFoxSprite() { return *fox_sprite_; }
+    const sf::Texture& getHareTexture() const { return hare_texture_.getTexture(); }  // 64x64, centered
+    const sf::Texture& getFoxTexture() const { return fox_texture_.getTexture(); }
     void drawSprite(float x, float y, sf::Color color, sf::Sprite& sprite, float scale = 1.0f);
 
 private:
@@ -78,6 +92,12 @@ private:
     float deltaTime_;
     sf::Keyboard::Key lastKey_;
     bool shouldClose_;
+    float wheelDelta_;
+    sf::Vector2i mousePosition_;
+
+    // Reused by the primitive helpers so drawing does not allocate per call
+    sf::ConvexShape convex_;
+    sf::CircleShape circle_;
 
     // Precomputed sprites
     sf::RenderTexture hare_texture_{sf::Vector2u(64, 64)};
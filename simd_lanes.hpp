@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define HEXAWORLD_SSE2 1
+#endif
+
+// ============================================================================
+// SIMD LANES - Width-generic float operations shared by the batch kernels
+// ============================================================================
+
+// Lane masks are all ones or all zeros so they load straight into SIMD registers
+using LaneMask = uint32_t;
+const LaneMask LANE_ON = 0xFFFFFFFFu;
+const LaneMask LANE_OFF = 0;
+
+// Each lane type provides the same operations, so every kernel is written
+// once and run wide over the bulk of the batch and scalar over the tail.
+// min/max/select keep the operand order of the SIMD instructions, which
+// also matches std::max(0.0f, x) and std::min(1.0f, x) exactly.
+// exponent/mantissa split a positive normal float like std::frexp, into
+// a mantissa in [0.5, 1) and a power of two.
+struct ScalarLanes {
+    using F = float;
+    using M = bool;
+    static constexpr size_t WIDTH = 1;
+
+    static F load(const float* p) { return *p; }
+    static F load_int(const int32_t* p) { return static_cast<float>(*p); }
+    static void store(float* p, F v) { *p = v; }
+    static M load_mask(const LaneMask* p) { return *p != LANE_OFF; }
+    static void store_mask(LaneMask* p, M m) { *p = m ? LANE_ON : LANE_OFF; }
+    static F splat(float v) { return v; }
+    static F add(F a, F b) { return a + b; }
+    static F sub(F a, F b) { return a - b; }
+    static F mul(F a, F b) { return a * b; }
+    static F div(F a, F b) { return a / b; }
+    static F sqrt(F a) { return std::sqrt(a); }
+    static F exponent(F a) { int e; std::frexp(a, &e); return static_cast<float>(e); }
+    static F mantissa(F a) { int e; return std::frexp(a, &e); }
+    static F max(F a, F b) { return a > b ? a : b; }
+    static F min(F a, F b) { return a < b ? a : b; }
+    static M lt(F a, F b) { return a < b; }
+    static M le(F a, F b) { return a <= b; }
+    static M gt(F a, F b) { return a > b; }
+    static M both(M a, M b) { return a && b; }
+    static F select(M m, F a, F b) { return m ? a : b; }
+};
+
+#if defined(__AVX2__)
+struct AvxLanes {
+    using F = __m256;
+    using M = __m256;
+    static constexpr size_t WIDTH = 8;
+
+    static F load(const float* p) { return _mm256_loadu_ps(p); }
+    static F load_int(const int32_t* p) { return _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    static void store(float* p, F v) { _mm256_storeu_ps(p, v); }
+    static M load_mask(const LaneMask* p) { return _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))); }
+    static void store_mask(LaneMask* p, M m) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), _mm256_castps_si256(m)); }
+    static F splat(float v) { return _mm256_set1_ps(v); }
+    static F add(F a, F b) { return _mm256_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm256_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm256_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm256_div_ps(a, b); }
+    static F sqrt(F a) { return _mm256_sqrt_ps(a); }
+    static F exponent(F a) {
+        __m256i biased = _mm256_srli_epi32(_mm256_castps_si256(a), 23);
+        return _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(126)));
+    }
+    static F mantissa(F a) {
+        __m256i bits = _mm256_and_si256(_mm256_castps_si256(a), _mm256_set1_epi32(0x007FFFFF));
+        return _mm256_castsi256_ps(_mm256_or_si256(bits, _mm256_set1_epi32(0x3F000000)));
+    }
+    static F max(F a, F b) { return _mm256_max_ps(a, b); }
+    static F min(F a, F b) { return _mm256_min_ps(a, b); }
+    static M lt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static M le(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static M gt(F a, F b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static M both(M a, M b) { return _mm256_and_ps(a, b); }
+    static F select(M m, F a, F b) { return _mm256_blendv_ps(b, a, m); }
+};
+using WideLanes = AvxLanes;
+#elif defined(HEXAWORLD_SSE2)
+struct SseLanes {
+    using F = __m128;
+    using M = __m128;
+    static constexpr size_t WIDTH = 4;
+
+    static F load(const float* p) { return _mm_loadu_ps(p); }
+    static F load_int(const int32_t* p) { return _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    static void store(float* p, F v) { _mm_storeu_ps(p, v); }
+    static M load_mask(const LaneMask* p) { return _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))); }
+    static void store_mask(LaneMask* p, M m) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_castps_si128(m)); }
+    static F splat(float v) { return _mm_set1_ps(v); }
+    static F add(F a, F b) { return _mm_add_ps(a, b); }
+    static F sub(F a, F b) { return _mm_sub_ps(a, b); }
+    static F mul(F a, F b) { return _mm_mul_ps(a, b); }
+    static F div(F a, F b) { return _mm_div_ps(a, b); }
+    static F sqrt(F a) { return _mm_sqrt_ps(a); }
+    static F exponent(F a) {
+        __m128i biased = _mm_srli_epi32(_mm_castps_si128(a), 23);
+        return _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(126)));
+    }
+    static F mantissa(F a) {
+        __m128i bits = _mm_and_si128(_mm_castps_si128(a), _mm_set1_epi32(0x007FFFFF));
+        return _mm_castsi128_ps(_mm_or_si128(bits, _mm_set1_epi32(0x3F000000)));
+    }
+    static F max(F a, F b) { return _mm_max_ps(a, b); }
+    static F min(F a, F b) { return _mm_min_ps(a, b); }
+    static M lt(F a, F b) { return _mm_cmplt_ps(a, b); }
+    static M le(F a, F b) { return _mm_cmple_ps(a, b); }
+    static M gt(F a, F b) { return _mm_cmpgt_ps(a, b); }
+    static M both(M a, M b) { return _mm_and_ps(a, b); }
+    static F select(M m, F a, F b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+};
+using WideLanes = SseLanes;
+#else
+using WideLanes = ScalarLanes;
+#endif
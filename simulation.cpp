@@ -0,0 +1,1130 @@
+#include "simulation.hpp"
+#include "animals/species.hpp"
+#include "constants.hpp"
+#include "event_log.hpp"
+#include "recording.hpp"
+#include "migration.hpp"
+#include "column_export.hpp"
+#include "world_map.hpp"
+#include "world_digest.hpp"
+#include "alloc_counter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+// Shared by everything that draws randomness on the simulation thread;
+// reseeded by whoever creates the world
+std::mt19937 gen(RANDOM_SEED);
+
+// ============================================================================
+// WORLD GENERATION
+// ============================================================================
+
+void Simulation::generate(float world_width, float world_height) {
+    // Center the grid in the world
+    float center_x = world_width / 2.0f;
+    float center_y = world_height / 2.0f;
+
+    // Set max grid distance based on vertical screen space
+    float hex_vertical_spacing = HEX_SIZE * SQRT3;
+    int max_dist = static_cast<int>(center_y / hex_vertical_spacing);
+    grid.max_grid_distance = max_dist;
+
+    // Add center hexagon
+    grid.add_hexagon(0, 0);
+
+    // Expand grid to fill screen by adding neighbors that fit fully
+    const float sqrt3 = SQRT3;
+    while (true) {
+        size_t old_size = grid.hexagons.size();
+        grid.create_neighbors();
+        // Remove hexagons that are not fully visible
+        for (auto it = grid.hexagons.begin(); it != grid.hexagons.end(); ) {
+            auto [x, y] = it->second;
+            float cx = x + center_x;
+            float cy = y + center_y;
+            float left = cx - HEX_SIZE;
+            float right = cx + HEX_SIZE;
+            float top = cy - HEX_SIZE * sqrt3 / 2.0f;
+            float bottom = cy + HEX_SIZE * sqrt3 / 2.0f;
+            if (left < 0 || right > world_width || top < 0 || bottom > world_height) {
+                it = grid.hexagons.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        if (grid.hexagons.size() == old_size) break;
+    }
+
+    // Remove terrain and plants for removed hexagons
+    for (auto it = grid.terrainTiles.begin(); it != grid.terrainTiles.end(); ) {
+        if (grid.hexagons.find(it->first) == grid.hexagons.end()) {
+            it = grid.terrainTiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = grid.plants.begin(); it != grid.plants.end(); ) {
+        if (grid.hexagons.find(it->first) == grid.hexagons.end()) {
+            it = grid.plants.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Remove isolated water tiles
+    for (auto it = grid.terrainTiles.begin(); it != grid.terrainTiles.end(); ) {
+        auto [q, r] = it->first;
+        if (it->second.type == WATER) {
+            bool has_water_neighbor = false;
+            for (int dir = 0; dir < 6; ++dir) {
+                auto [nq, nr] = hex_neighbor(q, r, dir);
+                auto nit = grid.terrainTiles.find({nq, nr});
+                if (nit != grid.terrainTiles.end() && nit->second.type == WATER) {
+                    has_water_neighbor = true;
+                    break;
+                }
+            }
+            if (!has_water_neighbor) {
+                it = grid.terrainTiles.erase(it);
+                continue;
+            }
+        }
+        ++it;
+    }
+
+    // Plants are now spawned in add_hexagon, but ensure some exist
+    std::vector<std::pair<int, int>> soil_coords;
+    // Add extra plants if needed
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (tile.type == SOIL) {
+            soil_coords.push_back(coord);
+        }
+    }
+    std::shuffle(soil_coords.begin(), soil_coords.end(), gen);
+    size_t num_mature = std::min<size_t>(soil_coords.size() / 2, soil_coords.size());
+    size_t num_sprouts = std::min<size_t>(soil_coords.size() / 4, soil_coords.size());
+    // Place mature plants first
+    for (size_t i = 0; i < num_mature; ++i) {
+        auto [q, r] = soil_coords[i];
+        grid.plants.insert({{q, r}, Plant(q, r, PLANT, grid.nutrients.get(q, r))});
+    }
+    // Then sprouts
+    for (size_t i = num_mature; i < num_mature + num_sprouts; ++i) {
+        auto [q, r] = soil_coords[i];
+        grid.plants.insert({{q, r}, Plant(q, r, SPROUT, grid.nutrients.get(q, r))});
+    }
+    // Then seeds
+    for (size_t i = num_mature + num_sprouts; i < soil_coords.size(); ++i) {
+        auto [q, r] = soil_coords[i];
+        grid.plants.insert({{q, r}, Plant(q, r, SEED, grid.nutrients.get(q, r))});
+    }
+
+    finish_world();
+    spawn_animals();
+}
+
+void Simulation::load_map(const WorldMap& map) {
+    const WorldMapHeader& header = map.header();
+    const uint8_t* terrain = map.terrain();
+    const float* nutrients = map.nutrients();
+    const uint8_t* plants = map.plants();
+    grid.max_grid_distance = header.radius;
+    grid.nutrients.resize(header.radius);
+    grid.nutrients.assign(nutrients);
+
+    // Cells run in (q, r) order, the maps' own order, so every insert goes at the end
+    for (int q = -header.radius; q <= header.radius; ++q) {
+        for (int r = -header.radius; r <= header.radius; ++r) {
+            size_t i = map.index(q, r);
+            if (terrain[i] == MAP_NO_HEXAGON) continue;
+            grid.hexagons.emplace_hint(grid.hexagons.end(), std::make_pair(q, r), grid.axial_to_pixel(q, r));
+            if (terrain[i] <= ROCK) {
+                grid.terrainTiles.emplace_hint(grid.terrainTiles.end(), std::make_pair(q, r),
+                                               TerrainTile(q, r, static_cast<TerrainType>(terrain[i])));
+            }
+            if (plants[i] <= CHARRED) {
+                grid.plants.emplace_hint(grid.plants.end(), std::make_pair(q, r),
+                                         Plant(q, r, static_cast<PlantStage>(plants[i]), nutrients[i]));
+            }
+        }
+    }
+
+    finish_world();
+    if (header.spawn_count == 0) {
+        spawn_animals();
+        return;
+    }
+    salmon_timers.reset(tick_count);
+    const MapSpawn* spawns = map.spawns();
+    for (uint32_t i = 0; i < header.spawn_count; ++i) {
+        if (!spawn(static_cast<EventSpecies>(spawns[i].species), spawns[i].q, spawns[i].r)) {
+            std::cerr << "Warning: Map founder " << i << " cannot be placed at (" << spawns[i].q << ", " << spawns[i].r << ")" << std::endl;
+        }
+    }
+}
+
+// Terrain summary and the per-tile fields, once the tiles are in place
+void Simulation::finish_world() {
+    // Log terrain counts
+    int soil_count = 0, water_count = 0, rock_count = 0;
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (tile.type == SOIL) soil_count++;
+        else if (tile.type == WATER) water_count++;
+        else if (tile.type == ROCK) rock_count++;
+    }
+    event_log.emit(EVENT_TERRAIN, LOG_INFO, SPECIES_NONE, 0, 0,
+                   {static_cast<float>(soil_count), static_cast<float>(water_count), static_cast<float>(rock_count)});
+
+    // Per-tile fields; nutrients only flow between soil tiles
+    for (HexField* field : {&soil_mask, &grid.hare_density, &grid.fox_density, &grid.fox_neighbors}) {
+        field->resize(grid.max_grid_distance);
+    }
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (tile.type == SOIL && grid.has_hexagon(coord.first, coord.second)) {
+            soil_mask.set(coord.first, coord.second, 1.0f);
+        }
+    }
+}
+
+void Simulation::spawn_animals() {
+    // Create hares on plant tiles
+    std::vector<std::pair<int, int>> plant_coords;
+    for (const auto& [coord, plant] : grid.plants) {
+        if (plant.stage == PLANT) {
+            plant_coords.push_back(coord);
+        }
+    }
+
+    size_t grid_size = grid.hexagons.size();
+    // Place hares at the 6 corners of the map
+    std::vector<std::pair<int, int>> corner_positions = {
+        {grid.max_grid_distance, 0},
+        {grid.max_grid_distance, -grid.max_grid_distance},
+        {0, -grid.max_grid_distance},
+        {-grid.max_grid_distance, 0},
+        {-grid.max_grid_distance, grid.max_grid_distance},
+        {0, grid.max_grid_distance}
+    };
+    for (auto [q, r] : corner_positions) {
+        if (grid.has_hexagon(q, r) && grid.get_terrain_type(q, r) == SOIL) {
+            hares.emplace_back(q, r);
+            hares.back().id = next_id++;
+            // Randomize genome for initial population
+            std::uniform_real_distribution<float> thresh_dist(1.0f, 2.0f);
+            std::uniform_real_distribution<float> aggression_dist(0.0f, 1.0f);
+            std::uniform_real_distribution<float> weight_dist(0.5f, 1.5f);
+            std::uniform_real_distribution<float> fear_dist(0.0f, 1.0f);
+            std::uniform_real_distribution<float> efficiency_dist(0.5f, 1.5f);
+            hares.back().genome.reproduction_threshold = thresh_dist(gen);
+            hares.back().genome.movement_aggression = aggression_dist(gen);
+            hares.back().genome.weight = weight_dist(gen);
+            hares.back().genome.fear = fear_dist(gen);
+            hares.back().genome.movement_efficiency = efficiency_dist(gen);
+            grid.hare_positions.insert({q, r});
+        }
+    }
+
+    // Create salmons on water tiles
+    std::vector<std::pair<int, int>> water_coords;
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (tile.type == WATER) {
+            water_coords.push_back(coord);
+        }
+    }
+    std::shuffle(water_coords.begin(), water_coords.end(), gen);
+    size_t num_salmons = std::max<size_t>(5, grid_size / 2000);
+    num_salmons = std::min(num_salmons, water_coords.size());
+    salmon_timers.reset(tick_count);
+    for (size_t i = 0; i < num_salmons; ++i) {
+        auto [q, r] = water_coords[i];
+        salmons.emplace_back(q, r);
+        salmons.back().id = next_id++;
+        salmons.back().energy_tick = tick_count;
+        salmons.back().wake_tick = tick_count + 1 + i % Salmon::move_ticks();  // Staggered, so they don't all swim on one tick
+        schedule_salmon(salmons.size() - 1);
+    }
+
+    // Create foxes on soil tiles
+    std::vector<std::pair<int, int>> fox_soil_coords;
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (tile.type == SOIL) {
+            fox_soil_coords.push_back(coord);
+        }
+    }
+    std::shuffle(fox_soil_coords.begin(), fox_soil_coords.end(), gen);
+    size_t num_foxes = std::max<size_t>(2, grid_size / 1500);
+    num_foxes = std::min(num_foxes, fox_soil_coords.size());
+    for (size_t i = 0; i < num_foxes; ++i) {
+        auto [q, r] = fox_soil_coords[i];
+        foxes.emplace_back(q, r);
+        foxes.back().id = next_id++;
+        // Randomize genome for initial population
+        std::uniform_real_distribution<float> thresh_dist(2.5f, 4.5f);
+        std::uniform_real_distribution<float> aggression_dist(0.0f, 1.0f);
+        std::uniform_real_distribution<float> weight_dist(0.5f, 1.5f);
+        std::uniform_real_distribution<float> efficiency_dist(0.5f, 1.5f);
+        foxes.back().genome.reproduction_threshold = thresh_dist(gen);
+        foxes.back().genome.hunting_aggression = aggression_dist(gen);
+        foxes.back().genome.weight = weight_dist(gen);
+        foxes.back().genome.movement_efficiency = efficiency_dist(gen);
+    }
+
+    // Create wolves on soil tiles
+    std::vector<std::pair<int, int>> wolf_soil_coords;
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (tile.type == SOIL) {
+            wolf_soil_coords.push_back(coord);
+        }
+    }
+    std::shuffle(wolf_soil_coords.begin(), wolf_soil_coords.end(), gen);
+    size_t num_wolves = std::max<size_t>(1, grid_size / 3000);
+    num_wolves = std::min(num_wolves, wolf_soil_coords.size());
+    for (size_t i = 0; i < num_wolves; ++i) {
+        auto [q, r] = wolf_soil_coords[i];
+        wolves.emplace_back(q, r);
+        wolves.back().id = next_id++;
+        // Randomize genome for initial population
+        std::uniform_real_distribution<float> thresh_dist(5.0f, 7.0f);
+        std::uniform_real_distribution<float> aggression_dist(0.0f, 1.0f);
+        std::uniform_real_distribution<float> weight_dist(0.5f, 1.5f);
+        std::uniform_real_distribution<float> efficiency_dist(0.5f, 1.5f);
+        wolves.back().genome.reproduction_threshold = thresh_dist(gen);
+        wolves.back().genome.hunting_aggression = aggression_dist(gen);
+        wolves.back().genome.weight = weight_dist(gen);
+        wolves.back().genome.movement_efficiency = efficiency_dist(gen);
+    }
+
+    // Founders in id order
+    for (const auto& hare : hares) lineage.add(record_animal(hare), nullptr, tick_count);
+    for (const auto& salmon : salmons) lineage.add(record_animal(salmon), nullptr, tick_count);
+    for (const auto& fox : foxes) lineage.add(record_animal(fox), nullptr, tick_count);
+    for (const auto& wolf : wolves) lineage.add(record_animal(wolf), nullptr, tick_count);
+}
+
+// ============================================================================
+// SIMULATION TICK
+// ============================================================================
+
+void Simulation::tick(float dt) {
+    // Charge heap allocations and time to the phase that spent them
+    uint64_t mark = thread_allocation_count();
+    auto phase_start = std::chrono::steady_clock::now();
+    auto end_phase = [&](TickPhase phase) {
+        uint64_t now = thread_allocation_count();
+        phase_allocations[phase] += now - mark;
+        mark = now;
+        auto end = std::chrono::steady_clock::now();
+        phase_seconds[phase] += std::chrono::duration<double>(end - phase_start).count();
+        phase_start = end;
+    };
+
+    // Under load, bookkeeping runs every time_slices ticks on the time gathered since
+    deferred_dt += dt;
+    bool bookkeeping = time_slices <= 1 || tick_count % time_slices == 0;
+
+    event_log.set_tick(tick_count);
+    if (bookkeeping) update_plants(deferred_dt);
+    end_phase(PHASE_PLANTS);
+    if (bookkeeping) update_fires(deferred_dt);
+    end_phase(PHASE_FIRES);
+    update_animals(dt);
+    end_phase(PHASE_ANIMALS);
+    handle_births();
+    exchange_migrants();
+    end_phase(PHASE_BIRTHS);
+    if (bookkeeping) {
+        sample_populations(deferred_dt);
+        deferred_dt = 0.0f;
+    }
+    if (recorder) {
+        recorder->capture(*this);  // Sees this tick's dead before they are removed
+    }
+    remove_dead();
+    if (exporter) {
+        exporter->capture(*this);  // Live agents only
+    }
+    if (tick_count % LINEAGE_PRUNE_INTERVAL == 0) {
+        lineage.prune();
+    }
+    end_phase(PHASE_BOOKKEEPING);
+    tick_count++;
+    sim_time += dt;
+    if (digest_trace) {
+        digest_trace->record(*this);
+    }
+}
+
+void Simulation::schedule_salmon(size_t index) {
+    const Salmon& salmon = salmons[index];
+    salmon_timers.schedule(salmon.wake_tick, {salmon.id, static_cast<uint32_t>(index)});
+}
+
+void Simulation::update_plants(float dt) {
+    // Carcass nutrients spread into neighbouring soil
+    nutrient_timer += dt;
+    if (nutrient_timer >= NUTRIENT_DIFFUSION_INTERVAL) {
+        grid.nutrients.diffuse(soil_mask, NUTRIENT_DIFFUSION_RATE, 0.0f, nutrient_timer);
+        nutrient_timer = 0.0f;
+    }
+
+    // Update plant growth
+    for (auto& [coord, plant] : grid.plants) {
+        plant.growth_time += dt;
+
+        // Charred plants regrow after 30 seconds
+        if (plant.stage == CHARRED) {
+            if (plant.growth_time >= 30.0f) {
+                plant.stage = SEED;
+                plant.growth_time = 0.0f;
+            }
+            continue; // Skip normal growth processing
+        }
+
+        float threshold = 20.0f / (plant.nutrients + 0.1f); // Slower growth
+        if (plant.growth_time >= threshold) {
+            if (plant.stage < PLANT) {
+                plant.stage = static_cast<PlantStage>(plant.stage + 1);
+            }
+            plant.growth_time = 0.0f;
+        }
+
+        // Mature plants drop seeds randomly
+        if (plant.stage == PLANT) {
+            plant.drop_time += dt;
+            if (plant.drop_time >= 10.0f) { // Every 10 seconds
+                if ((gen() % 100) < 20) { // 20% chance
+                    // Drop seeds in soil neighbors without plants
+                    for (int dir = 0; dir < 6; ++dir) {
+                        auto [nq, nr] = hex_neighbor(plant.q, plant.r, dir);
+                        if (grid.has_hexagon(nq, nr) &&
+                            grid.get_terrain_type(nq, nr) == SOIL &&
+                            !grid.get_plant(nq, nr)) {
+                            grid.plants.insert({{nq, nr}, Plant(nq, nr, SEED, grid.nutrients.get(nq, nr))});
+                        }
+                    }
+                }
+                plant.drop_time = 0.0f;
+            }
+        }
+    }
+}
+
+void Simulation::update_fires(float dt) {
+    // Update fires
+    for (auto it = grid.fire_timers.begin(); it != grid.fire_timers.end(); ) {
+        it->second -= dt;
+        if (it->second <= 0) {
+            auto coord = it->first;
+            // Burn the plant - set to CHARRED state
+            auto plant_it = grid.plants.find(coord);
+            if (plant_it != grid.plants.end()) {
+                plant_it->second.stage = CHARRED;
+                plant_it->second.growth_time = 0.0f; // Reset growth timer
+            }
+            it = grid.fire_timers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    // Start fire if many plants (very unlikely)
+    if (grid.plants.size() > 50 && (gen() % 10000) == 0) {
+        // Pick random plant
+        auto it = grid.plants.begin();
+        std::advance(it, gen() % grid.plants.size());
+        auto [q, r] = it->first;
+        grid.fire_timers[{q, r}] = 5.0f;
+    }
+
+    // Spread fire to adjacent plants (every 2 seconds)
+    fire_spread_timer += dt;
+    if (fire_spread_timer >= 2.0f) {
+        fire_scratch.clear();
+        for (auto& [coord, timer] : grid.fire_timers) {
+            auto [q, r] = coord;
+            for (int dir = 0; dir < 6; ++dir) {
+                auto [nq, nr] = hex_neighbor(q, r, dir);
+                auto neighbor_plant = grid.plants.find({nq, nr});
+                // Only spread to non-charred plants that aren't already burning
+                if (neighbor_plant != grid.plants.end() &&
+                    neighbor_plant->second.stage != CHARRED &&
+                    grid.fire_timers.find({nq, nr}) == grid.fire_timers.end()) {
+                    fire_scratch.push_back({nq, nr});
+                }
+            }
+        }
+        for (auto& coord : fire_scratch) {
+            grid.fire_timers[coord] = 5.0f;  // Repeats just rewrite the same timer
+        }
+        fire_spread_timer -= 2.0f; // or = 0.0f
+    }
+}
+
+template <typename Animal>
+void Simulation::prepare_batch(std::vector<Animal>& animals, float dt) {
+    using Traits = SpeciesTraits<Animal>;
+    AgentBatch& b = agent_batch;
+    b.resize(animals.size());
+
+    // Gather
+    for (size_t i = 0; i < animals.size(); ++i) {
+        Animal& a = animals[i];
+        bool active = !a.is_dead;
+        if constexpr (Traits::grazes) {
+            active = active && !a.is_eating;  // Grazing replaces the usual decay
+            b.flag[i] = a.is_eating ? LANE_ON : LANE_OFF;
+            b.timer[i] = a.eating_timer;
+        }
+        b.active[i] = active ? LANE_ON : LANE_OFF;
+        b.energy[i] = a.energy;
+        b.move_timer[i] = a.move_timer;
+        if constexpr (Traits::digests) {
+            b.digestion[i] = a.digestion_time;
+        }
+        if constexpr (Traits::thirst_decay > 0.0f) {
+            b.thirst[i] = a.thirst;
+            b.on_water[i] = active && grid.get_terrain_type(a.q, a.r) == WATER ? LANE_ON : LANE_OFF;
+        }
+    }
+
+    if constexpr (Traits::thirst_decay > 0.0f) {
+        batch_decay_needs(b, Traits::energy_decay, Traits::thirst_decay, Traits::drink_rate, Traits::digests, dt);
+    } else {
+        batch_decay_needs(b, Traits::energy_decay, 0.0f, 0.0f, Traits::digests, dt);
+    }
+    if constexpr (Traits::grazes) {
+        batch_graze(b, Traits::graze_rate, Traits::energy_cap, dt);
+    }
+
+    // Scatter
+    for (size_t i = 0; i < animals.size(); ++i) {
+        Animal& a = animals[i];
+        a.energy = b.energy[i];
+        a.move_timer = b.move_timer[i];
+        if constexpr (Traits::grazes) {
+            a.eating_timer = b.timer[i];
+        }
+        if constexpr (Traits::digests) {
+            a.digestion_time = b.digestion[i];
+        }
+        if constexpr (Traits::thirst_decay > 0.0f) {
+            a.thirst = b.thirst[i];
+        }
+    }
+}
+
+template <typename Animal>
+void Simulation::update_density(HexField& density, HexField* neighbors, std::vector<std::pair<int, int>>& cells,
+                                const std::vector<Animal>& animals) {
+    // Take back the last update's counts rather than clearing, so the cost
+    // follows the number of animals instead of the number of tiles
+    for (auto [q, r] : cells) {
+        density.add(q, r, -1.0f);
+        if (neighbors) neighbors->add_ring(q, r, -1.0f);
+    }
+    cells.clear();
+    for (const auto& a : animals) {
+        if (a.is_dead) continue;
+        density.add(a.q, a.r, 1.0f);
+        if (neighbors) neighbors->add_ring(a.q, a.r, 1.0f);
+        cells.push_back({a.q, a.r});
+    }
+}
+
+template <typename Animal>
+void Simulation::advance_pregnancies(std::vector<Animal>& animals, float dt) {
+    // Lanes that sat out this tick's behaviour (grazing hares) keep their timer;
+    // agent_batch still holds the active mask from prepare_batch
+    AgentBatch& b = agent_batch;
+    for (size_t i = 0; i < animals.size(); ++i) {
+        b.flag[i] = animals[i].is_pregnant && b.active[i] ? LANE_ON : LANE_OFF;
+        b.timer[i] = animals[i].pregnancy_timer;
+    }
+    batch_pregnancy(b, dt);
+    for (size_t i = 0; i < animals.size(); ++i) {
+        animals[i].pregnancy_timer = b.timer[i];
+        if (b.done[i]) {
+            animals[i].ready_to_give_birth = true;
+            animals[i].is_pregnant = false;
+        }
+    }
+}
+
+void Simulation::update_animals(float dt) {
+    // Each land species: scalar needs and timers in batch, then the
+    // per-animal behaviour in order, then pregnancies in batch. Under load
+    // each animal decides only on its own slice of ticks, round-robin by index;
+    // the others still starve or die of thirst on the tick their needs run out
+    size_t slices = std::max(time_slices, 1u);
+    size_t slice = tick_count % slices;
+    auto decides = [&](size_t i) { return slices == 1 || i % slices == slice; };
+
+    prepare_batch(hares, dt);
+    for (size_t i = 0; i < hares.size(); ++i) {
+        if (decides(i)) {
+            hares[i].update(grid, foxes, gen);
+        } else if (!hares[i].is_dead) {
+            check_death(hares[i], grid);
+        }
+    }
+    advance_pregnancies(hares, dt);
+
+    // Salmon react to nothing but their own timers, so rather than being
+    // polled they wake from the wheel when a swim or starvation is due
+    salmon_timers.advance(tick_count, [&](const SalmonTimer& timer) {
+        if (timer.index >= salmons.size() || salmons[timer.index].id != timer.id) return;
+        Salmon& salmon = salmons[timer.index];
+        salmon.wake_tick = salmon.wake(grid, tick_count, gen);
+        if (salmon.is_dead) {
+            salmon_deaths.push_back(timer.index);
+            return;
+        }
+        if (salmon.ready_to_give_birth) salmon_births.push_back(timer.index);
+        schedule_salmon(timer.index);
+    });
+
+    // Densities as the predators see them; the pack bonus reads fox_neighbors
+    update_density(grid.hare_density, nullptr, hare_cells, hares);
+    update_density(grid.fox_density, &grid.fox_neighbors, fox_cells, foxes);
+
+    prepare_batch(foxes, dt);
+    for (size_t i = 0; i < foxes.size(); ++i) {
+        Fox& fox = foxes[i];
+        if (!decides(i)) {
+            if (!fox.is_dead) check_death(fox, grid);
+            continue;
+        }
+        fox.update(grid, hares, gen);
+        if (fox.last_prey_id) {
+            if (const LineageNode* prey = lineage.find(fox.last_prey_id)) flows.deaths[prey->species]++;
+            lineage.remove(fox.last_prey_id, tick_count);
+            fox.last_prey_id = 0;
+        }
+    }
+    advance_pregnancies(foxes, dt);
+
+    prepare_batch(wolves, dt);
+    for (size_t i = 0; i < wolves.size(); ++i) {
+        Wolf& wolf = wolves[i];
+        if (!decides(i)) {
+            if (!wolf.is_dead) check_death(wolf, grid);
+            continue;
+        }
+        wolf.update(grid, hares, foxes, gen);
+        if (wolf.last_prey_id) {
+            if (const LineageNode* prey = lineage.find(wolf.last_prey_id)) flows.deaths[prey->species]++;
+            lineage.remove(wolf.last_prey_id, tick_count);
+            wolf.last_prey_id = 0;
+        }
+    }
+    advance_pregnancies(wolves, dt);
+
+    // Animals die in fire
+    for (auto& hare : hares) {
+        if (!hare.is_dead && grid.fire_timers.find({hare.q, hare.r}) != grid.fire_timers.end()) {
+            hare.is_dead = true;
+            hare.death_cause = CAUSE_BURNED;
+            event_log.emit(EVENT_BURNED, LOG_INFO, SPECIES_HARE, hare.q, hare.r);
+        }
+    }
+    // Salmon stay in water, which never burns
+    for (auto& fox : foxes) {
+        if (!fox.is_dead && grid.fire_timers.find({fox.q, fox.r}) != grid.fire_timers.end()) {
+            fox.is_dead = true;
+            fox.death_cause = CAUSE_BURNED;
+            event_log.emit(EVENT_BURNED, LOG_INFO, SPECIES_FOX, fox.q, fox.r);
+        }
+    }
+    for (auto& wolf : wolves) {
+        if (!wolf.is_dead && grid.fire_timers.find({wolf.q, wolf.r}) != grid.fire_timers.end()) {
+            wolf.is_dead = true;
+            wolf.death_cause = CAUSE_BURNED;
+            event_log.emit(EVENT_BURNED, LOG_INFO, SPECIES_WOLF, wolf.q, wolf.r);
+        }
+    }
+}
+
+void Simulation::handle_births() {
+    // Handle hare birth, on a free neighbouring hex
+    size_t first = hares.size();
+    for (size_t i = 0; i < first; ++i) {
+        if (!hares[i].ready_to_give_birth) continue;
+        std::pair<int, int> free_neighbors[6];
+        int free_count = 0;
+        for (int dir = 0; dir < 6; ++dir) {
+            auto [nq, nr] = hex_neighbor(hares[i].q, hares[i].r, dir);
+            if (grid.has_hexagon(nq, nr) && grid.hare_positions.find({nq, nr}) == grid.hare_positions.end()) {
+                free_neighbors[free_count++] = {nq, nr};
+            }
+        }
+        if (free_count > 0) {
+            std::uniform_int_distribution<> dis(0, free_count - 1);
+            auto [bq, br] = free_neighbors[dis(gen)];
+            give_birth(hares, i, bq, br, 0.5f);  // Lower starting energy for evolutionary pressure
+            grid.hare_positions.insert({bq, br});
+            if (enable_hare_logging) {
+                event_log.emit(EVENT_BIRTH, LOG_DEBUG, SPECIES_HARE, bq, br);
+            }
+        }
+    }
+    finish_births(hares, first);
+
+    // Handle salmon birth (only salmon that woke up this tick can be ready)
+    for (uint32_t index : salmon_births) {
+        // Create offspring at same position
+        RecordedAnimal parent = record_animal(salmons[index]);  // Copied before push_back can reallocate
+        salmons[index].ready_to_give_birth = false;
+        salmons.push_back(Salmon(parent.q, parent.r));
+        Salmon& child = salmons.back();
+        child.id = next_id++;
+        child.parent_id = parent.id;
+        child.energy = 0.5f;
+        child.energy_tick = tick_count;
+        child.wake_tick = tick_count + Salmon::move_ticks();
+        schedule_salmon(salmons.size() - 1);
+        lineage.add(record_animal(child), &parent, tick_count);
+        flows.births[SPECIES_SALMON]++;
+    }
+    salmon_births.clear();
+
+    // Handle fox birth, at the same position
+    first = foxes.size();
+    for (size_t i = 0; i < first; ++i) {
+        if (!foxes[i].ready_to_give_birth) continue;
+        give_birth(foxes, i, foxes[i].q, foxes[i].r, 1.5f);  // Starting energy for offspring
+        event_log.emit(EVENT_BIRTH, LOG_INFO, SPECIES_FOX, foxes[i].q, foxes[i].r);
+    }
+    finish_births(foxes, first);
+
+    // Handle wolf birth, at the same position
+    first = wolves.size();
+    for (size_t i = 0; i < first; ++i) {
+        if (!wolves[i].ready_to_give_birth) continue;
+        give_birth(wolves, i, wolves[i].q, wolves[i].r, 4.0f);  // Starting energy for offspring
+        event_log.emit(EVENT_BIRTH, LOG_INFO, SPECIES_WOLF, wolves[i].q, wolves[i].r);
+    }
+    finish_births(wolves, first);
+}
+
+template <typename Animal>
+void Simulation::give_birth(std::vector<Animal>& animals, size_t parent, int q, int r, float energy) {
+    Animal child(q, r);
+    child.id = next_id++;
+    child.parent_id = animals[parent].id;
+    child.genome = animals[parent].genome;
+    if (crossover_births) {
+        if (!mates_indexed) index_mates(animals);
+        if (const Animal* mate = find_mate(animals, parent)) {
+            child.genome = crossover(animals[parent].genome, mate->genome, gen);
+        }
+    }
+    child.energy = energy;
+    animals[parent].ready_to_give_birth = false;
+    birth_parents.push_back(record_animal(animals[parent]));
+    animals.push_back(child);  // May reallocate, so nothing above holds on to the parent
+}
+
+template <typename Animal>
+void Simulation::finish_births(std::vector<Animal>& animals, size_t first) {
+    // Mutate the whole litter in one batch, then enter it in the lineage
+    size_t count = animals.size() - first;
+    mutate_genomes(count, [&](size_t i) -> auto& { return animals[first + i].genome; }, gen, mutation_scratch);
+    for (size_t i = 0; i < count; ++i) {
+        lineage.add(record_animal(animals[first + i]), &birth_parents[i], tick_count);
+    }
+    flows.births[SpeciesTraits<Animal>::species] += count;
+    birth_parents.clear();
+
+    // Leave the tile lists empty for the next species
+    if (mates_indexed) {
+        for (size_t i = 0; i < first; ++i) {
+            if (grid.nutrients.contains(animals[i].q, animals[i].r)) {
+                mate_heads[grid.nutrients.index(animals[i].q, animals[i].r)] = -1;
+            }
+        }
+        mates_indexed = false;
+    }
+}
+
+template <typename Animal>
+void Simulation::index_mates(const std::vector<Animal>& animals) {
+    // Per-tile lists of the living, laid out like the hex fields
+    mate_heads.resize(grid.nutrients.size(), -1);
+    mate_next.resize(animals.size());
+    for (size_t i = 0; i < animals.size(); ++i) {
+        const Animal& a = animals[i];
+        if (a.is_dead || !grid.nutrients.contains(a.q, a.r)) continue;
+        int32_t& head = mate_heads[grid.nutrients.index(a.q, a.r)];
+        mate_next[i] = head;
+        head = static_cast<int32_t>(i);
+    }
+    mates_indexed = true;
+}
+
+template <typename Animal>
+const Animal* Simulation::find_mate(const std::vector<Animal>& animals, size_t parent) const {
+    // Closest other living animal of the species, searching outward ring by ring
+    const Animal* mate = nullptr;
+    hex_spiral(animals[parent].q, animals[parent].r, MATE_RANGE, [&](int q, int r) {
+        if (mate || !grid.nutrients.contains(q, r)) return;
+        for (int32_t i = mate_heads[grid.nutrients.index(q, r)]; i >= 0; i = mate_next[i]) {
+            if (static_cast<size_t>(i) != parent) {
+                mate = &animals[i];
+                return;
+            }
+        }
+    });
+    return mate;
+}
+
+// ============================================================================
+// ISLAND MIGRATION
+// ============================================================================
+
+void Simulation::exchange_migrants() {
+    if (!migration || tick_count == 0 || tick_count % migration->interval_ticks() != 0) return;
+
+    // A few of each species leave for one island (salmon stay in their waters)
+    unsigned int to = migration->destination(gen);
+    emigrate(hares, to);
+    emigrate(foxes, to);
+    emigrate(wolves, to);
+
+    // Everyone who arrived since the last exchange lands
+    MigrantHeader header;
+    while (migration->receive(header)) {
+        switch (header.species) {
+            case SPECIES_HARE: immigrate(hares, header); break;
+            case SPECIES_FOX: immigrate(foxes, header); break;
+            case SPECIES_WOLF: immigrate(wolves, header); break;
+            default:
+                std::cerr << "Warning: Dropped a migrant batch of unknown species " << static_cast<int>(header.species) << std::endl;
+                break;
+        }
+    }
+}
+
+template <typename Animal>
+void Simulation::emigrate(std::vector<Animal>& animals, unsigned int to) {
+    using Traits = SpeciesTraits<Animal>;
+    // Random living animals, never taking a species below a few residents
+    emigrants.clear();
+    for (size_t i = 0; i < animals.size(); ++i) {
+        if (!animals[i].is_dead) emigrants.push_back(static_cast<uint32_t>(i));
+    }
+    if (emigrants.size() <= MIGRATION_MIN_RESIDENTS) return;
+    size_t count = std::min<size_t>(migration->config().migrants, emigrants.size() - MIGRATION_MIN_RESIDENTS);
+    for (size_t i = 0; i < count; ++i) {
+        std::uniform_int_distribution<size_t> dis(i, emigrants.size() - 1);
+        std::swap(emigrants[i], emigrants[dis(gen)]);
+    }
+    emigrants.resize(count);
+
+    auto& genomes = std::get<std::vector<decltype(Animal::genome)>>(migrant_genomes);
+    genomes.clear();
+    for (uint32_t i : emigrants) genomes.push_back(animals[i].genome);
+    if (!migration->send(to, Traits::species, genomes)) return;  // Nobody leaves if the batch could not go
+
+    // They leave the world like the dead, so removal and the lineage close them out
+    for (uint32_t i : emigrants) {
+        animals[i].is_dead = true;
+        animals[i].death_cause = CAUSE_EMIGRATED;
+    }
+    flows.emigrants[Traits::species] += count;
+    event_log.emit(EVENT_MIGRATION, LOG_INFO, Traits::species, 0, 0,
+                   {static_cast<float>(count), static_cast<float>(to), 0.0f});
+}
+
+template <typename Animal>
+void Simulation::immigrate(std::vector<Animal>& animals, const MigrantHeader& header) {
+    using Traits = SpeciesTraits<Animal>;
+    auto& genomes = std::get<std::vector<decltype(Animal::genome)>>(migrant_genomes);
+    if (!migration->genomes(genomes)) {
+        std::cerr << "Warning: Dropped a migrant batch whose genomes do not fit its species" << std::endl;
+        return;
+    }
+
+    if (landing_tiles.empty()) {
+        for (const auto& [coord, tile] : grid.terrainTiles) {
+            if (tile.type == SOIL) landing_tiles.push_back(coord);
+        }
+        if (landing_tiles.empty()) return;
+    }
+
+    // Immigrants are founders here: random soil tiles, their own genomes, no parent
+    std::uniform_int_distribution<size_t> dis(0, landing_tiles.size() - 1);
+    size_t landed = 0;
+    for (const auto& genome : genomes) {
+        auto [q, r] = landing_tiles[dis(gen)];
+        if constexpr (std::is_same_v<Animal, Hare>) {
+            if (grid.hare_positions.count({q, r})) continue;  // One hare per tile
+        }
+        Animal& animal = add_founder(animals, q, r);
+        animal.genome = genome;
+        lineage.add(record_animal(animal), nullptr, tick_count);
+        landed++;
+    }
+    flows.immigrants[Traits::species] += landed;
+    event_log.emit(EVENT_MIGRATION, LOG_INFO, Traits::species, 0, 0,
+                   {static_cast<float>(landed), static_cast<float>(header.from), 1.0f});
+}
+
+// ============================================================================
+// EXTERNAL CONTROL
+// ============================================================================
+
+template <typename Animal>
+Animal& Simulation::add_founder(std::vector<Animal>& animals, int q, int r) {
+    animals.emplace_back(q, r);
+    Animal& animal = animals.back();
+    animal.id = next_id++;
+    if constexpr (std::is_same_v<Animal, Hare>) {
+        grid.hare_positions.insert({q, r});
+    }
+    if constexpr (std::is_same_v<Animal, Salmon>) {
+        animal.energy_tick = tick_count;
+        animal.wake_tick = tick_count + Salmon::move_ticks();
+        schedule_salmon(animals.size() - 1);
+    }
+    return animal;
+}
+
+uint32_t Simulation::spawn(EventSpecies species, int q, int r) {
+    if (!grid.has_hexagon(q, r)) return 0;
+    TerrainType terrain = grid.get_terrain_type(q, r);
+    RecordedAnimal founder;
+    switch (species) {
+        case SPECIES_HARE:
+            if (terrain != SOIL || grid.hare_positions.count({q, r})) return 0;
+            founder = record_animal(add_founder(hares, q, r));
+            break;
+        case SPECIES_FOX:
+            if (terrain != SOIL) return 0;
+            founder = record_animal(add_founder(foxes, q, r));
+            break;
+        case SPECIES_WOLF:
+            if (terrain != SOIL) return 0;
+            founder = record_animal(add_founder(wolves, q, r));
+            break;
+        case SPECIES_SALMON:
+            if (terrain != WATER) return 0;
+            founder = record_animal(add_founder(salmons, q, r));
+            break;
+        default:
+            return 0;
+    }
+    lineage.add(founder, nullptr, tick_count);
+    return founder.id;
+}
+
+bool Simulation::ignite(int q, int r) {
+    if (!grid.get_plant(q, r)) return false;
+    grid.fire_timers[{q, r}] = 5.0f;
+    event_log.emit(EVENT_FIRE_STARTED, LOG_INFO, SPECIES_NONE, q, r);
+    return true;
+}
+
+void Simulation::sample_populations(float dt) {
+    // Update population graph
+    graph_timer += dt;
+    if (graph_timer >= GRAPH_UPDATE_INTERVAL) {
+        hare_history.push_back(hares.size());
+        plant_history.push_back(grid.plants.size());
+        salmon_history.push_back(salmons.size());
+        fox_history.push_back(foxes.size());
+        wolf_history.push_back(wolves.size());
+        sample_count++;
+        if (hare_history.size() > MAX_HISTORY) {
+            hare_history.erase(hare_history.begin());
+            plant_history.erase(plant_history.begin());
+            salmon_history.erase(salmon_history.begin());
+            fox_history.erase(fox_history.begin());
+            wolf_history.erase(wolf_history.begin());
+        }
+        graph_timer = 0.0f;
+    }
+
+    // Console logging
+    log_timer += dt;
+    if (log_timer >= LOG_INTERVAL) {
+        event_log.emit(EVENT_POPULATION, LOG_INFO, SPECIES_NONE, 0, 0,
+                       {static_cast<float>(hares.size()), static_cast<float>(grid.plants.size()), static_cast<float>(salmons.size()),
+                        static_cast<float>(foxes.size()), static_cast<float>(wolves.size())});
+        if (allocation_counting()) {
+            // A steady-state tick should not touch the heap at all
+            uint64_t total = 0;
+            for (uint64_t count : phase_allocations) total += count;
+            event_log.emit(EVENT_ALLOCATIONS, total > 0 ? LOG_WARN : LOG_DEBUG, SPECIES_NONE, 0, 0,
+                           {static_cast<float>(phase_allocations[PHASE_PLANTS]), static_cast<float>(phase_allocations[PHASE_FIRES]),
+                            static_cast<float>(phase_allocations[PHASE_ANIMALS]), static_cast<float>(phase_allocations[PHASE_BIRTHS]),
+                            static_cast<float>(phase_allocations[PHASE_BOOKKEEPING])});
+            std::fill(std::begin(phase_allocations), std::end(phase_allocations), 0);
+        }
+        log_timer = 0.0f;
+    }
+}
+
+template <typename Animal>
+void Simulation::close_out(const Animal& animal) {
+    lineage.remove(animal.id, tick_count);
+    if (animal.death_cause != CAUSE_EMIGRATED) flows.deaths[SpeciesTraits<Animal>::species]++;
+}
+
+void Simulation::remove_dead() {
+    // Close the lineage of everything that died or left this tick
+    for (const auto& h : hares) if (h.is_dead) close_out(h);
+    for (uint32_t index : salmon_deaths) close_out(salmons[index]);
+    for (const auto& f : foxes) if (f.is_dead) close_out(f);
+    for (const auto& w : wolves) if (w.is_dead) close_out(w);
+
+    // Remove dead hares
+    for (const auto& h : hares) {
+        if (h.is_dead) {
+            grid.hare_positions.erase({h.q, h.r});
+        }
+    }
+    hares.erase(std::remove_if(hares.begin(), hares.end(), [](const Hare& h) {
+        return h.is_dead;
+    }), hares.end());
+
+    // Remove dead salmons by moving the last one into the gap, highest index
+    // first so the others stay put; the moved salmon is rescheduled at its
+    // new index
+    std::sort(salmon_deaths.begin(), salmon_deaths.end(), std::greater<uint32_t>());
+    for (uint32_t index : salmon_deaths) {
+        if (index + 1 != salmons.size()) {
+            salmons[index] = salmons.back();
+            schedule_salmon(index);
+        }
+        salmons.pop_back();
+    }
+    salmon_deaths.clear();
+
+    // Remove dead foxes
+    foxes.erase(std::remove_if(foxes.begin(), foxes.end(), [](const Fox& f) {
+        return f.is_dead;
+    }), foxes.end());
+
+    // Remove dead wolves
+    wolves.erase(std::remove_if(wolves.begin(), wolves.end(), [](const Wolf& w) {
+        return w.is_dead;
+    }), wolves.end());
+
+
+}
+
+// ============================================================================
+// COMMANDS AND SNAPSHOTS
+// ============================================================================
+
+bool Simulation::start_fire() {
+    if (grid.plants.empty()) return false;
+    auto it = grid.plants.begin();
+    std::advance(it, gen() % grid.plants.size());
+    return ignite(it->first.first, it->first.second);
+}
+
+void Simulation::log_hare_genomes() const {
+    for (const auto& hare : hares) {
+        if (!hare.is_dead) {
+            event_log.emit(EVENT_GENOME, LOG_INFO, SPECIES_HARE, hare.q, hare.r,
+                           {hare.genome.reproduction_threshold, hare.genome.movement_aggression, hare.genome.weight, hare.speed()});
+        }
+    }
+
+    // Most recent common ancestor of every living hare
+    uint32_t ancestor = 0;
+    for (const auto& hare : hares) {
+        ancestor = ancestor == 0 ? hare.id : lineage.common_ancestor(ancestor, hare.id);
+        if (ancestor == 0) break;
+    }
+    const LineageNode* node = lineage.find(ancestor);
+    event_log.emit(EVENT_LINEAGE, LOG_INFO, SPECIES_HARE, 0, 0,
+                   {static_cast<float>(lineage.size()), static_cast<float>(lineage.living()),
+                    static_cast<float>(lineage.pruned()), static_cast<float>(ancestor),
+                    node ? static_cast<float>(node->birth_tick) : -1.0f});
+}
+
+void Simulation::fill_snapshot(RenderSnapshot& snapshot) const {
+    snapshot.tick = tick_count;
+    snapshot.sim_time = sim_time;
+    snapshot.time_slices = time_slices;
+
+    // Scale based on energy (newborns start small but visible)
+    snapshot.hares.clear();
+    for (const auto& hare : hares) {
+        float scale = std::max(0.8f, std::min(hare.energy / 1.0f, 1.0f));
+        snapshot.hares.push_back({hare.id, hare.q, hare.r, 0.0f, 0.0f, hare.getColor(), scale});
+    }
+    snapshot.salmons.clear();
+    for (const auto& salmon : salmons) {
+        float scale = std::max(0.8f, std::min(salmon.energy_at(tick_count) / 1.0f, 1.0f));
+        snapshot.salmons.push_back({salmon.id, salmon.q, salmon.r, 0.0f, 0.0f, salmon.getColor(), scale});
+    }
+    snapshot.foxes.clear();
+    for (const auto& fox : foxes) {
+        float scale = std::max(0.9f, std::min(fox.energy / 3.5f, 1.0f));
+        snapshot.foxes.push_back({fox.id, fox.q, fox.r, 0.0f, 0.0f, fox.getColor(), scale});
+    }
+    snapshot.wolves.clear();
+    for (const auto& wolf : wolves) {
+        float scale = std::max(0.9f, std::min(wolf.energy / 5.0f, 1.0f));
+        snapshot.wolves.push_back({wolf.id, wolf.q, wolf.r, 0.0f, 0.0f, wolf.getColor(), scale});
+    }
+    snapshot.index_animals(grid.hex_size);
+
+    // Map iteration order keeps plants sorted by (q, r) for plant_at lookups
+    snapshot.plants.clear();
+    for (const auto& [coord, plant] : grid.plants) {
+        snapshot.plants.push_back({plant.q, plant.r, plant.stage});
+    }
+    snapshot.fires.clear();
+    for (const auto& [coord, timer] : grid.fire_timers) {
+        snapshot.fires.push_back({coord.first, coord.second, timer});
+    }
+
+    // Calculate brightness center based on alive animals
+    float brightness_center_q = 0, brightness_center_r = 0;
+    int alive_count = 0;
+    for (const auto& hare : hares) {
+        if (!hare.is_dead) {
+            brightness_center_q += hare.q;
+            brightness_center_r += hare.r;
+            alive_count++;
+        }
+    }
+    for (const auto& fox : foxes) {
+        if (!fox.is_dead) {
+            brightness_center_q += fox.q;
+            brightness_center_r += fox.r;
+            alive_count++;
+        }
+    }
+    for (const auto& wolf : wolves) {
+        if (!wolf.is_dead) {
+            brightness_center_q += wolf.q;
+            brightness_center_r += wolf.r;
+            alive_count++;
+        }
+    }
+    snapshot.has_alive_animals = alive_count > 0;
+    if (snapshot.has_alive_animals) {
+        brightness_center_q /= alive_count;
+        brightness_center_r /= alive_count;
+    }
+    snapshot.brightness_center_q = brightness_center_q;
+    snapshot.brightness_center_r = brightness_center_r;
+
+    snapshot.sample_count = sample_count;
+    snapshot.hare_history = hare_history;
+    snapshot.plant_history = plant_history;
+    snapshot.salmon_history = salmon_history;
+    snapshot.fox_history = fox_history;
+    snapshot.wolf_history = wolf_history;
+}
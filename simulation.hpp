@@ -0,0 +1,174 @@
+#pragma once
+
+#include "hex_grid_new.hpp"
+#include "agent_batch.hpp"
+#include "lineage.hpp"
+#include "render_snapshot.hpp"
+#include "timer_wheel.hpp"
+#include "animals/hare.hpp"
+#include "animals/fox.hpp"
+#include "animals/wolf.hpp"
+#include "animals/salmon.hpp"
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+class Recorder;
+class Migration;
+class ColumnExporter;
+class DigestTrace;
+class WorldMap;
+struct MigrantHeader;
+
+// Parts of a tick, for per-phase timing and allocation reporting
+enum TickPhase {
+    PHASE_PLANTS,
+    PHASE_FIRES,
+    PHASE_ANIMALS,
+    PHASE_BIRTHS,
+    PHASE_BOOKKEEPING,  // Population sampling, recording, removing the dead, lineage pruning
+    TICK_PHASE_COUNT
+};
+
+// Animals that entered or left the world since it was built, by EventSpecies
+struct PopulationFlows {
+    uint64_t births[SPECIES_SALMON + 1] = {};
+    uint64_t deaths[SPECIES_SALMON + 1] = {};  // Starved, dehydrated, burned or eaten
+    uint64_t immigrants[SPECIES_SALMON + 1] = {};
+    uint64_t emigrants[SPECIES_SALMON + 1] = {};
+};
+
+// ============================================================================
+// SIMULATION - World state and the per-tick ecosystem update
+// ============================================================================
+
+class Simulation {
+public:
+    HexGrid grid;
+    std::vector<Hare> hares;
+    std::vector<Salmon> salmons;
+    std::vector<Fox> foxes;
+    std::vector<Wolf> wolves;
+
+    // Population graph data
+    std::vector<int> hare_history;
+    std::vector<int> plant_history;
+    std::vector<int> salmon_history;
+    std::vector<int> fox_history;
+    std::vector<int> wolf_history;
+
+    uint64_t tick_count = 0;
+    float sim_time = 0.0f;
+    uint64_t sample_count = 0;   // Population graph samples taken so far
+    uint32_t next_id = 1;        // Next entity id to hand out
+    bool enable_hare_logging = true;
+    bool crossover_births = false;  // Offspring mix the genomes of the parent and a nearby mate
+    Recorder* recorder = nullptr;  // Optional, captures every tick
+    Migration* migration = nullptr;  // Optional, exchanges genomes with other islands
+    ColumnExporter* exporter = nullptr;  // Optional, dumps agents and tiles periodically
+    DigestTrace* digest_trace = nullptr;  // Optional, hashes the world after every tick
+    LineageTracker lineage;        // Ancestry of every animal ever spawned or born
+    uint64_t phase_allocations[TICK_PHASE_COUNT] = {};  // Since the last population log (HEXAWORLD_COUNT_ALLOCS builds)
+    double phase_seconds[TICK_PHASE_COUNT] = {};        // Wall time spent in each phase since the world was built
+    PopulationFlows flows;
+
+    // Ticks that per-animal decisions, plant and fire bookkeeping and graph
+    // sampling are spread over, set by the tick governor (1 = every tick).
+    // Needs, timers and pregnancies still advance every tick.
+    unsigned int time_slices = 1;
+
+    explicit Simulation(float hex_size) : grid(hex_size) {}
+
+    // Generate terrain filling a world_width x world_height pixel area
+    // centered on hex (0,0), then place the initial animals
+    void generate(float world_width, float world_height);
+
+    // Build the world from a baked map instead, then place its founders
+    // (or, if it lists none, the usual random initial animals)
+    void load_map(const WorldMap& map);
+
+    // Advance the ecosystem by dt seconds
+    void tick(float dt);
+
+    // Ignite a random plant; false if there are none
+    bool start_fire();
+
+    // Set the plant at (q, r) on fire; false if there is none
+    bool ignite(int q, int r);
+
+    // Place a founder with the default genome at (q, r); returns its id, or
+    // 0 if the tile cannot hold one (wrong terrain, or a hare already there)
+    uint32_t spawn(EventSpecies species, int q, int r);
+
+    // Print every live hare's genome and a lineage summary
+    void log_hare_genomes() const;
+
+    // Copy everything the renderer needs into a snapshot (buffers are reused)
+    void fill_snapshot(RenderSnapshot& snapshot) const;
+
+    // Time the periodic updates have gathered towards their next run, in
+    // CARRIED_TIMER_NAMES order; part of the state two runs must agree on
+    static constexpr const char* CARRIED_TIMER_NAMES[] = {
+        "graph_timer", "log_timer", "fire_spread_timer", "deferred_dt", "nutrient_timer"
+    };
+    std::array<float, 5> carried_timers() const {
+        return {graph_timer, log_timer, fire_spread_timer, deferred_dt, nutrient_timer};
+    }
+
+private:
+    float graph_timer = 0.0f;
+    float log_timer = 0.0f;
+    float fire_spread_timer = 0.0f;
+    float deferred_dt = 0.0f;  // Time the sliced bookkeeping has not seen yet
+    AgentBatch agent_batch;  // Scratch arrays for the batch kernels
+    std::vector<std::pair<int, int>> fire_scratch;  // Hexes catching fire this spread
+    HexField soil_mask;  // 1 on soil tiles, where nutrients diffuse
+    float nutrient_timer = 0.0f;
+    std::vector<std::pair<int, int>> hare_cells, fox_cells;  // Where the density fields were last counted
+
+    // Salmon wake-ups by tick; an entry whose index no longer holds its id
+    // is stale (the salmon was moved by a removal and rescheduled there)
+    struct SalmonTimer {
+        uint32_t id;
+        uint32_t index;
+    };
+    TimerWheel<SalmonTimer> salmon_timers;
+    std::vector<uint32_t> salmon_deaths, salmon_births;  // Indices, this tick
+
+    void schedule_salmon(size_t index);
+
+    // Births of the species being handled, mutated together at the end
+    std::vector<RecordedAnimal> birth_parents;
+    MutationScratch mutation_scratch;
+    std::vector<int32_t> mate_heads, mate_next;  // Animals on each tile, as linked lists by index
+    bool mates_indexed = false;
+
+    // Island migration
+    std::vector<uint32_t> emigrants;  // Indices leaving this exchange
+    std::vector<std::pair<int, int>> landing_tiles;  // Soil, where immigrants arrive
+    std::tuple<std::vector<HareGenome>, std::vector<FoxGenome>, std::vector<WolfGenome>> migrant_genomes;  // Batch being sent or landed
+
+    void finish_world();
+    void spawn_animals();
+    void update_plants(float dt);
+    void update_fires(float dt);
+    void update_animals(float dt);
+    template <typename Animal> void prepare_batch(std::vector<Animal>& animals, float dt);
+    template <typename Animal> void update_density(HexField& density, HexField* neighbors, std::vector<std::pair<int, int>>& cells,
+                                                   const std::vector<Animal>& animals);
+    template <typename Animal> void advance_pregnancies(std::vector<Animal>& animals, float dt);
+    void handle_births();
+    template <typename Animal> void give_birth(std::vector<Animal>& animals, size_t parent, int q, int r, float energy);
+    template <typename Animal> void finish_births(std::vector<Animal>& animals, size_t first);
+    template <typename Animal> void index_mates(const std::vector<Animal>& animals);
+    template <typename Animal> const Animal* find_mate(const std::vector<Animal>& animals, size_t parent) const;
+    void exchange_migrants();
+    template <typename Animal> void emigrate(std::vector<Animal>& animals, unsigned int to);
+    template <typename Animal> Animal& add_founder(std::vector<Animal>& animals, int q, int r);
+    template <typename Animal> void immigrate(std::vector<Animal>& animals, const MigrantHeader& header);
+    template <typename Animal> void close_out(const Animal& animal);
+    void sample_populations(float dt);
+    void remove_dead();
+};
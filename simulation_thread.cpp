@@ -0,0 +1,102 @@
+#include "simulation_thread.hpp"
+#include "constants.hpp"
+#include "event_log.hpp"
+#include "metrics.hpp"
+#include <chrono>
+
+// ============================================================================
+// SIMULATION THREAD IMPLEMENTATION
+// ============================================================================
+
+SimulationThread::SimulationThread(Simulation& sim, float speed, float tick_budget)
+    : sim_(sim), speed_(speed), governor_(tick_budget) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+void SimulationThread::start() {
+    if (running_.exchange(true)) return;
+    // Publish the initial state so the first frame has something to draw
+    publish_snapshot();
+    thread_ = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    running_.store(false);
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void SimulationThread::publish_snapshot() {
+    RenderSnapshot& snapshot = snapshots_.write_buffer();
+    sim_.fill_snapshot(snapshot);
+    tile_changes_.publish(snapshot);
+    snapshots_.publish();
+}
+
+RenderSnapshot& SimulationThread::latest_snapshot() {
+    snapshots_.acquire();
+    return snapshots_.read_buffer();
+}
+
+void SimulationThread::run() {
+    using clock = std::chrono::steady_clock;
+    const auto tick_interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(speed_ > 0.0f ? SIM_DT / speed_ : 0.0f));
+    const auto publish_interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(SNAPSHOT_MIN_INTERVAL));
+    const auto report_interval = std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<float>(GOVERNOR_REPORT_INTERVAL));
+    auto next_tick = clock::now();
+    auto last_publish = clock::now();
+    auto last_report = clock::now();
+
+    while (running_.load(std::memory_order_relaxed)) {
+        // Apply commands from the render thread
+        if (fire_requested_.exchange(false, std::memory_order_relaxed)) {
+            sim_.start_fire();
+        }
+        if (genome_log_requested_.exchange(false, std::memory_order_relaxed)) {
+            sim_.log_hare_genomes();
+        }
+
+        // Time the tick and let the governor decide how thinly to spread the next one
+        auto tick_start = clock::now();
+        sim_.tick(SIM_DT);
+        auto now = clock::now();
+        float tick_seconds = std::chrono::duration<float>(now - tick_start).count();
+        sim_.time_slices = governor_.record(tick_seconds);
+        if (metrics) {
+            metrics->record_tick(sim_, tick_seconds, governor_.budget());
+        }
+
+        // Report overruns so a degrading sim shows up in the log, not just as stutter
+        if (now - last_report >= report_interval) {
+            TickGovernor::Report report = governor_.take_report();
+            if (report.overruns > 0) {
+                event_log.emit(EVENT_OVERRUN, LOG_WARN, SPECIES_NONE, 0, 0,
+                               {static_cast<float>(report.overruns), static_cast<float>(report.ticks),
+                                report.worst * 1000.0f, governor_.average() * 1000.0f,
+                                static_cast<float>(governor_.slices())});
+            }
+            last_report = now;
+        }
+
+        // Hand the renderer a fresh snapshot, but no faster than it can use them
+        if (now - last_publish >= publish_interval) {
+            publish_snapshot();
+            last_publish = now;
+        }
+
+        // Pace to real time scaled by speed; drop the backlog if we fall far behind
+        if (speed_ > 0.0f) {
+            next_tick += tick_interval;
+            if (now - next_tick > std::chrono::milliseconds(250)) {
+                next_tick = now;
+            }
+            std::this_thread::sleep_until(next_tick);
+        }
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "simulation.hpp"
+#include "render_snapshot.hpp"
+#include "tick_governor.hpp"
+#include <atomic>
+#include <thread>
+
+class Metrics;
+
+// ============================================================================
+// SIMULATION THREAD - Fixed-timestep ticking decoupled from rendering
+// ============================================================================
+
+// Owns the thread that ticks a Simulation and publishes render snapshots
+// through a triple buffer. The render thread never touches the simulation
+// directly: it reads snapshots and posts commands through atomic flags.
+class SimulationThread {
+public:
+    // speed: simulated seconds per real second, 0 = as fast as possible;
+    // tick_budget: real seconds a tick may take before the governor sheds work, 0 = never
+    SimulationThread(Simulation& sim, float speed, float tick_budget);
+    ~SimulationThread();
+
+    Metrics* metrics = nullptr;  // Optional, set before start(); updated after every tick
+
+    void start();
+    void stop();
+
+    // Commands, applied by the simulation thread before its next tick
+    void request_fire() { fire_requested_.store(true, std::memory_order_relaxed); }
+    void request_genome_log() { genome_log_requested_.store(true, std::memory_order_relaxed); }
+
+    // Render side: latest published snapshot, owned by the caller until the next call
+    RenderSnapshot& latest_snapshot();
+
+private:
+    Simulation& sim_;
+    float speed_;
+    TickGovernor governor_;
+    TripleBuffer<RenderSnapshot> snapshots_;
+    TileChangeLog tile_changes_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> fire_requested_{false};
+    std::atomic<bool> genome_log_requested_{false};
+    std::thread thread_;
+
+    void run();
+    void publish_snapshot();
+};
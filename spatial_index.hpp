@@ -0,0 +1,82 @@
+#pragma once
+
+#include "camera.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// SPATIAL INDEX - Uniform bucket grid for view queries over moving entities
+// ============================================================================
+
+// Rebuilt with a counting sort whenever the entities move, which for
+// animals is once per published snapshot, on the thread that fills it.
+// Buffers are kept between builds, so steady-state rebuilds do not allocate.
+class SpatialIndex {
+public:
+    explicit SpatialIndex(float cell_size = 96.0f) : cell_size_(cell_size) {}
+
+    // Bucket every item by its world pixel position pos(item)
+    template <typename T, typename PosFn>
+    void build(const std::vector<T>& items, const ViewRect& bounds, PosFn pos) {
+        bounds_ = bounds;
+        cols_ = std::max(1, static_cast<int>(std::ceil((bounds.right - bounds.left) / cell_size_)));
+        rows_ = std::max(1, static_cast<int>(std::ceil((bounds.bottom - bounds.top) / cell_size_)));
+        cell_start_.assign(static_cast<size_t>(cols_) * rows_ + 1, 0);
+        item_cell_.resize(items.size());
+        entries_.resize(items.size());
+
+        // Count items per cell
+        for (size_t i = 0; i < items.size(); ++i) {
+            auto p = pos(items[i]);
+            uint32_t cell = cell_of(p.x, p.y);
+            item_cell_[i] = cell;
+            cell_start_[cell + 1]++;
+        }
+        // Prefix sum gives each cell's first slot
+        for (size_t c = 1; c < cell_start_.size(); ++c) {
+            cell_start_[c] += cell_start_[c - 1];
+        }
+        // Scatter item indices into their cells
+        cursor_.assign(cell_start_.begin(), cell_start_.end() - 1);
+        for (size_t i = 0; i < items.size(); ++i) {
+            entries_[cursor_[item_cell_[i]]++] = static_cast<uint32_t>(i);
+        }
+    }
+
+    // Call fn(index) for every item in a cell overlapping rect
+    template <typename Fn>
+    void query(const ViewRect& rect, Fn fn) const {
+        if (entries_.empty()) return;
+        int c0 = column_of(rect.left), c1 = column_of(rect.right);
+        int r0 = row_of(rect.top), r1 = row_of(rect.bottom);
+        for (int row = r0; row <= r1; ++row) {
+            for (int col = c0; col <= c1; ++col) {
+                uint32_t cell = row * cols_ + col;
+                for (uint32_t k = cell_start_[cell]; k < cell_start_[cell + 1]; ++k) {
+                    fn(entries_[k]);
+                }
+            }
+        }
+    }
+
+private:
+    float cell_size_;
+    ViewRect bounds_;
+    int cols_ = 1, rows_ = 1;
+    std::vector<uint32_t> cell_start_;  // CSR offsets, one per cell plus end
+    std::vector<uint32_t> cursor_;
+    std::vector<uint32_t> item_cell_;
+    std::vector<uint32_t> entries_;     // Item indices grouped by cell
+
+    int column_of(float x) const {
+        return std::clamp(static_cast<int>((x - bounds_.left) / cell_size_), 0, cols_ - 1);
+    }
+    int row_of(float y) const {
+        return std::clamp(static_cast<int>((y - bounds_.top) / cell_size_), 0, rows_ - 1);
+    }
+    uint32_t cell_of(float x, float y) const {
+        return row_of(y) * cols_ + column_of(x);
+    }
+};
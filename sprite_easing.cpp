@@ -0,0 +1,68 @@
+#include "sprite_easing.hpp"
+#include "hex_math.hpp"
+#include "constants.hpp"
+#include "animals/species.hpp"
+#include <algorithm>
+
+// ============================================================================
+// SPRITE EASING IMPLEMENTATION
+// ============================================================================
+
+void SpriteEaser::apply(std::vector<AnimalSprite>& sprites, const SpatialIndex& index, const ViewRect& view,
+                        const HexGrid& grid, float anim_speed, float dt) {
+    // Index order is id order, so sorting keeps the merge join below valid
+    visible.clear();
+    index.query(view, [&](uint32_t i) { visible.push_back(i); });
+    std::sort(visible.begin(), visible.end());
+    size_t count = visible.size();
+
+    AgentBatch& b = batch_;
+    b.resize(count);
+
+    qs_.resize(count);
+    rs_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        qs_[i] = sprites[visible[i]].q;
+        rs_[i] = sprites[visible[i]].r;
+    }
+    hex_to_pixel_batch(qs_.data(), rs_.data(), count, grid.hex_size, b.target_x.data(), b.target_y.data());
+
+    size_t previous = 0;
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t id = sprites[visible[i]].id;
+        while (previous < ids_.size() && ids_[previous] < id) ++previous;
+        bool known = previous < ids_.size() && ids_[previous] == id;
+        b.pos_x[i] = known ? xs_[previous] : b.target_x[i];
+        b.pos_y[i] = known ? ys_[previous] : b.target_y[i];
+    }
+
+    if (anim_speed > 0.0f && dt > 0.0f) {
+        batch_interpolate(b, anim_speed, dt);
+    } else if (anim_speed <= 0.0f || dt < 0.0f) {
+        b.pos_x = b.target_x;  // Snap
+        b.pos_y = b.target_y;
+    }
+
+    ids_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        AnimalSprite& sprite = sprites[visible[i]];
+        sprite.x = b.pos_x[i];
+        sprite.y = b.pos_y[i];
+        ids_[i] = sprite.id;
+    }
+    xs_ = b.pos_x;
+    ys_ = b.pos_y;
+}
+
+void SpriteEasing::apply(RenderSnapshot& snapshot, const HexGrid& grid, const ViewRect& view) {
+    float dt = snapshot.sim_time - last_sim_time;
+    if (last_sim_time < 0.0f || dt > SPRITE_SNAP_TIME) dt = -1.0f;
+    last_sim_time = snapshot.sim_time;
+
+    // Sprites trail their hex, so hexes a little outside the view can still show
+    ViewRect reach = view.expanded(SPRITE_VIEW_MARGIN);
+    hares.apply(snapshot.hares, snapshot.hare_index, reach, grid, SpeciesTraits<Hare>::anim_speed, dt);
+    salmons.apply(snapshot.salmons, snapshot.salmon_index, reach, grid, SpeciesTraits<Salmon>::anim_speed, dt);
+    foxes.apply(snapshot.foxes, snapshot.fox_index, reach, grid, SpeciesTraits<Fox>::anim_speed, dt);
+    wolves.apply(snapshot.wolves, snapshot.wolf_index, reach, grid, SpeciesTraits<Wolf>::anim_speed, dt);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "agent_batch.hpp"
+#include "render_snapshot.hpp"
+#include "hex_grid_new.hpp"
+#include "spatial_index.hpp"
+#include "camera.hpp"
+#include <cstdint>
+#include <vector>
+
+// ============================================================================
+// SPRITE EASING - Render-side interpolation of animal positions
+// ============================================================================
+
+// Agents only store their hex, so drawn positions are eased here instead.
+// Each species' sprites arrive in id order (ids follow birth order), so last
+// frame's positions are matched to this frame's sprites with a merge join.
+// Only sprites near the view are eased, so the cost follows the screen; one
+// that comes back into view starts again at its hex.
+class SpriteEaser {
+public:
+    std::vector<uint32_t> visible;  // Sprites eased by the last apply, ascending
+
+    // Fill in x, y for the sprites whose hex lies in the cells of index
+    // under view, moving anim_speed pixels per simulated second toward
+    // their hex center; new sprites start at their hex
+    void apply(std::vector<AnimalSprite>& sprites, const SpatialIndex& index, const ViewRect& view,
+               const HexGrid& grid, float anim_speed, float dt);
+
+private:
+    std::vector<uint32_t> ids_;  // Previous frame, ascending
+    std::vector<float> xs_, ys_;
+    std::vector<int32_t> qs_, rs_;  // This frame's hexes, converted in batch
+    AgentBatch batch_;
+};
+
+struct SpriteEasing {
+    SpriteEaser hares, salmons, foxes, wolves;
+    float last_sim_time = -1.0f;
+
+    // Ease the sprites of a snapshot near view by the simulated time since
+    // the previous call; jumps backwards or further than SPRITE_SNAP_TIME
+    // (replay seeks) snap instead
+    void apply(RenderSnapshot& snapshot, const HexGrid& grid, const ViewRect& view);
+};
@@ -0,0 +1,35 @@
+#include "tick_governor.hpp"
+#include "constants.hpp"
+#include <algorithm>
+
+// ============================================================================
+// TICK GOVERNOR IMPLEMENTATION
+// ============================================================================
+
+unsigned int TickGovernor::record(float seconds) {
+    average_ += (seconds - average_) * GOVERNOR_SMOOTHING;
+
+    window_ticks_++;
+    window_worst_ = std::max(window_worst_, seconds);
+    if (budget_ <= 0.0f) return slices_;
+    if (seconds > budget_) window_overruns_++;
+
+    // Spreading work over more ticks only pays once the smoothed cost shows it
+    if (++hold_ < GOVERNOR_HOLD_TICKS) return slices_;
+    if (average_ > budget_ && slices_ < GOVERNOR_MAX_SLICES) {
+        slices_ *= 2;
+        hold_ = 0;
+    } else if (average_ < budget_ * GOVERNOR_RELAX_FRACTION && slices_ > 1) {
+        slices_ /= 2;
+        hold_ = 0;
+    }
+    return slices_;
+}
+
+TickGovernor::Report TickGovernor::take_report() {
+    Report report{window_ticks_, window_overruns_, window_worst_};
+    window_ticks_ = 0;
+    window_overruns_ = 0;
+    window_worst_ = 0.0f;
+    return report;
+}
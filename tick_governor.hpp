@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+// ============================================================================
+// TICK GOVERNOR - Sheds non-urgent tick work when ticks overrun their budget
+// ============================================================================
+
+// Fed the wall-clock cost of every tick, the governor picks how many ticks
+// the simulation spreads its deferrable work over (Simulation::time_slices):
+// 1 while ticks fit the budget, doubling while the smoothed cost is over it
+// and halving again once it falls well below. Changes wait a few ticks in
+// each direction so a single slow tick does not make it flap.
+class TickGovernor {
+public:
+    // budget: real seconds one tick may take, 0 = never shed work
+    explicit TickGovernor(float budget) : budget_(budget) {}
+
+    // Record the cost of the tick just run; returns the slice count for the next
+    unsigned int record(float seconds);
+
+    float budget() const { return budget_; }
+    unsigned int slices() const { return slices_; }
+    float average() const { return average_; }
+
+    // Overrun ticks and the slowest tick since the last take_report()
+    struct Report {
+        uint64_t ticks;
+        uint64_t overruns;
+        float worst;
+    };
+    Report take_report();
+
+private:
+    float budget_;
+    unsigned int slices_ = 1;
+    float average_ = 0.0f;  // Exponentially smoothed tick cost
+    unsigned int hold_ = 0; // Ticks since the last change
+
+    uint64_t window_ticks_ = 0;
+    uint64_t window_overruns_ = 0;
+    float window_worst_ = 0.0f;
+};
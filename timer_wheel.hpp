@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// ============================================================================
+// TIMER WHEEL - Hierarchical wheel of per-tick timers
+// ============================================================================
+
+// Timers due within the next 64 ticks sit in the slot of their tick; later
+// ones sit in coarser levels of 64 slots each (64, 4096, 262144 ticks per
+// slot) and drop down a level each time the wheel reaches their slot. A tick
+// only touches the timers due then, plus the rare cascade, so its cost
+// follows the number of timers firing rather than the number scheduled.
+// Slot buffers keep their capacity, so a steady load does not allocate.
+template <typename T>
+class TimerWheel {
+public:
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr unsigned SLOTS = 1u << SLOT_BITS;
+    static constexpr unsigned LEVELS = 4;  // Exact to 64^4 ticks (three days at 60 Hz), re-cascaded beyond
+
+    explicit TimerWheel(uint64_t now = 0) : now_(now) {}
+
+    uint64_t now() const { return now_; }
+    size_t size() const { return size_; }
+
+    // Drop every timer and restart the wheel at tick `now`
+    void reset(uint64_t now) {
+        for (auto& level : levels_) {
+            for (auto& slot : level) slot.clear();
+        }
+        size_ = 0;
+        now_ = now;
+    }
+
+    // Fire value on tick `due`; timers already due fire on the next tick
+    void schedule(uint64_t due, const T& value) {
+        insert(due > now_ ? due : now_ + 1, value);
+        size_++;
+    }
+
+    // Step the wheel to tick `now`, calling fn(value) for each timer due on
+    // the way, in tick order. fn may schedule more timers.
+    template <typename Fn>
+    void advance(uint64_t now, Fn&& fn) {
+        while (now_ < now) {
+            if (size_ == 0) {
+                now_ = now;
+                return;
+            }
+            ++now_;
+            // Entering a new slot at a coarser level hands its timers down
+            for (unsigned level = LEVELS - 1; level > 0; --level) {
+                if ((now_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                    cascade(level);
+                }
+            }
+            firing_.swap(levels_[0][now_ & (SLOTS - 1)]);
+            size_ -= firing_.size();
+            for (const Entry& entry : firing_) fn(entry.value);
+            firing_.clear();
+        }
+    }
+
+private:
+    struct Entry {
+        uint64_t due;
+        T value;
+    };
+
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> levels_;
+    std::vector<Entry> firing_;     // Timers of the current tick, swapped out of their slot
+    std::vector<Entry> cascading_;  // Same for a slot being handed down
+    uint64_t now_;
+    size_t size_ = 0;
+
+    // Level of the highest slot-sized block where due and now differ
+    void insert(uint64_t due, const T& value) {
+        uint64_t diff = due ^ now_;
+        unsigned level = 0;
+        while (level + 1 < LEVELS && (diff >> (SLOT_BITS * (level + 1))) != 0) level++;
+        levels_[level][(due >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back({due, value});
+    }
+
+    void cascade(unsigned level) {
+        cascading_.swap(levels_[level][(now_ >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+        for (const Entry& entry : cascading_) insert(entry.due, entry.value);
+        cascading_.clear();
+    }
+};
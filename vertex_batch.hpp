@@ -0,0 +1,104 @@
+#pragma once
+
+#include "constants.hpp"
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+// ============================================================================
+// VERTEX BATCH - Shapes collected as triangles, drawn in one call
+// ============================================================================
+
+// The primitive helpers of SFMLRenderer each cost a draw call; a batch
+// turns the same shapes into a triangle list instead. Only plain vertex
+// math is done here, so separate batches can be filled on separate threads.
+// Shapes come out in the order they were added, so they blend as if drawn
+// one by one.
+class VertexBatch {
+public:
+    std::vector<sf::Vertex> vertices;
+    float pixel_scale = 1.0f;  // Screen pixels per unit, sets how round circles are
+
+    void clear() { vertices.clear(); }
+    bool empty() const { return vertices.empty(); }
+
+    void triangle(sf::Vector2f a, sf::Vector2f b, sf::Vector2f c, sf::Color color) {
+        size_t end = vertices.size();
+        vertices.resize(end + 3);
+        sf::Vertex* out = &vertices[end];
+        out[0].position = a;
+        out[1].position = b;
+        out[2].position = c;
+        out[0].color = out[1].color = out[2].color = color;
+    }
+
+    // Convex polygon, as a fan from its first point
+    void convex(const sf::Vector2f* points, size_t count, sf::Color color) {
+        for (size_t i = 1; i + 1 < count; ++i) triangle(points[0], points[i], points[i + 1], color);
+    }
+
+    // Polygon with as many points as keep its edge within
+    // BATCH_CIRCLE_TOLERANCE screen pixels of the circle (at most the 30 of
+    // sf::CircleShape), starting at the top like sf::CircleShape
+    void circle(sf::Vector2f center, float radius, sf::Color color) {
+        float screen_radius = radius * pixel_scale;
+        int count = std::clamp(static_cast<int>(std::ceil(3.14159265f * std::sqrt(screen_radius / (2.0f * BATCH_CIRCLE_TOLERANCE)))),
+                               MIN_CIRCLE_POINTS, MAX_CIRCLE_POINTS);
+        const sf::Vector2f* unit = unit_circle(count);
+        for (int i = 0; i < count; ++i) {
+            triangle(center, center + unit[i] * radius, center + unit[i + 1] * radius, color);
+        }
+    }
+
+    // Rectangle from one point to another, thickness to the right of the
+    // direction of travel like SFMLRenderer::drawLine
+    void line(sf::Vector2f from, sf::Vector2f to, float thickness, sf::Color color) {
+        sf::Vector2f direction = to - from;
+        float length = std::sqrt(direction.x * direction.x + direction.y * direction.y);
+        if (length == 0) return;
+        sf::Vector2f side = sf::Vector2f(-direction.y, direction.x) * (thickness / length);
+        triangle(from, to, to + side, color);
+        triangle(from, to + side, from + side, color);
+    }
+
+    // The whole of a size x size texture centered on a point and tinted,
+    // like a sprite with its origin in the middle
+    void sprite(sf::Vector2f center, float size, float scale, sf::Color color) {
+        float half = size * scale / 2.0f;
+        sf::Vertex tl{center + sf::Vector2f(-half, -half), color, sf::Vector2f(0.0f, 0.0f)};
+        sf::Vertex tr{center + sf::Vector2f(half, -half), color, sf::Vector2f(size, 0.0f)};
+        sf::Vertex br{center + sf::Vector2f(half, half), color, sf::Vector2f(size, size)};
+        sf::Vertex bl{center + sf::Vector2f(-half, half), color, sf::Vector2f(0.0f, size)};
+        vertices.push_back(tl);
+        vertices.push_back(tr);
+        vertices.push_back(br);
+        vertices.push_back(tl);
+        vertices.push_back(br);
+        vertices.push_back(bl);
+    }
+
+    void draw(sf::RenderTarget& target, const sf::RenderStates& states = sf::RenderStates::Default) const {
+        if (!vertices.empty()) target.draw(vertices.data(), vertices.size(), sf::PrimitiveType::Triangles, states);
+    }
+
+private:
+    static constexpr int MIN_CIRCLE_POINTS = 6;
+    static constexpr int MAX_CIRCLE_POINTS = 30;
+
+    // Points of a unit circle with count corners, the first repeated at the end
+    static const sf::Vector2f* unit_circle(int count) {
+        static const std::vector<std::vector<sf::Vector2f>> tables = [] {
+            std::vector<std::vector<sf::Vector2f>> all(MAX_CIRCLE_POINTS + 1);
+            for (int n = MIN_CIRCLE_POINTS; n <= MAX_CIRCLE_POINTS; ++n) {
+                for (int i = 0; i <= n; ++i) {
+                    float angle = i * 2.0f * 3.14159265f / n - 3.14159265f / 2.0f;
+                    all[n].push_back(sf::Vector2f(std::cos(angle), std::sin(angle)));
+                }
+            }
+            return all;
+        }();
+        return tables[count].data();
+    }
+};
@@ -0,0 +1,459 @@
+#include "world_digest.hpp"
+#include "simulation.hpp"
+#include "ga.hpp"
+#include <cstring>
+#include <iomanip>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// WORLD DIGEST IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const char* const SECTION_NAMES[DIGEST_SECTION_COUNT] = {
+    "clock", "rng", "terrain", "nutrients", "plants", "fires", "hares", "foxes", "wolves", "salmon"
+};
+
+// Word-at-a-time multiplicative mix; not cryptographic, just fast and
+// sensitive to every bit and to order
+class Hasher {
+public:
+    void add(uint64_t v) {
+        h_ ^= v;
+        h_ *= 0x9E3779B97F4A7C15ull;
+        h_ ^= h_ >> 29;
+    }
+
+    void add_bytes(const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8) {
+            uint64_t word;
+            std::memcpy(&word, bytes + i, sizeof(word));
+            add(word);
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, bytes + i, size - i);
+        add(tail ^ size);
+    }
+
+    uint64_t value() const { return h_; }
+
+private:
+    uint64_t h_ = 0x243F6A8885A308D3ull;
+};
+
+// The generator's state is only reachable through operator<<, so its
+// text form is hashed as it is written, without building the string
+class HashBuf : public std::streambuf {
+public:
+    explicit HashBuf(Hasher& hasher) : hasher_(hasher) {}
+
+protected:
+    int_type overflow(int_type c) override {
+        if (c != traits_type::eof()) hasher_.add(static_cast<uint64_t>(c));
+        return c;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        hasher_.add_bytes(s, static_cast<size_t>(n));
+        return n;
+    }
+
+private:
+    Hasher& hasher_;
+};
+
+// One field of an entity: exact bits for comparing and hashing, the value for printing
+struct Field {
+    const char* name;
+    uint64_t bits;
+    double value;
+};
+
+template <typename T>
+Field make_field(const char* name, T value) {
+    Field field{name, 0, static_cast<double>(value)};
+    if constexpr (std::is_same_v<T, float>) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        field.bits = bits;
+    } else {
+        field.bits = static_cast<uint64_t>(value);
+    }
+    return field;
+}
+
+const char* const GENE_NAMES[] = {"gene0", "gene1", "gene2", "gene3", "gene4", "gene5", "gene6", "gene7"};
+const char* const FLAG_NAMES[] = {"flag0", "flag1", "flag2", "flag3"};
+
+// Genes as their 16-bit codes and flags, in layout order (see hexaworld_api.h for names)
+template <typename Genome, typename F>
+void visit_genome(const Genome& genome, F& f) {
+    using Layout = GenomeLayout<Genome>;
+    static_assert(std::tuple_size_v<decltype(Layout::genes)> <= std::size(GENE_NAMES), "name every gene");
+    static_assert(std::tuple_size_v<decltype(Layout::flags)> <= std::size(FLAG_NAMES), "name every flag");
+    size_t i = 0;
+    std::apply([&](const auto&... g) { (f(GENE_NAMES[i++], (genome.*g.field).code), ...); }, Layout::genes);
+    i = 0;
+    std::apply([&](const auto&... fl) { (f(FLAG_NAMES[i++], genome.*fl.field), ...); }, Layout::flags);
+}
+
+// Every field of each species, besides the id the diff matches on
+template <typename F>
+void visit_fields(const Hare& a, F& f) {
+    f("q", a.q); f("r", a.r); f("parent", a.parent_id);
+    f("energy", a.energy); f("thirst", a.thirst); f("digestion_time", a.digestion_time);
+    f("move_timer", a.move_timer); f("pregnancy_timer", a.pregnancy_timer); f("eating_timer", a.eating_timer);
+    visit_genome(a.genome, f);
+    f("death_cause", static_cast<uint8_t>(a.death_cause));
+    f("is_dead", bool(a.is_dead)); f("is_pregnant", bool(a.is_pregnant)); f("ready_to_give_birth", bool(a.ready_to_give_birth));
+    f("is_burrowing", bool(a.is_burrowing)); f("is_eating", bool(a.is_eating));
+}
+
+template <typename Predator, typename F>
+void visit_predator(const Predator& a, F& f) {
+    f("q", a.q); f("r", a.r); f("parent", a.parent_id);
+    f("energy", a.energy); f("thirst", a.thirst); f("digestion_time", a.digestion_time);
+    f("move_timer", a.move_timer); f("pregnancy_timer", a.pregnancy_timer); f("last_prey_id", a.last_prey_id);
+    visit_genome(a.genome, f);
+    f("death_cause", static_cast<uint8_t>(a.death_cause));
+    f("is_dead", bool(a.is_dead)); f("is_pregnant", bool(a.is_pregnant)); f("ready_to_give_birth", bool(a.ready_to_give_birth));
+}
+
+template <typename F> void visit_fields(const Fox& a, F& f) { visit_predator(a, f); }
+template <typename F> void visit_fields(const Wolf& a, F& f) { visit_predator(a, f); }
+
+template <typename F>
+void visit_fields(const Salmon& a, F& f) {
+    f("q", a.q); f("r", a.r); f("parent", a.parent_id);
+    f("energy", a.energy); f("energy_tick", a.energy_tick); f("wake_tick", a.wake_tick);
+    f("death_cause", static_cast<uint8_t>(a.death_cause));
+    f("is_dead", bool(a.is_dead)); f("ready_to_give_birth", bool(a.ready_to_give_birth));
+}
+
+template <typename F>
+void visit_fields(const Plant& p, F& f) {
+    f("stage", static_cast<uint8_t>(p.stage)); f("growth_time", p.growth_time);
+    f("drop_time", p.drop_time); f("nutrients", p.nutrients);
+}
+
+template <typename Entity>
+void collect(const Entity& entity, std::vector<Field>& fields) {
+    fields.clear();
+    auto f = [&](const char* name, auto value) { fields.push_back(make_field(name, value)); };
+    visit_fields(entity, f);
+}
+
+template <typename Entity>
+void hash_fields(const Entity& entity, Hasher& hasher) {
+    auto f = [&](const char*, auto value) { hasher.add(make_field("", value).bits); };
+    visit_fields(entity, f);
+}
+
+template <typename Animal>
+uint64_t hash_animals(const std::vector<Animal>& animals) {
+    Hasher hasher;
+    hasher.add(animals.size());
+    for (const Animal& animal : animals) {
+        hasher.add(animal.id);
+        hash_fields(animal, hasher);
+    }
+    return hasher.value();
+}
+
+uint64_t coord_word(const std::pair<int, int>& coord) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(coord.first)) << 32) | static_cast<uint32_t>(coord.second);
+}
+
+uint64_t hash_rng(const std::mt19937& rng) {
+    Hasher hasher;
+    HashBuf buf(hasher);
+    std::ostream out(&buf);
+    out << rng;
+    return hasher.value();
+}
+
+// ----------------------------------------------------------------------------
+// Diff
+// ----------------------------------------------------------------------------
+
+class Diff {
+public:
+    Diff(std::ostream& out, size_t max_lines) : out_(out), max_lines_(max_lines) {}
+
+    template <typename... Args>
+    void line(const Args&... args) {
+        if (count_ < max_lines_) {
+            (out_ << ... << args) << '\n';
+        } else if (count_ == max_lines_) {
+            out_ << "  ...\n";
+        }
+        count_++;
+    }
+
+    // Section titles are printed but not counted as differences
+    void heading(const char* title) {
+        if (count_ < max_lines_) out_ << title << ":\n";
+    }
+
+    size_t count() const { return count_; }
+
+private:
+    std::ostream& out_;
+    size_t max_lines_;
+    size_t count_ = 0;
+};
+
+std::string coord_name(const std::pair<int, int>& coord) {
+    return "(" + std::to_string(coord.first) + ", " + std::to_string(coord.second) + ")";
+}
+
+void diff_fields(Diff& diff, const std::string& what, const std::vector<Field>& a, const std::vector<Field>& b) {
+    for (size_t i = 0; i < a.size() && i < b.size(); ++i) {
+        if (a[i].bits != b[i].bits) diff.line("  ", what, " ", a[i].name, ": ", a[i].value, " vs ", b[i].value);
+    }
+}
+
+// Walk two maps with the same key order side by side
+template <typename Map, typename OnlyA, typename OnlyB, typename Both>
+void walk(const Map& a, const Map& b, OnlyA only_a, OnlyB only_b, Both both) {
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() || ib != b.end()) {
+        if (ib == b.end() || (ia != a.end() && ia->first < ib->first)) {
+            only_a(*ia++);
+        } else if (ia == a.end() || ib->first < ia->first) {
+            only_b(*ib++);
+        } else {
+            both(*ia++, *ib++);
+        }
+    }
+}
+
+template <typename Animal>
+void diff_animals(Diff& diff, const char* species, const std::vector<Animal>& a, const std::vector<Animal>& b) {
+    size_t before = diff.count();
+    std::unordered_map<uint32_t, const Animal*> in_b;
+    for (const Animal& animal : b) in_b[animal.id] = &animal;
+    std::vector<Field> fields_a, fields_b;
+    for (const Animal& animal : a) {
+        auto it = in_b.find(animal.id);
+        if (it == in_b.end()) {
+            diff.line("  ", species, " ", animal.id, " only in A, at ", coord_name({animal.q, animal.r}));
+            continue;
+        }
+        collect(animal, fields_a);
+        collect(*it->second, fields_b);
+        diff_fields(diff, std::string(species) + " " + std::to_string(animal.id), fields_a, fields_b);
+        in_b.erase(it);
+    }
+    for (const Animal& animal : b) {
+        if (in_b.count(animal.id)) diff.line("  ", species, " ", animal.id, " only in B, at ", coord_name({animal.q, animal.r}));
+    }
+    if (diff.count() == before) diff.line("  same ", species, " records in a different order");
+}
+
+} // namespace
+
+const char* digest_section_name(DigestSection section) {
+    return section < DIGEST_SECTION_COUNT ? SECTION_NAMES[section] : "unknown";
+}
+
+bool WorldDigest::operator==(const WorldDigest& other) const {
+    if (total != other.total) return false;
+    for (int i = 0; i < DIGEST_SECTION_COUNT; ++i) {
+        if (sections[i] != other.sections[i]) return false;
+    }
+    return true;
+}
+
+uint64_t digest_terrain(const HexGrid& grid) {
+    Hasher hasher;
+    hasher.add(grid.hexagons.size());
+    for (const auto& [coord, pixel] : grid.hexagons) hasher.add(coord_word(coord));
+    hasher.add(grid.terrainTiles.size());
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        hasher.add(coord_word(coord));
+        hasher.add(tile.type);
+    }
+    return hasher.value();
+}
+
+WorldDigest digest_world(const Simulation& sim, const std::mt19937& rng) {
+    return digest_world(sim, rng, digest_terrain(sim.grid));
+}
+
+WorldDigest digest_world(const Simulation& sim, const std::mt19937& rng, uint64_t terrain) {
+    WorldDigest digest;
+
+    Hasher clock;
+    clock.add(sim.tick_count);
+    clock.add(make_field("", sim.sim_time).bits);
+    clock.add(sim.next_id);
+    for (float timer : sim.carried_timers()) clock.add(make_field("", timer).bits);
+    digest.sections[DIGEST_CLOCK] = clock.value();
+
+    digest.sections[DIGEST_RNG] = hash_rng(rng);
+
+    digest.sections[DIGEST_TERRAIN] = terrain;
+
+    Hasher nutrients;
+    nutrients.add_bytes(sim.grid.nutrients.data(), sim.grid.nutrients.size() * sizeof(float));
+    digest.sections[DIGEST_NUTRIENTS] = nutrients.value();
+
+    Hasher plants;
+    plants.add(sim.grid.plants.size());
+    for (const auto& [coord, plant] : sim.grid.plants) {
+        plants.add(coord_word(coord));
+        hash_fields(plant, plants);
+    }
+    digest.sections[DIGEST_PLANTS] = plants.value();
+
+    Hasher fires;
+    fires.add(sim.grid.fire_timers.size());
+    for (const auto& [coord, left] : sim.grid.fire_timers) {
+        fires.add(coord_word(coord));
+        fires.add(make_field("", left).bits);
+    }
+    digest.sections[DIGEST_FIRES] = fires.value();
+
+    digest.sections[DIGEST_HARES] = hash_animals(sim.hares);
+    digest.sections[DIGEST_FOXES] = hash_animals(sim.foxes);
+    digest.sections[DIGEST_WOLVES] = hash_animals(sim.wolves);
+    digest.sections[DIGEST_SALMON] = hash_animals(sim.salmons);
+
+    Hasher total;
+    for (uint64_t section : digest.sections) total.add(section);
+    digest.total = total.value();
+    return digest;
+}
+
+size_t diff_worlds(const Simulation& a, const std::mt19937& rng_a,
+                   const Simulation& b, const std::mt19937& rng_b,
+                   std::ostream& out, size_t max_lines) {
+    WorldDigest digest_a = digest_world(a, rng_a);
+    WorldDigest digest_b = digest_world(b, rng_b);
+    Diff diff(out, max_lines);
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precision = out.precision(9);
+    std::vector<Field> fields_a, fields_b;
+
+    for (int s = 0; s < DIGEST_SECTION_COUNT; ++s) {
+        if (digest_a.sections[s] == digest_b.sections[s]) continue;
+        diff.heading(SECTION_NAMES[s]);
+        size_t before = diff.count();
+        switch (static_cast<DigestSection>(s)) {
+            case DIGEST_CLOCK:
+                if (a.tick_count != b.tick_count) diff.line("  tick: ", a.tick_count, " vs ", b.tick_count);
+                if (a.sim_time != b.sim_time) diff.line("  sim_time: ", a.sim_time, " vs ", b.sim_time);
+                if (a.next_id != b.next_id) diff.line("  next_id: ", a.next_id, " vs ", b.next_id);
+                for (size_t i = 0; i < a.carried_timers().size(); ++i) {
+                    float ta = a.carried_timers()[i], tb = b.carried_timers()[i];
+                    if (make_field("", ta).bits != make_field("", tb).bits) {
+                        diff.line("  ", Simulation::CARRIED_TIMER_NAMES[i], ": ", ta, " vs ", tb);
+                    }
+                }
+                break;
+            case DIGEST_RNG: {
+                std::mt19937 next_a = rng_a, next_b = rng_b;
+                diff.line("  generator states differ, next draws ", next_a(), " vs ", next_b());
+                break;
+            }
+            case DIGEST_TERRAIN:
+                walk(a.grid.hexagons, b.grid.hexagons,
+                     [&](const auto& e) { diff.line("  hexagon ", coord_name(e.first), " only in A"); },
+                     [&](const auto& e) { diff.line("  hexagon ", coord_name(e.first), " only in B"); },
+                     [](const auto&, const auto&) {});
+                walk(a.grid.terrainTiles, b.grid.terrainTiles,
+                     [&](const auto& e) { diff.line("  terrain ", coord_name(e.first), " only in A"); },
+                     [&](const auto& e) { diff.line("  terrain ", coord_name(e.first), " only in B"); },
+                     [&](const auto& ea, const auto& eb) {
+                         if (ea.second.type != eb.second.type) {
+                             diff.line("  terrain ", coord_name(ea.first), ": ", ea.second.type, " vs ", eb.second.type);
+                         }
+                     });
+                break;
+            case DIGEST_NUTRIENTS:
+                walk(a.grid.hexagons, b.grid.hexagons, [](const auto&) {}, [](const auto&) {},
+                     [&](const auto& ea, const auto&) {
+                         float na = a.grid.nutrients.get(ea.first.first, ea.first.second);
+                         float nb = b.grid.nutrients.get(ea.first.first, ea.first.second);
+                         if (make_field("", na).bits != make_field("", nb).bits) {
+                             diff.line("  tile ", coord_name(ea.first), " nutrients: ", na, " vs ", nb);
+                         }
+                     });
+                break;
+            case DIGEST_PLANTS:
+                walk(a.grid.plants, b.grid.plants,
+                     [&](const auto& e) { diff.line("  plant ", coord_name(e.first), " only in A"); },
+                     [&](const auto& e) { diff.line("  plant ", coord_name(e.first), " only in B"); },
+                     [&](const auto& ea, const auto& eb) {
+                         collect(ea.second, fields_a);
+                         collect(eb.second, fields_b);
+                         diff_fields(diff, "plant " + coord_name(ea.first), fields_a, fields_b);
+                     });
+                break;
+            case DIGEST_FIRES:
+                walk(a.grid.fire_timers, b.grid.fire_timers,
+                     [&](const auto& e) { diff.line("  fire ", coord_name(e.first), " only in A"); },
+                     [&](const auto& e) { diff.line("  fire ", coord_name(e.first), " only in B"); },
+                     [&](const auto& ea, const auto& eb) {
+                         if (make_field("", ea.second).bits != make_field("", eb.second).bits) {
+                             diff.line("  fire ", coord_name(ea.first), ": ", ea.second, " vs ", eb.second, " s left");
+                         }
+                     });
+                break;
+            case DIGEST_HARES: diff_animals(diff, "hare", a.hares, b.hares); break;
+            case DIGEST_FOXES: diff_animals(diff, "fox", a.foxes, b.foxes); break;
+            case DIGEST_WOLVES: diff_animals(diff, "wolf", a.wolves, b.wolves); break;
+            case DIGEST_SALMON: diff_animals(diff, "salmon", a.salmons, b.salmons); break;
+            case DIGEST_SECTION_COUNT: break;
+        }
+        if (diff.count() == before) diff.line("  (same entities and values, in a different order or layout)");
+    }
+
+    out.flags(flags);
+    out.precision(precision);
+    return diff.count();
+}
+
+// ============================================================================
+// DIGEST TRACE
+// ============================================================================
+
+DigestTrace::DigestTrace(const std::string& path) : file_(path) {
+    if (!file_) {
+        throw std::runtime_error("Failed to open digest file: " + path);
+    }
+    file_ << "# tick total";
+    for (const char* name : SECTION_NAMES) file_ << " " << name;
+    file_ << "\n";
+}
+
+void DigestTrace::record(const Simulation& sim) {
+    if (!has_terrain_) {
+        terrain_ = digest_terrain(sim.grid);
+        has_terrain_ = true;
+    }
+    WorldDigest digest = digest_world(sim, gen, terrain_);
+    file_ << sim.tick_count << std::hex << std::setfill('0') << " " << std::setw(16) << digest.total;
+    for (uint64_t section : digest.sections) file_ << " " << std::setw(16) << section;
+    file_ << std::dec << "\n";
+}
+
+bool parse_digest_line(const std::string& line, uint64_t& tick, WorldDigest& digest) {
+    if (line.empty() || line[0] == '#') return false;
+    std::istringstream in(line);
+    in >> tick >> std::hex >> digest.total;
+    for (uint64_t& section : digest.sections) in >> section;
+    return static_cast<bool>(in);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <random>
+#include <string>
+
+class Simulation;
+class HexGrid;
+
+// ============================================================================
+// WORLD DIGEST - Hash of the full simulation state, for reproducibility checks
+// ============================================================================
+
+// Two runs from one seed must reach the same digest after every tick, so
+// the first tick where they do not is where results changed. Each section
+// is hashed on its own, so a mismatch already says where to look;
+// diff_worlds() then names the entities and fields that differ.
+
+enum DigestSection {
+    DIGEST_CLOCK,     // Tick, simulated time, next id, carried timers
+    DIGEST_RNG,       // Full state of the generator
+    DIGEST_TERRAIN,   // Hexagons and terrain types
+    DIGEST_NUTRIENTS,
+    DIGEST_PLANTS,
+    DIGEST_FIRES,
+    DIGEST_HARES,     // Animals in container (update) order
+    DIGEST_FOXES,
+    DIGEST_WOLVES,
+    DIGEST_SALMON,
+    DIGEST_SECTION_COUNT
+};
+
+const char* digest_section_name(DigestSection section);
+
+struct WorldDigest {
+    uint64_t total = 0;  // Over the sections
+    uint64_t sections[DIGEST_SECTION_COUNT] = {};
+
+    bool operator==(const WorldDigest& other) const;
+    bool operator!=(const WorldDigest& other) const { return !(*this == other); }
+};
+
+// Hash every field of every tile, plant, fire and animal, and rng, which
+// is the generator the simulation draws from (gen, unless a tool swaps
+// generators between simulations)
+WorldDigest digest_world(const Simulation& sim, const std::mt19937& rng);
+
+// Hexagons and terrain only change while a world is built, and walking
+// them costs more than the rest of the world together, so callers hashing
+// every tick take digest_terrain() once per world and pass it in
+uint64_t digest_terrain(const HexGrid& grid);
+WorldDigest digest_world(const Simulation& sim, const std::mt19937& rng, uint64_t terrain);
+
+// Print what differs between two worlds, section by section: entities only
+// one of them has, and every differing field with both values. Stops
+// printing after max_lines; returns the number of differences found.
+size_t diff_worlds(const Simulation& a, const std::mt19937& rng_a,
+                   const Simulation& b, const std::mt19937& rng_b,
+                   std::ostream& out, size_t max_lines = 40);
+
+// Text trace of a run, one line per tick: the tick count, then the total
+// and each section in hex. Written by the viewer (HEXAWORLD_DIGEST_FILE)
+// and by hexaworld_bisect, and compared by hexaworld_bisect --trace, which
+// is how two builds are checked against each other.
+class DigestTrace {
+public:
+    // Throws std::runtime_error if the file cannot be created
+    explicit DigestTrace(const std::string& path);
+
+    // Called by Simulation::tick once the tick is complete; reads gen.
+    // Terrain is hashed on the first call only.
+    void record(const Simulation& sim);
+
+private:
+    std::ofstream file_;
+    uint64_t terrain_ = 0;
+    bool has_terrain_ = false;
+};
+
+// One trace line; false for comments and malformed lines
+bool parse_digest_line(const std::string& line, uint64_t& tick, WorldDigest& digest);
@@ -0,0 +1,124 @@
+#include "world_map.hpp"
+#include "constants.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+// WORLD MAP IMPLEMENTATION
+// ============================================================================
+
+namespace {
+
+const char MAP_MAGIC[8] = {'H', 'W', 'M', 'A', 'P', '\0', '\0', '\0'};
+const int MAP_MAX_RADIUS = 1 << 14;  // Rejects nonsense before sizing anything from it
+
+uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~uint64_t(7);
+}
+
+} // namespace
+
+WorldMap::WorldMap(const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) throw std::runtime_error("Failed to open map file: " + path);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(WorldMapHeader)) {
+        close(fd);
+        throw std::runtime_error("Not a HexaWorld map: " + path);
+    }
+    size_ = static_cast<size_t>(st.st_size);
+    void* memory = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) throw std::runtime_error("Failed to map map file: " + path);
+    data_ = static_cast<const uint8_t*>(memory);
+
+    // Everything the accessors trust is checked here
+    const WorldMapHeader& h = header();
+    std::string problem;
+    uint64_t cells = static_cast<uint64_t>(2 * int64_t(h.radius) + 3) * (2 * int64_t(h.radius) + 3);
+    auto fits = [&](uint64_t offset, uint64_t bytes) {
+        return offset % 8 == 0 && offset >= sizeof(WorldMapHeader) && offset <= size_ && bytes <= size_ - offset;
+    };
+    if (std::memcmp(h.magic, MAP_MAGIC, sizeof(MAP_MAGIC)) != 0) {
+        problem = "not a HexaWorld map";
+    } else if (h.version != WORLD_MAP_VERSION) {
+        problem = "map version " + std::to_string(h.version) + ", expected " + std::to_string(WORLD_MAP_VERSION);
+    } else if (h.hex_size != HEX_SIZE) {
+        problem = "baked for " + std::to_string(h.hex_size) + "-pixel hexes, this build uses " + std::to_string(HEX_SIZE);
+    } else if (h.radius < 0 || h.radius > MAP_MAX_RADIUS || h.cells != cells) {
+        problem = "bad grid radius";
+    } else if (!fits(h.terrain_offset, cells) || !fits(h.nutrients_offset, cells * sizeof(float)) ||
+               !fits(h.plants_offset, cells) || !fits(h.spawns_offset, uint64_t(h.spawn_count) * sizeof(MapSpawn))) {
+        problem = "truncated";
+    }
+    if (!problem.empty()) {
+        munmap(const_cast<uint8_t*>(data_), size_);
+        throw std::runtime_error("Cannot load map " + path + ": " + problem);
+    }
+}
+
+WorldMap::~WorldMap() {
+    munmap(const_cast<uint8_t*>(data_), size_);
+}
+
+void save_world_map(const HexGrid& grid, float world_width, float world_height,
+                    const std::vector<MapSpawn>& spawns, const std::string& path) {
+    HexField layout;
+    layout.resize(grid.max_grid_distance);
+    size_t cells = layout.size();
+
+    std::vector<uint8_t> terrain(cells, MAP_NO_HEXAGON);
+    std::vector<float> nutrients(cells, 0.0f);
+    std::vector<uint8_t> plants(cells, MAP_NO_PLANT);
+    for (const auto& [coord, pixel] : grid.hexagons) {
+        if (layout.contains(coord.first, coord.second)) {
+            terrain[layout.index(coord.first, coord.second)] = MAP_NO_TERRAIN;
+            nutrients[layout.index(coord.first, coord.second)] = grid.nutrients.get(coord.first, coord.second);
+        }
+    }
+    for (const auto& [coord, tile] : grid.terrainTiles) {
+        if (layout.contains(coord.first, coord.second)) {
+            terrain[layout.index(coord.first, coord.second)] = static_cast<uint8_t>(tile.type);
+        }
+    }
+    for (const auto& [coord, plant] : grid.plants) {
+        if (layout.contains(coord.first, coord.second)) {
+            plants[layout.index(coord.first, coord.second)] = static_cast<uint8_t>(plant.stage);
+        }
+    }
+
+    WorldMapHeader header{};
+    std::memcpy(header.magic, MAP_MAGIC, sizeof(MAP_MAGIC));
+    header.version = WORLD_MAP_VERSION;
+    header.radius = grid.max_grid_distance;
+    header.cells = cells;
+    header.hex_size = grid.hex_size;
+    header.world_width = world_width;
+    header.world_height = world_height;
+    header.spawn_count = static_cast<uint32_t>(spawns.size());
+    header.terrain_offset = align8(sizeof(header));
+    header.nutrients_offset = align8(header.terrain_offset + cells);
+    header.plants_offset = align8(header.nutrients_offset + cells * sizeof(float));
+    header.spawns_offset = align8(header.plants_offset + cells);
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) throw std::runtime_error("Failed to open map file: " + path);
+    uint64_t pos = 0;
+    auto write = [&](uint64_t offset, const void* data, size_t bytes) {
+        static const char padding[8] = {};
+        out.write(padding, static_cast<std::streamsize>(offset - pos));
+        out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+        pos = offset + bytes;
+    };
+    write(0, &header, sizeof(header));
+    write(header.terrain_offset, terrain.data(), cells);
+    write(header.nutrients_offset, nutrients.data(), cells * sizeof(float));
+    write(header.plants_offset, plants.data(), cells);
+    write(header.spawns_offset, spawns.data(), spawns.size() * sizeof(MapSpawn));
+    if (!out) throw std::runtime_error("Failed to write map file: " + path);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "hex_grid_new.hpp"
+#include "event_log.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ============================================================================
+// WORLD MAP - Precomputed worlds, loaded at startup instead of generated
+// ============================================================================
+
+// A map file holds a world as dense per-tile arrays in the HexField layout
+// (tile (q, r) at (q + radius + 1) * stride + (r + radius + 1), stride =
+// 2 * radius + 3), so loading is one pass over the arrays with no terrain
+// generation, growth or trimming. The pass copies every tile into the
+// grid's ordered maps, so it is linear in the map size.
+//
+// Layout, native byte order (little-endian on every supported platform),
+// each array starting 8-byte aligned:
+//
+//   WorldMapHeader
+//   u8       terrain[cells]    TerrainType, MAP_NO_TERRAIN or MAP_NO_HEXAGON
+//   f32      nutrients[cells]
+//   u8       plants[cells]     PlantStage or MAP_NO_PLANT
+//   MapSpawn spawns[spawn_count]
+//
+// Maps are baked by hexaworld_bake from a seed or an image.
+
+const uint32_t WORLD_MAP_VERSION = 1;  // Bumped whenever the layout changes
+const uint8_t MAP_NO_TERRAIN = 254;    // Hexagon without a terrain tile
+const uint8_t MAP_NO_HEXAGON = 255;    // Outside the world
+const uint8_t MAP_NO_PLANT = 255;
+
+struct WorldMapHeader {
+    char magic[8];          // "HWMAP\0\0\0"
+    uint32_t version;
+    int32_t radius;         // Grid distance of the outermost tiles
+    uint64_t cells;         // (2 * radius + 3)^2
+    float hex_size;         // Must match the build's HEX_SIZE
+    float world_width;      // Pixel area the world was shaped for
+    float world_height;
+    uint32_t spawn_count;   // 0 = place the initial animals at random on load
+    uint64_t terrain_offset;
+    uint64_t nutrients_offset;
+    uint64_t plants_offset;
+    uint64_t spawns_offset;
+};
+
+// Founder placed with the default genome when the map is loaded
+struct MapSpawn {
+    uint8_t species;  // EventSpecies
+    uint8_t reserved[3];
+    int32_t q, r;
+};
+
+// A map file mapped read-only for as long as this lives; the loader reads
+// it once, so the mapping only saves reading the file into a buffer first
+class WorldMap {
+public:
+    // Throws std::runtime_error if the file is missing, truncated, of
+    // another version or built for another hex size
+    explicit WorldMap(const std::string& path);
+    ~WorldMap();
+
+    WorldMap(const WorldMap&) = delete;
+    WorldMap& operator=(const WorldMap&) = delete;
+
+    const WorldMapHeader& header() const { return *reinterpret_cast<const WorldMapHeader*>(data_); }
+    const uint8_t* terrain() const { return data_ + header().terrain_offset; }
+    const float* nutrients() const { return reinterpret_cast<const float*>(data_ + header().nutrients_offset); }
+    const uint8_t* plants() const { return data_ + header().plants_offset; }
+    const MapSpawn* spawns() const { return reinterpret_cast<const MapSpawn*>(data_ + header().spawns_offset); }
+
+    size_t index(int q, int r) const {
+        int radius = header().radius;
+        return static_cast<size_t>(q + radius + 1) * (2 * radius + 3) + (r + radius + 1);
+    }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Write the grid's hexagons, terrain, nutrients and plants, plus the given
+// founders, as a map file; throws std::runtime_error if it cannot be written
+void save_world_map(const HexGrid& grid, float world_width, float world_height,
+                    const std::vector<MapSpawn>& spawns, const std::string& path);